@@ -5,7 +5,8 @@
  * BTagCalibrationReader
  *
  * Helper class to pull out a specific set of BTagEntry's out of a
- * BTagCalibration. TF1 functions are set up at initialization time.
+ * BTagCalibration. Formulas are compiled at initialization time, with
+ * BTagFormula or, for expressions it does not handle, TF1.
  *
  ************************************************************/
 
@@ -26,6 +27,11 @@ public:
                         const std::string & sysType="central",
                         const std::vector<std::string> & otherSysTypes={});
 
+  // Tabulate the pt-dependent functions of loaded and later loaded entries
+  // every step GeV and interpolate linearly, for each function whose
+  // interpolation is within tolerance of the formula; step 0 turns it off
+  void setPtGrid(float step, double tolerance);
+
   void load(const BTagCalibration & c,
             BTagEntry::JetFlavor jf,
             const std::string & measurementType="comb");
@@ -41,6 +47,29 @@ public:
                           float pt,
                           float discr=0.) const;
 
+  // Handle of a sysType for the overload below, resolved once instead of per
+  // call: 0 for the central sysType, i for the i-th of otherSysTypes
+  int sys_handle(const std::string & sys) const;
+
+  double eval_auto_bounds(int sys,
+                          BTagEntry::JetFlavor jf,
+                          float eta,
+                          float pt,
+                          float discr=0.) const;
+
+  // Number of sys handles: the central sysType and otherSysTypes
+  std::size_t num_sys_types() const;
+
+  // eval_auto_bounds of every sys handle from a single search, sfs[handle]
+  // for num_sys_types() handles; all sysTypes share each interval entry.
+  // Returns false if no entry in the central sysType's eta index covers the
+  // point; the SFs of the sysTypes in that index are then 0
+  bool eval_auto_bounds_all(BTagEntry::JetFlavor jf,
+                            float eta,
+                            float pt,
+                            float discr,
+                            double * sfs) const;
+
   std::pair<float, float> min_max_pt(BTagEntry::JetFlavor jf,
                                      float eta,
                                      float discr=0.) const;
@@ -0,0 +1,75 @@
+#ifndef BTagFormula_H
+#define BTagFormula_H
+
+/**
+ *
+ * BTagFormula
+ *
+ * Compiles the expression subset used by the b-tag calibration csv files
+ * into a small stack bytecode, so SFs are evaluated without TFormula:
+ * numbers, x, + - * /, unary minus, < > <= >= == !=, chained ?: (as written
+ * by th1ToFormulaLin/th1ToFormulaBinTree), log, exp, sqrt and pow.
+ *
+ * An expression outside the subset is left uncompiled; callers fall back to
+ * TF1 for it. generate_btag_formulas.exe writes the compiled expressions of
+ * chosen csv files out as C++ functions (see toCpp), which are used instead
+ * of the bytecode when given to the constructor.
+ *
+ ************************************************************/
+
+#include <string>
+#include <vector>
+
+class BTagFormula
+{
+public:
+  typedef double (*NativeFunction)(double);
+
+  BTagFormula();
+  explicit BTagFormula(const std::string &expression,
+                       NativeFunction native=nullptr);
+
+  bool isCompiled() const;
+  bool usesX() const;
+  double eval(double x) const;
+
+  // Compiled expression as a fully parenthesized C++ expression in x, or an
+  // empty string if it is not compiled or contains a non-finite constant
+  std::string toCpp() const;
+
+private:
+  enum OpCode {
+    kConst, kX,
+    kNeg, kLog, kExp, kSqrt,
+    kAdd, kSub, kMul, kDiv, kPow,
+    kLess, kGreater, kLessEq, kGreaterEq, kEqual, kNotEqual,
+    kSelect,                           // syntax tree only
+    kJump, kJumpUnless, kJumpUnlessXLess  // bytecode only
+  };
+  struct Node {
+    OpCode op;
+    double value;
+    int arg[3];
+  };
+  struct Instruction {
+    OpCode op;
+    double value;
+    int target;
+  };
+  friend class BTagFormulaParser;
+
+  static const int kMaxDepth = 64;
+
+  static double apply(OpCode op, double a, double b);
+  void fold(int node);
+  int emit(int node);
+  std::string toCpp(int node, bool &finite) const;
+
+  std::vector<Node> nodes_;
+  int root_;
+  std::vector<Instruction> code_;
+  NativeFunction native_;
+  bool usesX_;
+};
+
+#endif  // BTagFormula_H
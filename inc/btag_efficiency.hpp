@@ -0,0 +1,57 @@
+//----------------------------------------------------------------------------
+// btag_efficiency - MC b-tag efficiencies flattened out of TH3D histograms
+//
+// Each operating point is one TH3D binned in |eta|, pt and hadron flavour
+// (0, 4 or 5). Its contents, under- and overflow included, are copied into
+// one contiguous float array indexed by [flavour class][|eta| bin][pt bin],
+// so a lookup is two bin searches and a load instead of TH3::FindFixBin and
+// GetBinContent. Bins match TAxis::FindFixBin exactly (see HistAxis).
+//----------------------------------------------------------------------------
+
+#ifndef H_BTAG_EFFICIENCY
+#define H_BTAG_EFFICIENCY
+
+#include <cstddef>
+
+#include <functional>
+#include <vector>
+
+#include "calib_bundle.hpp"
+#include "hist_axis.hpp"
+
+class TH3D;
+
+class BTagEfficiencyTable{
+public:
+  enum FlavorClass{kUDSG, kC, kB, kNumFlavorClasses};
+
+  BTagEfficiencyTable() = default;
+  // One histogram per operating point; the histograms are not kept
+  explicit BTagEfficiencyTable(const std::vector<const TH3D*> &hists);
+  explicit BTagEfficiencyTable(const std::vector<CalibBundle::Hist> &hists);
+
+  static FlavorClass GetFlavorClass(int hadron_flavor);
+
+  std::size_t NumOps() const;
+
+  float Efficiency(std::size_t iop, FlavorClass flavor, double abs_eta, double pt) const;
+  // Efficiency for each of n jets
+  void Efficiencies(std::size_t iop, std::size_t n, const FlavorClass *flavor,
+                    const float *abs_eta, const float *pt, float *eff) const;
+
+private:
+  struct Table{
+    HistAxis eta, pt;
+    std::size_t offset;
+  };
+
+  // content(ieta, ipt, iflavor) for bins of the given axes
+  void AddTable(const HistAxis &eta, const HistAxis &pt, const HistAxis &flavor,
+                const std::function<double(int, int, int)> &content);
+  std::size_t Index(const Table &table, FlavorClass flavor, double abs_eta, double pt) const;
+
+  std::vector<Table> tables_; // Index: operating point
+  std::vector<float> content_;
+};
+
+#endif
@@ -0,0 +1,40 @@
+//----------------------------------------------------------------------------
+// btag_jet_weight - Per-jet b-tag weight formula over arrays of jets
+//
+// For each i,
+//   eff1_fs = eff1/sf1_fs, eff2_fs = eff2/sf2_fs
+//   result  = (sf1*sf1_fs*eff1_fs-sf2*sf2_fs*eff2_fs)/(eff1_fs-eff2_fs)
+// with NaN or infinite results replaced by 1. The AVX-512 or AVX2 version is
+// picked at run time from the CPU; every version evaluates the formula in the
+// same order without contraction, so the results are identical.
+//----------------------------------------------------------------------------
+
+#ifndef H_BTAG_JET_WEIGHT
+#define H_BTAG_JET_WEIGHT
+
+#include <cstddef>
+
+#include <string>
+
+// Returns the number of results replaced by 1
+std::size_t BTagJetWeights(std::size_t n,
+                           const double *eff1, const double *eff2,
+                           const double *sf1, const double *sf2,
+                           const double *sf1_fs, const double *sf2_fs,
+                           double *result);
+
+// Instruction set used by BTagJetWeights: "avx512f", "avx2" or "scalar"
+const char * BTagJetWeightsISA();
+
+// Whether this build and CPU can run the version for isa
+bool BTagJetWeightsSupported(const std::string &isa);
+
+// BTagJetWeights with the version for isa, which must be supported; only
+// meant to check the versions against each other
+std::size_t BTagJetWeightsWith(const std::string &isa, std::size_t n,
+                               const double *eff1, const double *eff2,
+                               const double *sf1, const double *sf2,
+                               const double *sf1_fs, const double *sf2_fs,
+                               double *result);
+
+#endif
@@ -1,21 +1,59 @@
 #ifndef H_BTAG_WEIGHTER
 #define H_BTAG_WEIGHTER
 
+#include <array>
+#include <memory>
+#include <mutex>
 #include <string>
-
-#include "TH3D.h"
+#include <vector>
 
 #include "baby_plus.hpp"
+#include "btag_efficiency.hpp"
 #include "BTagEntry.hpp"
 #include "BTagCalibration.hpp"
 #include "BTagCalibrationReader.hpp"
 
 class BTagWeighter{
 public:
+  // Sets of working points; OP sets with a single OP come in the order of op_pts_
+  enum OpSet{kOpLoose, kOpMedium, kOpTight, kOpAll, kNumOpSets};
+  // "Fast" variations vary the fastsim SFs, all others the fullsim ones
+  enum Variation{kCentral, kBCUp, kBCDown, kUDSGUp, kUDSGDown,
+                 kFastBCUp, kFastBCDown, kFastUDSGUp, kFastUDSGDown, kNumVariations};
+
+  struct EventWeightSet{
+    double operator()(OpSet op_set, Variation var) const{return weight[op_set][var];}
 
+    double weight[kNumOpSets][kNumVariations]; // NaN for OP sets not requested
+  };
+
+  // The calibrations and efficiencies of each tagger are read on first use,
+  // and the fastsim ones only if is_fast_sim
   explicit BTagWeighter(std::string proc,
                         bool is_fast_sim = false,
-			bool is_cmssw_7 = false);
+			bool is_cmssw_7 = false,
+			double sf_grid_tolerance = 0.); // >0: interpolate SFs tabulated every GeV where within this tolerance
+
+  // Loads now what weights with these options read on first use, e.g. before forking workers
+  void Preload(bool do_deep_csv, bool do_by_proc) const;
+
+  // Every variation of the requested OP sets in a single loop over the jets,
+  // sharing the efficiency and SF lookups, with the jet weight formula
+  // evaluated by the vector kernel of btag_jet_weight; same values as EventWeight.
+  // EventWeights and ShapeWeights reuse buffers of the weighter from one
+  // event to the next, so each thread needs its own weighter
+  EventWeightSet EventWeights(baby_plus &b, const std::vector<OpSet> &op_sets,
+                              bool do_deep_csv, bool do_by_proc) const;
+
+  // sysTypes of the iterative-fit (shape) SFs, in the order of ShapeWeights
+  static const std::vector<std::string> & ShapeSysTypes();
+
+  // Iterative-fit (shape) weight: product over the jets of the SF at each
+  // jet's discriminant, with no MC efficiencies. sys_weights[i] is the weight
+  // of ShapeSysTypes()[i]. A variation with no entries for a jet's flavor
+  // takes its central SF, and jets outside the calibration count as 1
+  void ShapeWeights(baby_plus &b, bool do_deep_csv,
+                    float &weight, std::vector<float> &sys_weights) const;
 
   double EventWeight(baby_plus &b, BTagEntry::OperatingPoint op,
 		     const std::string &bc_full_syst, const std::string &udsg_full_syst,
@@ -54,28 +92,93 @@ public:
 		       bool do_deep_csv, bool do_by_proc) const;
 
 private:
-  double GetMCTagEfficiency(int pdgId, float pT, float eta,
-			    BTagEntry::OperatingPoint op, bool do_deep_csv, bool do_by_proc) const;
+  // Handles of the sysTypes every reader is constructed with
+  enum Syst{kSystCentral, kSystUp, kSystDown, kNumSysts};
+
+  // Number of OPs in op_pts_, sizing every array indexed by OP
+  static const std::size_t kNumOps = 3;
+  static_assert(kOpAll == kNumOps, "The single-OP sets must come in the order of op_pts_, one per OP");
+
+  // OPs as indices into op_pts_, in the order given
+  struct OpList{
+    std::size_t size;
+    std::size_t iop[kNumOps];
+  };
+
+  static Syst GetSyst(const std::string &syst);
+  static OpList GetOpList(const std::vector<BTagEntry::OperatingPoint> &ops);
+
+  double JetWeight(baby_plus &b, std::size_t ijet, const OpList &ops,
+		   Syst bc_full_syst, Syst udsg_full_syst,
+		   Syst bc_fast_syst, Syst udsg_fast_syst,
+		   bool do_deep_csv, bool do_by_proc) const;
+
+  // Calibration and readers (index: position in op_pts_) of one csv file
+  struct Readers{
+    std::once_flag loaded;
+    std::unique_ptr<BTagCalibration> calib;
+    std::vector<std::unique_ptr<BTagCalibrationReader> > readers;
+  };
+  struct Efficiencies{
+    std::once_flag loaded;
+    BTagEfficiencyTable table;
+  };
+  // OP_RESHAPING reader of one csv file, with sys handle i+1 for ShapeSysTypes()[i]
+  struct Shape{
+    std::once_flag loaded;
+    std::unique_ptr<BTagCalibration> calib;
+    std::unique_ptr<BTagCalibrationReader> reader;
+    std::vector<bool> has_sys[3]; // Index: JetFlavor, then sys handle
+  };
 
-  static const std::vector<BTagEntry::OperatingPoint> op_pts_;
+  double GetMCTagEfficiency(int pdgId, float pT, float eta,
+			    std::size_t iop, bool do_deep_csv, bool do_by_proc) const;
+
+  // Each csv file and efficiency file is read on first use
+  typedef std::vector<std::unique_ptr<BTagCalibrationReader> > ReaderList;
+  const ReaderList & FullReaders(bool do_deep_csv) const;
+  const ReaderList & FastReaders(bool do_deep_csv) const;
+  const BTagEfficiencyTable & EfficiencyTable(bool do_deep_csv, bool do_by_proc) const;
+  const ReaderList & LoadReaders(Readers &readers, const std::string &tagger, const std::string &csv_file,
+				 const std::string &udsg_meas, const std::string &bc_meas) const;
+  const Shape & ShapeCalibration(bool do_deep_csv) const;
+  const Shape & LoadShape(Shape &shape, const std::string &tagger, const std::string &csv_file) const;
+  const BTagEfficiencyTable & LoadEfficiencies(Efficiencies &efficiencies, const std::string &root_file,
+					       bool do_deep_csv) const;
+
+  // Per-event arrays of EventWeights and ShapeWeights, kept at their largest size
+  struct Scratch{
+    std::vector<std::size_t> sets, jets;
+    std::vector<BTagEfficiencyTable::FlavorClass> flavors;
+    std::vector<float> abs_etas, pts, effs;
+    std::vector<double> terms, results;
+    std::vector<double> shape_weights, shape_sfs;
+  };
+
+  static const std::array<BTagEntry::OperatingPoint, kNumOps> op_pts_;
   static const std::vector<BTagEntry::JetFlavor> flavors_;
 
-  std::unique_ptr<BTagCalibration> calib_full_;
-  std::unique_ptr<BTagCalibration> calib_fast_;
-  std::map<BTagEntry::OperatingPoint, std::unique_ptr<BTagCalibrationReader> > readers_full_;
-  std::map<BTagEntry::OperatingPoint, std::unique_ptr<BTagCalibrationReader> > readers_fast_;
-  std::vector<TH3D> btag_efficiencies_;
-  std::vector<TH3D> btag_efficiencies_proc_;
+  std::string proc_;
+  double sf_grid_tolerance_;
+
+  mutable Readers readers_full_;
+  mutable Readers readers_fast_;
+  mutable Efficiencies btag_efficiencies_;
+  mutable Efficiencies btag_efficiencies_proc_;
+
+  mutable Shape shape_;
+  mutable Shape shape_deep_;
+
+  mutable Scratch scratch_;
 
-  std::unique_ptr<BTagCalibration> calib_deep_full_;
-  std::unique_ptr<BTagCalibration> calib_deep_fast_;
-  std::map<BTagEntry::OperatingPoint, std::unique_ptr<BTagCalibrationReader> > readers_deep_full_;
-  std::map<BTagEntry::OperatingPoint, std::unique_ptr<BTagCalibrationReader> > readers_deep_fast_;
-  std::vector<TH3D> btag_efficiencies_deep_;
-  std::vector<TH3D> btag_efficiencies_deep_proc_;
+  mutable Readers readers_deep_full_;
+  mutable Readers readers_deep_fast_;
+  mutable Efficiencies btag_efficiencies_deep_;
+  mutable Efficiencies btag_efficiencies_deep_proc_;
 
   double csv_loose_, csv_medium_, csv_tight_;
   double deep_csv_loose_, deep_csv_medium_, deep_csv_tight_;
+  float csv_cuts_[kNumOps], deep_csv_cuts_[kNumOps]; // Index: position in op_pts_
 
   bool is_fast_sim_;
 };
@@ -0,0 +1,109 @@
+//----------------------------------------------------------------------------
+// calib_bundle - Calibration inputs of data/ preprocessed into one binary file
+//
+// build_calib_bundle.exe parses every b-tag calibration csv file and reads
+// every histogram and graph of the ROOT files in data/ into flat tables,
+// which CalibBundle maps straight into memory. Graphs are stored as the
+// histogram GraphToHist makes of them. B-tag entries keep their formulas as
+// text, compiled by the readers that load them. Consumers look items up by
+// the path and name they would otherwise read, and fall back to the source
+// file when the item is missing or the bundle is out of date.
+//
+// Layout (native endianness, all offsets multiples of 8):
+//   Header   magic "CALIBBND", version, counts, checksum (FNV-1a 64 of
+//            everything after the header)
+//   Source   [nsources]: path, size, mtime and FNV-1a 64 hash of each file
+//   Record   [nrecords], sorted by key: key, kind, offset and size of its
+//            payload relative to payload_offset
+//   payload
+// Keys are "btag_csv:<csv file>" and "hist:<root file>:<name>".
+//----------------------------------------------------------------------------
+
+#ifndef H_CALIB_BUNDLE
+#define H_CALIB_BUNDLE
+
+#include <cstddef>
+#include <cstdint>
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "BTagCalibration.hpp"
+#include "BTagEntry.hpp"
+
+class TH1;
+
+class CalibBundle{
+public:
+  struct Axis{
+    int nbins;
+    double min, max;
+    const double *edges; // nbins+1 edges for variable bins, nullptr for fixed bins
+  };
+  struct Hist{
+    int ndim;
+    Axis axes[3];
+    const double *content, *errors; // Index: global bin, as TH1::GetBin
+  };
+
+  static const std::string & DefaultPath();
+  // Bundle at DefaultPath, mapped on the first call; nullptr if there is
+  // none or if any of its sources changed since it was built
+  static const CalibBundle * Default();
+
+  explicit CalibBundle(const std::string &path);
+  ~CalibBundle();
+
+  // True if every source still has the size and mtime, or else the hash,
+  // recorded when the bundle was built
+  bool IsCurrent() const;
+
+  // Calibration as read by BTagCalibration(tagger, csv_file), or nullptr
+  std::unique_ptr<BTagCalibration> Calibration(const std::string &tagger,
+                                               const std::string &csv_file) const;
+  bool FindHist(const std::string &root_file, const std::string &name, Hist &hist) const;
+
+  static uint64_t HashFile(const std::string &path);
+
+private:
+  CalibBundle(const CalibBundle &) = delete;
+  CalibBundle & operator=(const CalibBundle &) = delete;
+
+  const char * FindRecord(const std::string &key, uint32_t kind, uint64_t &size) const;
+
+  std::string path_;
+  std::size_t size_;
+  char *map_;
+};
+
+class CalibBundleWriter{
+public:
+  CalibBundleWriter();
+
+  void AddSource(const std::string &path);
+  // Entries in the order of the csv file
+  void AddCalibration(const std::string &csv_file, const std::vector<BTagEntry> &entries);
+  void AddHist(const std::string &root_file, const std::string &name, const TH1 &hist);
+
+  // Written to a temporary file renamed into place, so readers never see a partial bundle
+  void Write(const std::string &path) const;
+
+private:
+  struct Source{
+    std::string path;
+    uint64_t size;
+    int64_t mtime;
+    uint64_t hash;
+  };
+  struct Record{
+    std::string key;
+    uint32_t kind;
+    std::vector<char> payload;
+  };
+
+  std::vector<Source> sources_;
+  std::vector<Record> records_;
+};
+
+#endif
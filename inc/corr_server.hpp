@@ -0,0 +1,32 @@
+//----------------------------------------------------------------------------
+// corr_server - Local prefork server running one job per connection
+//
+// The server process initializes once (ROOT, weighters, calibrations) and
+// listens on a Unix socket. Each connection sends its working directory and
+// the command line of one job (program name first): the number of fields,
+// then each field as its size and bytes, sizes as 4-byte big-endian integers.
+// The server forks a copy-on-write worker per job, up to max_workers at once;
+// further connections wait in the socket backlog. The worker sends back
+// frames of a type byte, a 4-byte big-endian size and that many bytes: 'o'
+// for output of the job (stdout and stderr), then one 's' with its exit
+// status in decimal. python/corr_client.py is such a client.
+//
+// SIGINT or SIGTERM stops accepting jobs; running ones are waited for.
+//----------------------------------------------------------------------------
+
+#ifndef H_CORR_SERVER
+#define H_CORR_SERVER
+
+#include <functional>
+#include <string>
+#include <vector>
+
+// Runs in the worker, with the job's working directory; returns the exit status
+typedef std::function<int(const std::vector<std::string> &args)> ServerJob;
+
+void RunServer(const std::string &socket_path, unsigned max_workers, const ServerJob &job);
+
+// Calls main-style code with args as argc/argv
+int RunWithArgs(const std::vector<std::string> &args, const std::function<int(int, char*[])> &run);
+
+#endif
@@ -0,0 +1,169 @@
+//----------------------------------------------------------------------------
+// correction_set - Declarative corrections read from JSON and compiled into
+//                  flat evaluation programs
+//
+// A correction set file is {"schema_version": 1, "corrections": [...]}, each
+// correction being
+//
+//   {"name": "...", "description": "...",
+//    "inputs": [{"name": "pt", "type": "real"}, ...], // real, int or string
+//    "outputs": ["sf", "err"],
+//    "data": node}
+//
+// with a node one of
+//   * a number, or an array with one number per output: the result
+//   * {"nodetype": "formula", "variable": input, "expression": "..."}: an
+//     expression in the BTagFormula subset with the input as x; only for
+//     corrections with a single output
+//   * {"nodetype": "binning", "inputs": [...], "edges": [axis, ...],
+//      "content": [node, ...], "flow": policy, "closed": "left" or "right"}:
+//     bins in one or more real inputs, with the content flattened with the
+//     last input fastest. An axis is an array of increasing edges or
+//     {"n": bins, "low": x, "high": x} for uniform bins, found as TAxis does.
+//     Bins include their low edge, or their high edge if closed is "right".
+//     NaN is above every edge. Values outside the edges follow flow:
+//     "clamp" to the nearest bin (the default), "error", "bins" if the
+//     content also has the under- and overflow bins of every axis, as ROOT
+//     histograms, or a node evaluated instead
+//   * {"nodetype": "category", "input": input, "content": [{"key": key,
+//      "value": node}, ...], "default": node}: switch on an int or string
+//     input; without a default, other values are an error
+//
+// Each correction is compiled into one array of nodes, starting at the root,
+// whose bins and keys point to their children by index. Evaluating it walks
+// that array with one bin or key search per level; the array forms allocate
+// nothing, which limits a correction to kMaxInputs inputs. String inputs are
+// passed as the number Code returns for them.
+//----------------------------------------------------------------------------
+
+#ifndef H_CORRECTION_SET
+#define H_CORRECTION_SET
+
+#include <cstddef>
+
+#include <map>
+#include <string>
+#include <vector>
+
+#include "BTagFormula.hpp"
+
+class JsonValue;
+
+class Correction{
+public:
+  enum InputType{kReal, kInt, kString};
+  struct Input{
+    std::string name;
+    InputType type;
+  };
+  // Uniform bins if edges is empty
+  struct Axis{
+    std::string input;
+    int nbins;
+    double low, high;
+    std::vector<double> edges;
+  };
+
+  static const std::size_t kMaxInputs = 16;
+
+  Correction();
+
+  // Correction binned in real inputs, the axes' inputs in order, with
+  // content the outputs of every bin, under- and overflow included (first
+  // axis slowest, then one value per output)
+  static Correction Table(const std::string &name, const std::vector<Axis> &axes,
+                          const std::vector<std::string> &outputs, const std::vector<double> &content);
+
+  const std::string & Name() const{return name_;}
+  const std::vector<Input> & Inputs() const{return inputs_;}
+  const std::vector<std::string> & Outputs() const{return outputs_;}
+  std::size_t InputIndex(const std::string &name) const;
+  // Value to pass for the string input; values not in any key give -1
+  double Code(std::size_t input, const std::string &value) const;
+
+  // inputs[i] is the value of Inputs()[i]; fills out[j] for Outputs()[j]
+  void Evaluate(const double *inputs, double *out) const;
+  // First output; allocates a vector for the outputs
+  double Evaluate(const std::vector<double> &inputs) const;
+  // inputs[i] points to the n values of Inputs()[i]; out holds n entries
+  // of Outputs().size() values each
+  void Evaluate(std::size_t n, const double * const *inputs, double *out) const;
+
+  std::string ToJSON() const;
+
+private:
+  friend class CorrectionSet;
+
+  enum NodeType{kConstant, kFormula, kBinning, kCategory};
+  enum FlowPolicy{kFlowClamp, kFlowError, kFlowBins, kFlowNode};
+
+  static const std::size_t npos = static_cast<std::size_t>(-1);
+
+  struct BinAxis{
+    std::size_t input;
+    int nbins;
+    double low, high, width;
+    std::size_t edges; // Offset of the nbins+1 edges in edges_, npos if uniform
+    std::size_t stride;
+  };
+  struct Node{
+    NodeType type;
+    std::size_t input;    // Formula variable, category input
+    std::size_t begin;    // Constant: offset in values_; formula: index in formulas_;
+                          // binning: first axis in axes_; category: first key in keys_
+    std::size_t size;     // Binning: number of axes; category: number of keys
+    std::size_t children; // Offset in children_ of the bins or of the keys' values
+    FlowPolicy flow;
+    std::size_t fallback; // Flow node of a binning, default of a category, or npos
+    bool right_closed;
+  };
+
+  explicit Correction(const JsonValue &json);
+
+  std::size_t Compile(const JsonValue &json, const std::string &where);
+  std::size_t CompileBinning(const JsonValue &json, const std::string &where);
+  std::size_t CompileCategory(const JsonValue &json, const std::string &where);
+  std::size_t AddNode(const Node &node);
+  // Bin of value, -1 below and nbins above the edges
+  int Bin(const BinAxis &axis, double value, bool right_closed) const;
+  std::size_t Child(const Node &node, const double *inputs) const;
+  void WriteNode(std::size_t inode, std::string &out) const;
+
+  std::string name_, description_;
+  std::vector<Input> inputs_;
+  std::vector<std::string> outputs_;
+  std::vector<std::map<std::string, double> > codes_; // Index: input
+
+  std::vector<Node> nodes_;
+  std::vector<double> values_;
+  std::vector<BTagFormula> formulas_;
+  std::vector<std::string> expressions_;
+  std::vector<BinAxis> axes_;
+  std::vector<double> edges_;
+  std::vector<double> keys_; // Sorted within each category
+  std::vector<std::size_t> children_;
+};
+
+class CorrectionSet{
+public:
+  CorrectionSet() = default;
+  explicit CorrectionSet(const std::string &file);
+
+  static CorrectionSet Parse(const std::string &json, const std::string &source);
+
+  bool Has(const std::string &name) const;
+  const Correction & Get(const std::string &name) const;
+  std::vector<std::string> Names() const;
+
+  // Adds correction as name, replacing any correction of that name
+  void Add(const std::string &name, const Correction &correction);
+
+  std::string ToJSON() const;
+  void Write(const std::string &file) const;
+
+private:
+  std::vector<Correction> corrections_;
+  std::map<std::string, std::size_t> index_;
+};
+
+#endif
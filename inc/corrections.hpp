@@ -0,0 +1,50 @@
+//----------------------------------------------------------------------------
+// corrections - Per-event weight recalculation, sum-of-weights reduction and
+//               renormalization shared by calc_corr, merge_corrections,
+//               apply_corr and reweight
+//----------------------------------------------------------------------------
+
+#ifndef H_CORRECTIONS
+#define H_CORRECTIONS
+
+#include <string>
+#include <vector>
+
+#include "baby_plus.hpp"
+#include "baby_corr.hpp"
+#include "btag_weighter.hpp"
+#include "lepton_weighter.hpp"
+#include "weight_cache.hpp"
+
+namespace corrections{
+
+  // Branches rewritten by CalcEntry and ApplyEntry respectively
+  extern const std::vector<std::string> calc_branches;
+  extern const std::vector<std::string> apply_branches;
+
+  void InitSums(baby_corr &c);
+  // Whether b's input holds the shape b-tag weights; older babies do not.
+  // Checked once per file, as CalcEntry and ApplyEntry only carry these
+  // weights when they are computed (fix_b_wgt) or read
+  bool HasShapeBTag(const baby_plus &b);
+  void CalcEntry(baby_plus &b, BTagWeighter &btw, const LeptonWeighter &lw, baby_corr &c, bool isSignal,
+                 bool quick, bool fix_b_wgt, bool fix_lep_wgt, bool has_shape_b_wgt);
+
+  void Initialize(baby_corr &in, baby_corr &out);
+  void AddEntry(baby_corr &in, baby_corr &out);
+  int GetGluinoMass(const std::string &path);
+  void FixLumi(baby_corr &out, const std::string &out_path);
+  void FixISR(baby_corr &out, const std::string &out_path);
+  void Fix0L(baby_corr &out);
+  void Normalize(baby_corr &out);
+
+  void ApplyEntry(baby_plus &b, baby_corr &c, bool isSignal, bool quick, bool has_shape_b_wgt);
+
+  // Weight cache holding the out_ values of calc_branches, one column per float
+  std::vector<std::string> CacheColumns();
+  void CheckCache(const WeightCache &cache, long nent);
+  void WriteCache(baby_plus &b, WeightCacheWriter &cache, long entry);
+  void ReadCache(const WeightCache &cache, baby_plus &b, long entry);
+}
+
+#endif
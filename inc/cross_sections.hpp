@@ -3,14 +3,21 @@
 #ifndef H_CROSS_SECTIONS
 #define H_CROSS_SECTIONS
 
+#include <string>
+#include <vector>
+
 #include "TString.h"
 
 namespace xsec{
 
   float crossSection(const TString &file);
-  void signalCrossSection(int glu_mass, double &xsec, double &xsec_unc);
-  void stopCrossSection(int stop_mass, double &xsec, double &xsec_unc);
-  void higgsinoCrossSection(int hig_mass, double &xsec, double &xsec_unc);
+  // Patterns of every sample matching file, the one crossSection uses first
+  std::vector<std::string> crossSectionMatches(const TString &file);
+  // Masses off the scan give 0, or with interpolate the interpolation
+  // between the neighbouring points
+  void signalCrossSection(int glu_mass, double &xsec, double &xsec_unc, bool interpolate = false);
+  void stopCrossSection(int stop_mass, double &xsec, double &xsec_unc, bool interpolate = false);
+  void higgsinoCrossSection(int hig_mass, double &xsec, double &xsec_unc, bool interpolate = false);
   float fractionNegWeights(const TString &file);
 }
 
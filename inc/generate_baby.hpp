@@ -26,10 +26,14 @@ public:
 };
 
 bool Contains(const std::string &text, const std::string &pattern);
+std::string ElementType(const std::string &type);
 
 void WritePlusHeader(const std::set<Variable> &full_vars, const std::set<Variable> &new_vars);
 void WritePlusSource(const std::set<Variable> &full_vars, const std::set<Variable> &new_vars);
 
+void WritePlusBlockHeader(const std::set<Variable> &full_vars);
+void WritePlusBlockSource(const std::set<Variable> &full_vars);
+
 void WriteCorrHeader(const std::set<Variable> &corr_vars, const std::set<Variable> &new_vars);
 void WriteCorrSource(const std::set<Variable> &corr_vars, const std::set<Variable> &new_vars);
 
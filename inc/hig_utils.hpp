@@ -21,10 +21,21 @@
 #include "TGraph.h"
 
 #include "baby_plus.hpp"
+#include "correction_set.hpp"
 
 namespace hig_utils{
 
   int mchi(baby_plus &b);
+
+  struct TrigEff{
+    float eff, unc, errup, errdown;
+  };
+
+  // Higgsino trigger efficiency vs (ht, met), correction higtrig of
+  // data/higtrig_eff.json, read on first use
+  const Correction & HigTrigCorrection();
+  // Efficiency, uncertainty and statistical errors of the event's bin
+  TrigEff higtrig(baby_plus &b);
   float eff_higtrig(baby_plus &b);
   float effunc_higtrig(baby_plus &b);
 
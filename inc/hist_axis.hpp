@@ -0,0 +1,35 @@
+//----------------------------------------------------------------------------
+// hist_axis - Binning of a histogram axis, detached from the histogram
+//
+// Bin() matches TAxis::FindFixBin exactly, under- and overflow included and
+// NaN going to overflow, so flat tables copied out of ROOT histograms are
+// indexed as the histograms were.
+//----------------------------------------------------------------------------
+
+#ifndef H_HIST_AXIS
+#define H_HIST_AXIS
+
+#include <vector>
+
+#include "calib_bundle.hpp"
+
+class TAxis;
+
+class HistAxis{
+public:
+  HistAxis() = default;
+  explicit HistAxis(const TAxis &axis);
+  explicit HistAxis(const CalibBundle::Axis &axis);
+
+  // Bins including under- and overflow
+  int Size() const;
+  int NumBins() const;
+  int Bin(double x) const;
+
+private:
+  int nbins_ = 0;
+  double min_ = 0., max_ = 0., width_ = 0.;
+  std::vector<double> edges_; // Empty for fixed bins
+};
+
+#endif
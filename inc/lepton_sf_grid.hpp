@@ -0,0 +1,51 @@
+//----------------------------------------------------------------------------
+// lepton_sf_grid - 2D lepton SF histograms compiled into flat clamped grids
+//
+// Every cell, under- and overflow included, holds the SF value and error
+// side by side in a Correction binned like the histogram. Under- and
+// overflow cells that are empty (zero content and error) take the nearest
+// in-range cell at load time. A lookup walks the correction's binning node,
+// one bin search per axis, and copies the cell's two outputs, with the
+// values TH2::FindFixBin and the clamping fallback used to give.
+//----------------------------------------------------------------------------
+
+#ifndef H_LEPTON_SF_GRID
+#define H_LEPTON_SF_GRID
+
+#include "calib_bundle.hpp"
+#include "correction_set.hpp"
+
+class TH2;
+
+class LeptonSFGrid{
+public:
+  struct SF{
+    double value, error;
+  };
+
+  LeptonSFGrid() = default;
+  explicit LeptonSFGrid(const TH2 &hist);
+  explicit LeptonSFGrid(const CalibBundle::Hist &hist);
+  // Correction with real inputs (x, y) and outputs (value, error), as
+  // GetCorrection gives, e.g. read back from a correction set file
+  explicit LeptonSFGrid(const Correction &correction);
+
+  SF Find(double x, double y) const{
+    const double in[2] = {x, y};
+    double out[2];
+    correction_.Evaluate(in, out);
+    return SF{out[0], out[1]};
+  }
+
+  const Correction & GetCorrection() const{return correction_;}
+
+private:
+  // content(ix, iy) and error(ix, iy) for bins of the axes
+  template<typename Content, typename Error>
+    void Fill(const Correction::Axis &x, const Correction::Axis &y,
+              const Content &content, const Error &error);
+
+  Correction correction_;
+};
+
+#endif
@@ -1,41 +1,90 @@
 #ifndef H_LEPTON_WEIGHTER
 #define H_LEPTON_WEIGHTER
 
+#include <map>
+#include <mutex>
+#include <string>
 #include <vector>
-#include <utility>
-
-#include "TH2D.h"
-#include "TH2F.h"
 
 #include "baby_plus.hpp"
+#include "lepton_sf_grid.hpp"
+
+class baby_plus_block;
 
 class LeptonWeighter{
 public:
-  LeptonWeighter();
+  typedef LeptonSFGrid::SF SF;
+
+  // 2D histogram or TGraphAsymmErrors item_name of data/file_name
+  struct Source{
+    std::string file_name, item_name;
+  };
+
+  // Every SF table of the weights; all are looked up at (x, y) = (pt, |eta|)
+  // except full_electron_tracking, at (eta, pt)
+  struct SFSet{
+    Source full_muon_medium, full_muon_iso, full_muon_vtx;
+    Source full_electron_medium, full_electron_iso, full_electron_tracking;
+    Source fast_muon_medium, fast_muon_iso, fast_electron_mediumiso;
+  };
+
+  // The Moriond 2017 SFs
+  static const SFSet & DefaultSFSet();
+  // DefaultSFSet with the tables listed in file replaced; one "table file_name
+  // item_name" per line, with table a member name of SFSet and # starting comments
+  static SFSet ReadSFSet(const std::string &file);
+  // Member of SFSet of each table name
+  static const std::map<std::string, Source SFSet::*> & SFSetTables();
+  // Table of a source: correction item_name of a correction set file_name
+  // (.json, e.g. from export_lepton_sf.exe), else the histogram or graph from
+  // the calibration bundle or the ROOT file
+  static LeptonSFGrid LoadGrid(const Source &source);
+
+  // The fullsim and the fastsim tables are each read on first use
+  explicit LeptonWeighter(const SFSet &sf_set = DefaultSFSet());
+
+  // Loads now what the weights read on first use, e.g. before forking workers
+  void Preload(bool fast_sim) const;
+
+  void FullSim(baby_plus &b, float &w_lep, std::vector<float> &sys_lep) const;
+  void FastSim(baby_plus &b, float &w_fs_lep, std::vector<float> &sys_fs_lep) const;
+
+  // Same weights for every entry of a block, with sys_*[0] in *_up and
+  // sys_*[1] in *_down; the block must have BlockBranches() loaded
+  static const std::vector<std::string> & BlockBranches();
+  void FullSim(const baby_plus_block &block, float *w_lep, float *sys_lep_up, float *sys_lep_down) const;
+  void FastSim(const baby_plus_block &block, float *w_fs_lep, float *sys_fs_lep_up, float *sys_fs_lep_down) const;
+
+  // Merged (SF, error) of all components for one lepton; electrons take the supercluster pt and eta
+  SF MuonSF(double pt, double eta) const;
+  SF ElectronSF(double pt, double eta) const;
+  SF MuonSFFS(double pt, double eta) const;
+  SF ElectronSFFS(double pt, double eta) const;
 
-  static void FullSim(baby_plus &b, float &w_lep, std::vector<float> &sys_lep);
-  static void FastSim(baby_plus &b, float &w_fs_lep, std::vector<float> &sys_fs_lep);
-  
 private:
-  static const TH2F sf_full_muon_medium_;
-  static const TH2F sf_full_muon_iso_;
-  static const TH2F sf_full_muon_vtx_;
-  static const TH2D sf_full_muon_tracking_;
+  struct FullSimTables{
+    std::once_flag loaded;
+    LeptonSFGrid muon_medium, muon_iso, muon_vtx;
+    LeptonSFGrid electron_medium, electron_iso, electron_tracking;
+  };
+  struct FastSimTables{
+    std::once_flag loaded;
+    LeptonSFGrid muon_medium, muon_iso;
+    LeptonSFGrid electron_mediumiso;
+  };
 
-  static const TH2F sf_full_electron_medium_;
-  static const TH2F sf_full_electron_iso_;
-  static const TH2F sf_full_electron_tracking_;
+  const FullSimTables & FullTables() const;
+  const FastSimTables & FastTables() const;
 
-  static const TH2D sf_fast_muon_medium_;
-  static const TH2D sf_fast_muon_iso_;
-  
-  static const TH2D sf_fast_electron_mediumiso_;
+  static SF MuonSF(const FullSimTables &t, double pt, double eta);
+  static SF ElectronSF(const FullSimTables &t, double pt, double eta);
+  static SF MuonSFFS(const FastSimTables &t, double pt, double eta);
+  static SF ElectronSFFS(const FastSimTables &t, double pt, double eta);
 
-  static std::pair<double, double> GetMuonScaleFactor(baby_plus &b, std::size_t ilep);
-  static std::pair<double, double> GetElectronScaleFactor(baby_plus &b, std::size_t ilep);
+  SFSet sf_set_;
 
-  static std::pair<double, double> GetMuonScaleFactorFS(baby_plus &b, std::size_t ilep);
-  static std::pair<double, double> GetElectronScaleFactorFS(baby_plus &b, std::size_t ilep);
+  mutable FullSimTables full_;
+  mutable FastSimTables fast_;
 };
 
 #endif
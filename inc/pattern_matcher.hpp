@@ -0,0 +1,42 @@
+//----------------------------------------------------------------------------
+// pattern_matcher - Finds which of a fixed list of substrings a text contains
+//
+// The patterns are compiled once into an Aho-Corasick automaton over the
+// characters they use, so a text is scanned in a single pass whatever the
+// number of patterns, instead of one substring search per pattern.
+//----------------------------------------------------------------------------
+
+#ifndef H_PATTERN_MATCHER
+#define H_PATTERN_MATCHER
+
+#include <cstddef>
+
+#include <string>
+#include <vector>
+
+class PatternMatcher{
+public:
+  PatternMatcher() = default;
+  // Patterns must be distinct and not empty
+  explicit PatternMatcher(const std::vector<std::string> &patterns);
+
+  std::size_t Size() const;
+  const std::string & Pattern(std::size_t i) const;
+
+  // Sorted indices of the patterns contained in text
+  std::vector<std::size_t> Find(const std::string &text) const;
+
+private:
+  static const int kNoPattern = -1;
+
+  void AddPattern(std::size_t ipattern);
+
+  std::vector<std::string> patterns_;
+  int classes_[256] = {}; // Column of each character in next_, 0 if in no pattern
+  std::size_t nclasses_ = 1;
+  std::vector<int> next_;    // Transition of (state, class), nclasses_ per state
+  std::vector<int> pattern_; // Pattern ending at each state, or kNoPattern
+  std::vector<int> output_;  // Nearest proper suffix state ending a pattern, or -1
+};
+
+#endif
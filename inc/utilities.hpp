@@ -13,6 +13,7 @@
 #include <string>
 #include <vector>
 #include <set>
+#include <utility>
 
 #include <unistd.h>
 
@@ -20,6 +21,9 @@
 #include "TTree.h"
 #include "TGraph.h"
 
+class TGraphAsymmErrors;
+class TH2D;
+
 #define ERROR(x) do{throw std::runtime_error(std::string("Error in file ")+__FILE__+" at line "+std::to_string(__LINE__)+" (in "+__func__+"): "+x);}while(false)
 #define DBG(x) do{std::cerr << "In " << __FILE__ << " at line " << __LINE__ << " (in function " << __func__ << "): " << x << std::endl;}while(false)
 
@@ -89,4 +93,12 @@ std::string CopyReplaceAll(const std::string str, const std::string &orig, const
 
 void SplitFilePath(const std::string &path, std::string &dir_name, std::string &base_name);
 
+std::vector<std::pair<long, long> > SplitRange(long nent, unsigned nparts);
+std::string PartFileName(const std::string &file, unsigned part);
+void MergeParts(const std::vector<std::string> &parts, const std::string &out_file);
+
+// 2D histogram with a single x bin, whose y bins are the x ranges of the
+// graph's points; gaps and overlaps get the geometric mean of their neighbors
+TH2D GraphToHist(const TGraphAsymmErrors &g);
+
 #endif
@@ -0,0 +1,67 @@
+//----------------------------------------------------------------------------
+// weight_cache - Columnar per-event weight file, mapped straight into memory
+//
+// Layout (native endianness):
+//   char     magic[8]      "WGTCACHE"
+//   uint32_t version
+//   uint32_t ncols
+//   int64_t  nent
+//   uint64_t data_offset   multiple of the page size
+//   char     names[ncols][64], NUL-padded
+//   float    columns[ncols][nent] starting at data_offset, column i at
+//            data_offset + i*nent*sizeof(float); value j is entry j
+//----------------------------------------------------------------------------
+
+#ifndef H_WEIGHT_CACHE
+#define H_WEIGHT_CACHE
+
+#include <cstddef>
+#include <cstdint>
+
+#include <string>
+#include <vector>
+
+class WeightCache{
+public:
+  explicit WeightCache(const std::string &path);
+  ~WeightCache();
+
+  long GetEntries() const;
+  const std::vector<std::string> & Columns() const;
+  std::size_t ColumnIndex(const std::string &name) const;
+  const float * Column(std::size_t icol) const;
+  const float * Column(const std::string &name) const;
+
+private:
+  WeightCache(const WeightCache &) = delete;
+  WeightCache & operator=(const WeightCache &) = delete;
+
+  std::string path_;
+  std::vector<std::string> columns_;
+  long nent_;
+  std::size_t size_;
+  char *map_;
+  const float *data_;
+};
+
+class WeightCacheWriter{
+public:
+  WeightCacheWriter(const std::string &path, const std::vector<std::string> &columns, long nent);
+  ~WeightCacheWriter();
+
+  // Different threads may fill different entries concurrently
+  float * Column(std::size_t icol);
+
+private:
+  WeightCacheWriter(const WeightCacheWriter &) = delete;
+  WeightCacheWriter & operator=(const WeightCacheWriter &) = delete;
+
+  std::string path_;
+  std::size_t ncols_;
+  long nent_;
+  std::size_t size_;
+  char *map_;
+  float *data_;
+};
+
+#endif
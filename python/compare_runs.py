@@ -0,0 +1,96 @@
+#! /usr/bin/env python
+
+from __future__ import print_function
+
+import argparse
+import os
+import subprocess
+import sys
+
+def fullPath(path):
+    return os.path.realpath(os.path.abspath(os.path.expanduser(path)))
+
+def ensureDir(path):
+    try:
+        os.makedirs(path)
+    except OSError:
+        if not os.path.isdir(path):
+            raise
+
+def runChain(name, run_dir, in_file, work_dir, threads, quick):
+    # calc_corr.exe then apply_corr.exe on in_file, with the executables of run_dir
+    out_dir = os.path.join(work_dir, name)
+    corr_dir = os.path.join(out_dir, "corrections")
+    reweighted_dir = os.path.join(out_dir, "reweighted")
+    ensureDir(corr_dir)
+    ensureDir(reweighted_dir)
+    file_name = os.path.basename(in_file)
+    options = ["--quick"] if quick else []
+    if threads > 1:
+        options += ["-t", str(threads)]
+
+    print("\n=== {}: calc_corr.exe and apply_corr.exe from {}".format(name, run_dir))
+    subprocess.check_call([os.path.join(run_dir, "calc_corr.exe"), "-f", in_file,
+                           "-c", corr_dir, "-o", reweighted_dir] + options)
+    outputs = {"reweighted": os.path.join(reweighted_dir, file_name),
+               "corrections": os.path.join(corr_dir, file_name),
+               "renormalized": os.path.join(out_dir, file_name)}
+    subprocess.check_call([os.path.join(run_dir, "apply_corr.exe"), "-i", outputs["reweighted"],
+                           "-c", outputs["corrections"], "-o", outputs["renormalized"]] + options)
+    return outputs
+
+def compareChains(compare_exe, name_a, outputs_a, name_b, outputs_b, tolerance):
+    same = True
+    for step in ["reweighted", "corrections", "renormalized"]:
+        print("\n=== {} vs {}: {}".format(name_a, name_b, step))
+        command = [compare_exe, outputs_a[step], outputs_b[step]]
+        # The sums of weights, and the weights renormalized with them, may
+        # differ in the last bits when added up in another order
+        if step != "reweighted":
+            command += ["-r", str(tolerance)]
+        if subprocess.call(command) != 0:
+            same = False
+    return same
+
+def compareRuns(in_file, new_dir, baseline_dir, threads, work_dir, tolerance, quick):
+    in_file = fullPath(in_file)
+    new_dir = fullPath(new_dir)
+    work_dir = fullPath(work_dir)
+    compare_exe = os.path.join(new_dir, "compare_babies.exe")
+
+    single = runChain("single", new_dir, in_file, work_dir, 1, quick)
+    results = []
+    if threads > 1:
+        threaded = runChain("threads{}".format(threads), new_dir, in_file, work_dir, threads, quick)
+        results.append(("--threads {} vs single-threaded".format(threads),
+                        compareChains(compare_exe, "single", single, "threaded", threaded, tolerance)))
+    if baseline_dir:
+        baseline = runChain("baseline", fullPath(baseline_dir), in_file, work_dir, 1, quick)
+        results.append(("new vs baseline",
+                        compareChains(compare_exe, "baseline", baseline, "new", single, tolerance)))
+
+    print("")
+    for description, same in results:
+        print("{}: {}".format(description, "same" if same else "DIFFERENT"))
+    return all(same for description, same in results)
+
+if __name__ == "__main__":
+    parser = argparse.ArgumentParser(description="Runs calc_corr.exe and apply_corr.exe on one baby single-threaded, with --threads and with a baseline build, and compares the outputs branch by branch with compare_babies.exe",
+                                     formatter_class=argparse.ArgumentDefaultsHelpFormatter)
+    parser.add_argument("in_file", help="Unprocessed baby to run on; several thousand entries exercise the part merging")
+    parser.add_argument("-r","--run_dir", default="run",
+                        help="Directory with the executables to check")
+    parser.add_argument("-b","--baseline_dir", default="",
+                        help="Directory with the executables of a baseline build, e.g. the run/ of a git worktree of an older commit; skipped if empty")
+    parser.add_argument("-t","--threads", type=int, default=4,
+                        help="Number of threads of the threaded run; no threaded run if 1")
+    parser.add_argument("-w","--work_dir", default="compare_runs",
+                        help="Directory in which to write the outputs of every run")
+    parser.add_argument("--tolerance", type=float, default=1e-6,
+                        help="Largest relative difference allowed in the sums of weights and the renormalized babies")
+    parser.add_argument("-q","--quick", action="store_true",
+                        help="Run in quick mode, only adjusting some weights")
+    args = parser.parse_args()
+
+    same = compareRuns(args.in_file, args.run_dir, args.baseline_dir, args.threads, args.work_dir, args.tolerance, args.quick)
+    sys.exit(0 if same else 1)
@@ -0,0 +1,79 @@
+#! /usr/bin/env python
+
+from __future__ import print_function
+
+import argparse
+import os
+import socket
+import struct
+import sys
+import time
+
+def connect(socket_path, timeout):
+    deadline = time.time() + timeout
+    while True:
+        sock = socket.socket(socket.AF_UNIX, socket.SOCK_STREAM)
+        try:
+            sock.connect(socket_path)
+            return sock
+        except socket.error:
+            sock.close()
+            if time.time() > deadline:
+                raise
+            time.sleep(0.2)
+
+def recvExact(sock, size):
+    data = b""
+    while len(data) < size:
+        chunk = sock.recv(size-len(data))
+        if not chunk:
+            return None
+        data += chunk
+    return data
+
+def runJob(socket_path, command, timeout):
+    sock = connect(socket_path, timeout)
+    fields = [field.encode() for field in [os.getcwd()] + command]
+    request = struct.pack(">I", len(fields))
+    for field in fields:
+        request += struct.pack(">I", len(field)) + field
+    sock.sendall(request)
+
+    # Frames of a type byte, a big-endian size and the payload: job output
+    # until the exit status
+    out = getattr(sys.stdout, "buffer", sys.stdout)
+    status = None
+    while status is None:
+        header = recvExact(sock, 5)
+        if header is None:
+            break
+        frame_type, size = struct.unpack(">cI", header)
+        payload = recvExact(sock, size)
+        if payload is None:
+            break
+        if frame_type == b"s":
+            status = int(payload)
+        else:
+            out.write(payload)
+            out.flush()
+    sock.close()
+
+    if status is None:
+        print("Server closed the connection without an exit status", file=sys.stderr)
+        return 1
+    return status
+
+if __name__ == "__main__":
+    parser = argparse.ArgumentParser(description="Runs one job on a calc_corr.exe or apply_corr.exe started with --serve, "
+                                     "streaming its output and exiting with its status",
+                                     formatter_class=argparse.ArgumentDefaultsHelpFormatter)
+    parser.add_argument("-t","--timeout", type=float, default=300.,
+                        help="Seconds to keep retrying while the server starts up")
+    parser.add_argument("socket", help="Unix socket the server listens on")
+    parser.add_argument("command", nargs=argparse.REMAINDER,
+                        help="Program name and options of the job, as given to the executable")
+    args = parser.parse_args()
+    if len(args.command) == 0:
+        parser.error("Missing job command")
+
+    sys.exit(runJob(args.socket, args.command, args.timeout))
@@ -15,6 +15,8 @@ quick = False
 wanted_samples = []
 
 njobs = 50
+# if positive, each job starts an apply_corr.exe server running this many files at once
+server_workers = 0
 
 
 def getTag(file):
@@ -73,6 +75,10 @@ for ijob in range(njobs):
   fexe = open(exename,"w")
   os.system("chmod u+x "+exename)
   fexe.write("#!/bin/bash\n\n")
+  if server_workers>0:
+    fexe.write("SOCKET=`mktemp -u /tmp/apply_corr_XXXXXX.sock`\n")
+    fexe.write("./run/apply_corr.exe --serve $SOCKET --workers "+str(server_workers)+" &\n")
+    fexe.write("SERVER=$!\nCLIENTS=\n")
   for ifile in range(ijob*splitting, (ijob+1)*splitting):
     if ifile>=len(infiles): 
       done = True
@@ -88,8 +94,13 @@ for ijob in range(njobs):
       execmd = "\n./run/apply_corr.exe --quick -i "+infile+" -c "+corrfile+" -o "+outfile.replace("_renorm.root","_requick.root")+'\n'
     else:
       execmd = "\n./run/apply_corr.exe -i "+infile+" -c "+corrfile+" -o "+outfile+'\n'
+    if server_workers>0:
+      execmd = execmd.replace("./run/apply_corr.exe", "./python/corr_client.py $SOCKET ./run/apply_corr.exe")
+      execmd = execmd.rstrip('\n')+' &\nCLIENTS="$CLIENTS $!"\n'
 
     fexe.write(execmd)
+  if server_workers>0:
+    fexe.write("\nwait $CLIENTS\nkill $SERVER\nwait $SERVER\n")
   fexe.write("echo Job finished.")
   fexe.close()
   cmd = "JobSubmit.csh ./run/wrapper.sh "+exename
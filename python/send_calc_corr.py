@@ -17,7 +17,7 @@ def ensureDir(path):
         if not os.path.isdir(path):
             raise
 
-def sendCalcCorr(in_dir, out_dir, wgt_dir, quick, num_jobs):
+def sendCalcCorr(in_dir, out_dir, wgt_dir, quick, num_jobs, server_workers):
     in_dir = fullPath(in_dir)
     out_dir = fullPath(out_dir)
     wgt_dir = fullPath(wgt_dir)
@@ -29,6 +29,7 @@ def sendCalcCorr(in_dir, out_dir, wgt_dir, quick, num_jobs):
 
     groomer_dir = os.path.dirname(os.path.dirname(__file__))
     exe_path = fullPath(os.path.join(groomer_dir,"run","calc_corr.exe"))
+    client_path = fullPath(os.path.join(groomer_dir,"python","corr_client.py"))
 
     cmssw_dir = os.path.join(os.environ["CMSSW_BASE"],"src")
 
@@ -56,14 +57,28 @@ def sendCalcCorr(in_dir, out_dir, wgt_dir, quick, num_jobs):
             print(". /net/cms2/cms2r0/babymaker/cmsset_default.sh", file=run_file)
             print("eval `scramv1 runtime -sh`", file=run_file)
             print("cd $DIRECTORY", file=run_file)
+            if server_workers > 0:
+                # Calibrations are loaded once by the server, and each file runs in a forked worker
+                print("", file=run_file)
+                print("SOCKET=`mktemp -u /tmp/calc_corr_XXXXXX.sock`", file=run_file)
+                print("{} --serve $SOCKET --workers {} &".format(exe_path,server_workers), file=run_file)
+                print("SERVER=$!", file=run_file)
+                print("CLIENTS=", file=run_file)
             for i in range(len(job_files)):
                 f = job_files[i]
                 command = "{} -f {} -c {} -o {}".format(exe_path,f,wgt_dir,out_dir)
                 if quick:
                     command += " --quick"
+                if server_workers > 0:
+                    command = "{} $SOCKET {} &\nCLIENTS=\"$CLIENTS $!\"".format(client_path,command)
                 print("", file=run_file)
                 print("echo Starting to process file {} of {}".format(i+1, len(job_files)), file=run_file)
                 print(command, file=run_file)
+            if server_workers > 0:
+                print("", file=run_file)
+                print("wait $CLIENTS", file=run_file)
+                print("kill $SERVER", file=run_file)
+                print("wait $SERVER", file=run_file)
         subprocess.call(["JobSubmit.csh",run_path])
         num_submitted += 1
         
@@ -84,6 +99,8 @@ if __name__ == "__main__":
     parser.add_argument("-q","--quick", action="store_true",
                         help="Run in quick mode, only adjusting some weights")
     parser.add_argument("-n","--njobs", type=int, default=50, help="Number of jobs to submit")
+    parser.add_argument("-s","--server_workers", type=int, default=0,
+                        help="If positive, each job starts a calc_corr.exe server running this many files at once")
     args = parser.parse_args()
 
-    sendCalcCorr(args.in_dir, args.out_dir, args.wgt_dir, args.quick, args.njobs)
+    sendCalcCorr(args.in_dir, args.out_dir, args.wgt_dir, args.quick, args.njobs, args.server_workers)
@@ -1,7 +1,32 @@
 #include "BTagCalibrationReader.hpp"
 
+#include <algorithm>
+#include <cmath>
+#include <functional>
+
+#include "btag_formulas.hpp"
 #include "utilities.hpp"
 
+namespace {
+  // Slab [edges[i], edges[i+1]) containing x, or -1
+  int FindClosedOpen(const std::vector<float> &edges, float x) {
+    if (edges.size() < 2 || !(edges.front() <= x && x < edges.back())) return -1;
+    return std::upper_bound(edges.begin(), edges.end(), x) - edges.begin() - 1;
+  }
+
+  // Slab (edges[i], edges[i+1]] containing x, or -1
+  int FindOpenClosed(const std::vector<float> &edges, float x) {
+    if (edges.size() < 2 || !(edges.front() < x && x <= edges.back())) return -1;
+    return std::lower_bound(edges.begin(), edges.end(), x) - edges.begin() - 1;
+  }
+
+  std::vector<float> SortedEdges(std::vector<float> edges) {
+    std::sort(edges.begin(), edges.end());
+    edges.erase(std::unique(edges.begin(), edges.end()), edges.end());
+    return edges;
+  }
+}
+
 class BTagCalibrationReader::BTagCalibrationReaderImpl
 {
   friend class BTagCalibrationReader;
@@ -14,7 +39,52 @@ public:
     float ptMax;
     float discrMin;
     float discrMax;
-    TF1 func;
+    size_t sys;  // sys handle of the sysType the entry was loaded for
+    BTagFormula formula;
+    TF1 func;  // only set up if formula did not compile
+
+    // linear interpolation table from ptMin in steps of 1/gridInvStep, empty if not used
+    std::vector<double> grid;
+    double gridInvStep;
+
+    double exact(double x) const {
+      return formula.isCompiled() ? formula.eval(x) : func.Eval(x);
+    }
+    double eval(double x) const {
+      if (!grid.empty()) {
+        double u = (x - ptMin) * gridInvStep;
+        if (u >= 0. && u <= grid.size()-1) {
+          size_t i = std::min(static_cast<size_t>(u), grid.size()-2);
+          return grid[i] + (u - i) * (grid[i+1] - grid[i]);
+        }
+      }
+      return exact(x);
+    }
+  };
+
+  // Entries of one flavor, of every sysType, split into non-overlapping eta
+  // slabs on the edges of all of them, each split into pt slabs (and discr
+  // slabs for reshaping). Every cell stores, side by side for all sysTypes,
+  // the first entry of that sysType in tmpData_ covering it, so one search
+  // finds the central and every systematic function and lookups keep the
+  // first-match semantics of a linear scan per sysType.
+  struct PtSlab {
+    std::vector<float> discrEdges;  // reshaping only
+    std::vector<int> first;         // [discr slab, or a single one][sys handle]; -1 if none
+  };
+  struct EtaSlab {
+    std::vector<float> ptEdges;
+    std::vector<PtSlab> pt;
+    // pt bounds, from the central entries only
+    std::pair<float, float> firstMinMaxPt;           // pt range of the first entry
+    std::vector<float> minMaxDiscrEdges;             // reshaping only
+    std::vector<std::pair<float, float> > minMaxPt;  // per discr slab, or a single one
+  };
+  // Index of the sysTypes of one flavor that read eta the same way
+  struct FlavorIndex {
+    bool useAbsEta = true;
+    std::vector<float> etaEdges;
+    std::vector<EtaSlab> eta;
   };
 
 private:
@@ -37,15 +107,43 @@ private:
                           float pt,
                           float discr) const;
 
+  int sys_handle(const std::string & sys) const;
+
+  double eval_auto_bounds(int sys,
+                          BTagEntry::JetFlavor jf,
+                          float eta,
+                          float pt,
+                          float discr) const;
+
+  bool eval_auto_bounds_all(BTagEntry::JetFlavor jf,
+                            float eta,
+                            float pt,
+                            float discr,
+                            double * sfs) const;
+
   std::pair<float, float> min_max_pt(BTagEntry::JetFlavor jf,
                                      float eta,
                                      float discr) const;
 
+  void setPtGrid(float step, double tolerance);
+  void tabulate(TmpEntry &te) const;
+  void buildIndex(BTagEntry::JetFlavor jf, size_t group);
+  const EtaSlab * findEtaSlab(const FlavorIndex & index, float eta) const;
+  std::pair<float, float> minMaxPt(const EtaSlab * slab, float discr) const;
+  const int * findEntries(const EtaSlab * slab, float pt, float discr) const;
+  const EtaSlab * autoBounds(BTagEntry::JetFlavor jf, float eta, float & pt,
+                             float discr, bool & is_out_of_bounds) const;
+  double evalEntry(BTagEntry::JetFlavor jf, int entry, float pt, float discr) const;
+
   BTagEntry::OperatingPoint op_;
-  std::string sysType_;
+  std::vector<std::string> sysTypes_;  // index: sys handle, the central sysType first
+  float gridStep_;
+  double gridTolerance_;
   std::vector<std::vector<TmpEntry> > tmpData_;  // first index: jetFlavor
-  std::vector<bool> useAbsEta_;                  // first index: jetFlavor
-  std::map<std::string, std::shared_ptr<BTagCalibrationReaderImpl>> otherSysTypeReaders_;
+  // One index per way of reading eta (signed or |eta|) among the sysTypes,
+  // as each sysType reads it like a reader of its own
+  std::vector<std::vector<FlavorIndex> > index_;  // [jetFlavor][eta group]
+  std::vector<std::vector<size_t> > etaGroup_;    // [jetFlavor][sys handle]
 };
 
 
@@ -54,18 +152,19 @@ BTagCalibrationReader::BTagCalibrationReaderImpl::BTagCalibrationReaderImpl(
                                              const std::string & sysType,
                                              const std::vector<std::string> & otherSysTypes):
   op_(op),
-  sysType_(sysType),
+  sysTypes_(1, sysType),
+  gridStep_(0.),
+  gridTolerance_(0.),
   tmpData_(3),
-  useAbsEta_(3, true)
+  index_(3, std::vector<FlavorIndex>(1))
 {
   for (const std::string & ost : otherSysTypes) {
-    if (otherSysTypeReaders_.count(ost)) {
+    if (std::find(sysTypes_.begin()+1, sysTypes_.end(), ost) != sysTypes_.end()) {
       ERROR(("BTagCalibrationReader: Every otherSysType should only be given once. Duplicate: "+ost));
     }
-    otherSysTypeReaders_[ost] = std::auto_ptr<BTagCalibrationReaderImpl>(
-        new BTagCalibrationReaderImpl(op, ost)
-    );
+    sysTypes_.push_back(ost);
   }
+  etaGroup_.assign(3, std::vector<size_t>(sysTypes_.size(), 0));
 }
 
 void BTagCalibrationReader::BTagCalibrationReaderImpl::load(
@@ -77,72 +176,290 @@ void BTagCalibrationReader::BTagCalibrationReaderImpl::load(
     ERROR(("BTagCalibrationReader: Data for this jet-flavor is already loaded: "+std::to_string(static_cast<unsigned int>(jf))));
   }
 
-  BTagEntry::Parameters params(op_, measurementType, sysType_);
-  const std::vector<BTagEntry> &entries = c.getEntries(params);
+  std::vector<bool> signedEta(sysTypes_.size(), false);
+  for (size_t sys = 0; sys < sysTypes_.size(); ++sys) {
+    BTagEntry::Parameters params(op_, measurementType, sysTypes_[sys]);
+    const std::vector<BTagEntry> &entries = c.getEntries(params);
 
-  for (const auto &be : entries) {
-    if (be.params.jetFlavor != jf) {
-      continue;
-    }
+    for (const auto &be : entries) {
+      if (be.params.jetFlavor != jf) {
+        continue;
+      }
 
-    TmpEntry te;
-    te.etaMin = be.params.etaMin;
-    te.etaMax = be.params.etaMax;
-    te.ptMin = be.params.ptMin;
-    te.ptMax = be.params.ptMax;
-    te.discrMin = be.params.discrMin;
-    te.discrMax = be.params.discrMax;
-
-    if (op_ == BTagEntry::OP_RESHAPING) {
-      te.func = TF1("", be.formula.c_str(),
-                    be.params.discrMin, be.params.discrMax);
-    } else {
-      te.func = TF1("", be.formula.c_str(),
-                    be.params.ptMin, be.params.ptMax);
+      TmpEntry te;
+      te.etaMin = be.params.etaMin;
+      te.etaMax = be.params.etaMax;
+      te.ptMin = be.params.ptMin;
+      te.ptMax = be.params.ptMax;
+      te.discrMin = be.params.discrMin;
+      te.discrMax = be.params.discrMax;
+      te.sys = sys;
+
+      te.formula = BTagFormula(be.formula, FindNativeBTagFormula(be.formula));
+      if (!te.formula.isCompiled()) {
+        if (op_ == BTagEntry::OP_RESHAPING) {
+          te.func = TF1("", be.formula.c_str(),
+                        be.params.discrMin, be.params.discrMax);
+        } else {
+          te.func = TF1("", be.formula.c_str(),
+                        be.params.ptMin, be.params.ptMax);
+        }
+      }
+
+      tabulate(te);
+      tmpData_[be.params.jetFlavor].push_back(te);
+      if (te.etaMin < 0) {
+        signedEta[sys] = true;
+      }
     }
+  }
+
+  // a sysType uses |eta| if none of its entries has a negative etaMin;
+  // sysTypes that differ from the central one get a second index
+  std::vector<FlavorIndex> &groups = index_[jf];
+  groups.assign(1, FlavorIndex());
+  groups[0].useAbsEta = !signedEta[0];
+  for (size_t sys = 0; sys < sysTypes_.size(); ++sys) {
+    etaGroup_[jf][sys] = signedEta[sys] == signedEta[0] ? 0 : 1;
+  }
+  if (std::find(etaGroup_[jf].begin(), etaGroup_[jf].end(), 1) != etaGroup_[jf].end()) {
+    groups.push_back(FlavorIndex());
+    groups[1].useAbsEta = signedEta[0];
+  }
 
-    tmpData_[be.params.jetFlavor].push_back(te);
-    if (te.etaMin < 0) {
-      useAbsEta_[be.params.jetFlavor] = false;
+  for (size_t group = 0; group < groups.size(); ++group) {
+    buildIndex(jf, group);
+  }
+}
+
+void BTagCalibrationReader::BTagCalibrationReaderImpl::setPtGrid(
+                                             float step,
+                                             double tolerance)
+{
+  gridStep_ = step;
+  gridTolerance_ = tolerance;
+  for (auto &entries : tmpData_) {
+    for (auto &te : entries) {
+      tabulate(te);
     }
   }
+}
+
+// Samples a pt-dependent function on the grid, keeping the table only if
+// linear interpolation is within tolerance at several points of every step
+void BTagCalibrationReader::BTagCalibrationReaderImpl::tabulate(
+                                             TmpEntry &te) const
+{
+  const size_t max_steps = 1 << 16;
+  const int checks_per_step = 4;
+
+  te.grid.clear();
+  te.gridInvStep = 0.;
+  if (gridStep_ <= 0. || op_ == BTagEntry::OP_RESHAPING
+      || !(te.ptMin < te.ptMax) || (te.ptMax - te.ptMin)/gridStep_ > max_steps) {
+    return;
+  }
+  size_t nsteps = std::ceil((te.ptMax - te.ptMin)/gridStep_);
+  double step = (static_cast<double>(te.ptMax) - te.ptMin)/nsteps;
 
-  for (auto & p : otherSysTypeReaders_) {
-    p.second->load(c, jf, measurementType);
+  std::vector<double> grid(nsteps+1);
+  for (size_t i = 0; i <= nsteps; ++i) {
+    grid[i] = te.exact(te.ptMin + i*step);
   }
+  for (size_t i = 0; i < nsteps; ++i) {
+    for (int k = 1; k < checks_per_step; ++k) {
+      double frac = static_cast<double>(k)/checks_per_step;
+      double interpolated = grid[i] + frac * (grid[i+1] - grid[i]);
+      if (!(std::fabs(interpolated - te.exact(te.ptMin + (i+frac)*step)) <= gridTolerance_)) {
+        return;
+      }
+    }
+  }
+  te.grid.swap(grid);
+  te.gridInvStep = 1./step;
 }
 
-double BTagCalibrationReader::BTagCalibrationReaderImpl::eval(
+void BTagCalibrationReader::BTagCalibrationReaderImpl::buildIndex(
                                              BTagEntry::JetFlavor jf,
-                                             float eta,
-                                             float pt,
-                                             float discr) const
+                                             size_t group)
 {
   bool use_discr = (op_ == BTagEntry::OP_RESHAPING);
-  if (useAbsEta_[jf] && eta < 0) {
-    eta = -eta;
+  const size_t nsys = sysTypes_.size();
+  const auto &entries = tmpData_.at(jf);
+  const auto &etaGroup = etaGroup_.at(jf);
+  FlavorIndex &index = index_.at(jf).at(group);
+
+  // first entry of every sysType among candidates (in load order) satisfying covers
+  auto firstPerSys = [&](const std::vector<int> &candidates, std::vector<int> &first,
+                         const std::function<bool(const TmpEntry &)> &covers) {
+    size_t offset = first.size();
+    first.resize(offset+nsys, -1);
+    for (int i : candidates) {
+      const TmpEntry &e = entries.at(i);
+      if (first[offset+e.sys] < 0 && covers(e)) {
+        first[offset+e.sys] = i;
+      }
+    }
+  };
+
+  std::vector<float> edges;
+  for (const auto &e : entries) {
+    if (etaGroup[e.sys] != group) continue;
+    edges.push_back(e.etaMin);
+    edges.push_back(e.etaMax);
   }
+  index.etaEdges = SortedEdges(edges);
+  index.eta.assign(index.etaEdges.empty() ? 0 : index.etaEdges.size()-1, EtaSlab());
+
+  for (size_t ieta = 0; ieta < index.eta.size(); ++ieta) {
+    EtaSlab &slab = index.eta.at(ieta);
+    std::vector<int> covering;
+    for (size_t i = 0; i < entries.size(); ++i) {
+      if (etaGroup[entries.at(i).sys] == group
+          && entries.at(i).etaMin <= index.etaEdges.at(ieta)
+          && index.etaEdges.at(ieta+1) <= entries.at(i).etaMax) {
+        covering.push_back(i);
+      }
+    }
 
-  // search linearly through eta, pt and discr ranges and eval
-  // future: find some clever data structure based on intervals
-  const auto &entries = tmpData_.at(jf);
-  for (unsigned i=0; i<entries.size(); ++i) {
-    const auto &e = entries.at(i);
-    if (
-      e.etaMin <= eta && eta < e.etaMax                   // find eta
-      && e.ptMin < pt && pt <= e.ptMax                    // check pt
-    ){
-      if (use_discr) {                                    // discr. reshaping?
-        if (e.discrMin <= discr && discr < e.discrMax) {  // check discr
-          return e.func.Eval(discr);
+    edges.clear();
+    for (int i : covering) {
+      edges.push_back(entries.at(i).ptMin);
+      edges.push_back(entries.at(i).ptMax);
+    }
+    slab.ptEdges = SortedEdges(edges);
+    slab.pt.assign(slab.ptEdges.empty() ? 0 : slab.ptEdges.size()-1, PtSlab());
+    for (size_t ipt = 0; ipt < slab.pt.size(); ++ipt) {
+      PtSlab &cell = slab.pt.at(ipt);
+      std::vector<int> in_pt;
+      for (int i : covering) {
+        if (entries.at(i).ptMin <= slab.ptEdges.at(ipt)
+            && slab.ptEdges.at(ipt+1) <= entries.at(i).ptMax) {
+          in_pt.push_back(i);
         }
-      } else {
-        return e.func.Eval(pt);
       }
+      if (!use_discr) {
+        firstPerSys(in_pt, cell.first, [](const TmpEntry &) { return true; });
+        continue;
+      }
+      edges.clear();
+      for (int i : in_pt) {
+        edges.push_back(entries.at(i).discrMin);
+        edges.push_back(entries.at(i).discrMax);
+      }
+      cell.discrEdges = SortedEdges(edges);
+      for (size_t id = 0; id+1 < cell.discrEdges.size(); ++id) {
+        float lo = cell.discrEdges.at(id), hi = cell.discrEdges.at(id+1);
+        firstPerSys(in_pt, cell.first, [lo, hi](const TmpEntry &e) {
+            return e.discrMin <= lo && hi <= e.discrMax;
+          });
+      }
+    }
+
+    // min_max_pt: the first central entry always counts, later ones only if
+    // their discr range matches when reshaping
+    std::vector<int> central;
+    for (int i : covering) {
+      if (entries.at(i).sys == 0) central.push_back(i);
+    }
+    slab.firstMinMaxPt = std::make_pair(-1.f, -1.f);
+    if (central.empty()) continue;
+    const auto &front = entries.at(central.front());
+    slab.firstMinMaxPt = std::make_pair(front.ptMin, front.ptMax);
+    if (!use_discr) {
+      std::pair<float, float> mm = slab.firstMinMaxPt;
+      for (int i : central) {
+        mm.first = std::min(mm.first, entries.at(i).ptMin);
+        mm.second = std::max(mm.second, entries.at(i).ptMax);
+      }
+      slab.minMaxPt.push_back(mm);
+      continue;
+    }
+    edges.clear();
+    for (size_t k = 1; k < central.size(); ++k) {
+      edges.push_back(entries.at(central.at(k)).discrMin);
+      edges.push_back(entries.at(central.at(k)).discrMax);
+    }
+    slab.minMaxDiscrEdges = SortedEdges(edges);
+    for (size_t id = 0; id+1 < slab.minMaxDiscrEdges.size(); ++id) {
+      std::pair<float, float> mm = slab.firstMinMaxPt;
+      for (size_t k = 1; k < central.size(); ++k) {
+        const auto &e = entries.at(central.at(k));
+        if (e.discrMin <= slab.minMaxDiscrEdges.at(id)
+            && slab.minMaxDiscrEdges.at(id+1) <= e.discrMax) {
+          mm.first = std::min(mm.first, e.ptMin);
+          mm.second = std::max(mm.second, e.ptMax);
+        }
+      }
+      slab.minMaxPt.push_back(mm);
     }
   }
+}
 
-  return 0.;  // default value
+const BTagCalibrationReader::BTagCalibrationReaderImpl::EtaSlab *
+BTagCalibrationReader::BTagCalibrationReaderImpl::findEtaSlab(
+                                             const FlavorIndex & index,
+                                             float eta) const
+{
+  if (index.useAbsEta && eta < 0) {
+    eta = -eta;
+  }
+  int ieta = FindClosedOpen(index.etaEdges, eta);
+  return ieta < 0 ? nullptr : &index.eta[ieta];
+}
+
+std::pair<float, float> BTagCalibrationReader::BTagCalibrationReaderImpl::minMaxPt(
+                                             const EtaSlab * slab,
+                                             float discr) const
+{
+  if (slab == nullptr) return std::make_pair(-1.f, -1.f);
+  if (op_ != BTagEntry::OP_RESHAPING) {
+    return slab->minMaxPt.empty() ? slab->firstMinMaxPt : slab->minMaxPt.front();
+  }
+
+  int idiscr = FindClosedOpen(slab->minMaxDiscrEdges, discr);
+  return idiscr < 0 ? slab->firstMinMaxPt : slab->minMaxPt[idiscr];
+}
+
+// First entry of every sysType at (pt, discr) in the slab, or nullptr if
+// there is none for any sysType
+const int * BTagCalibrationReader::BTagCalibrationReaderImpl::findEntries(
+                                             const EtaSlab * slab,
+                                             float pt,
+                                             float discr) const
+{
+  // binary search through the pt and discr slabs built at load time
+  if (slab == nullptr) return nullptr;
+  int ipt = FindOpenClosed(slab->ptEdges, pt);
+  if (ipt < 0) return nullptr;
+  const PtSlab &cell = slab->pt[ipt];
+  int islab = 0;
+  if (op_ == BTagEntry::OP_RESHAPING) {                   // discr. reshaping?
+    islab = FindClosedOpen(cell.discrEdges, discr);
+    if (islab < 0) return nullptr;
+  }
+  return &cell.first[islab*sysTypes_.size()];
+}
+
+double BTagCalibrationReader::BTagCalibrationReaderImpl::evalEntry(
+                                             BTagEntry::JetFlavor jf,
+                                             int entry,
+                                             float pt,
+                                             float discr) const
+{
+  if (entry < 0) return 0.;  // default value
+  const auto &e = tmpData_[jf][entry];
+  return op_ == BTagEntry::OP_RESHAPING ? e.eval(discr) : e.eval(pt);
+}
+
+double BTagCalibrationReader::BTagCalibrationReaderImpl::eval(
+                                             BTagEntry::JetFlavor jf,
+                                             float eta,
+                                             float pt,
+                                             float discr) const
+{
+  const int *first = findEntries(findEtaSlab(index_[jf][0], eta), pt, discr);
+  return first == nullptr ? 0. : evalEntry(jf, first[0], pt, discr);
 }
 
 double BTagCalibrationReader::BTagCalibrationReaderImpl::eval_auto_bounds(
@@ -152,29 +469,69 @@ double BTagCalibrationReader::BTagCalibrationReaderImpl::eval_auto_bounds(
                                              float pt,
                                              float discr) const
 {
-  auto sf_bounds = min_max_pt(jf, eta, discr);
-  float pt_for_eval = pt;
-  bool is_out_of_bounds = false;
+  return eval_auto_bounds(sys_handle(sys), jf, eta, pt, discr);
+}
+
+int BTagCalibrationReader::BTagCalibrationReaderImpl::sys_handle(
+                                             const std::string & sys) const
+{
+  for (size_t i = 0; i < sysTypes_.size(); ++i) {
+    if (sysTypes_[i] == sys) {
+      return i;
+    }
+  }
+  ERROR(("BTagCalibrationReader: sysType not available (maybe not loaded?): "+sys));
+}
+
+// Eta slab of the point in the central sysType's index, with pt moved just
+// inside the central SF bounds when out of them
+const BTagCalibrationReader::BTagCalibrationReaderImpl::EtaSlab *
+BTagCalibrationReader::BTagCalibrationReaderImpl::autoBounds(
+                                             BTagEntry::JetFlavor jf,
+                                             float eta,
+                                             float & pt,
+                                             float discr,
+                                             bool & is_out_of_bounds) const
+{
+  const EtaSlab *slab = findEtaSlab(index_[jf][0], eta);
+  auto sf_bounds = minMaxPt(slab, discr);
+  is_out_of_bounds = false;
 
   if (pt <= sf_bounds.first) {
-    pt_for_eval = sf_bounds.first + .0001;
+    pt = sf_bounds.first + .0001;
     is_out_of_bounds = true;
   } else if (pt > sf_bounds.second) {
-    pt_for_eval = sf_bounds.second - .0001;
+    pt = sf_bounds.second - .0001;
     is_out_of_bounds = true;
   }
+  return slab;
+}
+
+double BTagCalibrationReader::BTagCalibrationReaderImpl::eval_auto_bounds(
+                                             int sys,
+                                             BTagEntry::JetFlavor jf,
+                                             float eta,
+                                             float pt,
+                                             float discr) const
+{
+  if (sys < 0 || static_cast<size_t>(sys) >= sysTypes_.size()) {
+    ERROR(("BTagCalibrationReader: invalid sys handle: "+std::to_string(sys)));
+  }
+  bool is_out_of_bounds;
+  const EtaSlab *slab = autoBounds(jf, eta, pt, discr, is_out_of_bounds);
+  const int *first = findEntries(slab, pt, discr);
 
   // get central SF (and maybe return)
-  double sf = eval(jf, eta, pt_for_eval, discr);
-  if (sys == sysType_) {
+  double sf = first == nullptr ? 0. : evalEntry(jf, first[0], pt, discr);
+  if (sys == 0) {
     return sf;
   }
 
   // get sys SF (and maybe return)
-  if (!otherSysTypeReaders_.count(sys)) {
-    ERROR(("BTagCalibrationReader: sysType not available (maybe not loaded?): "+sys));
+  if (etaGroup_[jf][sys] != 0) {
+    first = findEntries(findEtaSlab(index_[jf][1], eta), pt, discr);
   }
-  double sf_err = otherSysTypeReaders_.at(sys)->eval(jf, eta, pt_for_eval, discr);
+  double sf_err = first == nullptr ? 0. : evalEntry(jf, first[sys], pt, discr);
   if (!is_out_of_bounds) {
     return sf_err;
   }
@@ -184,41 +541,39 @@ double BTagCalibrationReader::BTagCalibrationReaderImpl::eval_auto_bounds(
   return sf_err;
 }
 
-std::pair<float, float> BTagCalibrationReader::BTagCalibrationReaderImpl::min_max_pt(
-                                               BTagEntry::JetFlavor jf,
-                                               float eta,
-                                               float discr) const
+bool BTagCalibrationReader::BTagCalibrationReaderImpl::eval_auto_bounds_all(
+                                             BTagEntry::JetFlavor jf,
+                                             float eta,
+                                             float pt,
+                                             float discr,
+                                             double * sfs) const
 {
-  bool use_discr = (op_ == BTagEntry::OP_RESHAPING);
-  if (useAbsEta_[jf] && eta < 0) {
-    eta = -eta;
+  bool is_out_of_bounds;
+  const EtaSlab *slab = autoBounds(jf, eta, pt, discr, is_out_of_bounds);
+  // Index: eta group
+  const int *first[2] = {findEntries(slab, pt, discr), nullptr};
+  if (index_[jf].size() > 1) {
+    first[1] = findEntries(findEtaSlab(index_[jf][1], eta), pt, discr);
   }
 
-  const auto &entries = tmpData_.at(jf);
-  float min_pt = -1., max_pt = -1.;
-  for (const auto & e: entries) {
-    if (
-      e.etaMin <= eta && eta < e.etaMax                   // find eta
-    ){
-      if (min_pt < 0.) {                                  // init
-        min_pt = e.ptMin;
-        max_pt = e.ptMax;
-        continue;
-      }
-
-      if (use_discr) {                                    // discr. reshaping?
-        if (e.discrMin <= discr && discr < e.discrMax) {  // check discr
-          min_pt = min_pt < e.ptMin ? min_pt : e.ptMin;
-          max_pt = max_pt > e.ptMax ? max_pt : e.ptMax;
-        }
-      } else {
-        min_pt = min_pt < e.ptMin ? min_pt : e.ptMin;
-        max_pt = max_pt > e.ptMax ? max_pt : e.ptMax;
-      }
+  for (size_t sys = 0; sys < sysTypes_.size(); ++sys) {
+    const int *row = first[etaGroup_[jf][sys]];
+    sfs[sys] = row == nullptr ? 0. : evalEntry(jf, row[sys], pt, discr);
+  }
+  if (is_out_of_bounds) {
+    for (size_t sys = 1; sys < sysTypes_.size(); ++sys) {
+      sfs[sys] = sfs[0] + 2*(sfs[sys] - sfs[0]);
     }
   }
+  return first[0] != nullptr;
+}
 
-  return std::make_pair(min_pt, max_pt);
+std::pair<float, float> BTagCalibrationReader::BTagCalibrationReaderImpl::min_max_pt(
+                                               BTagEntry::JetFlavor jf,
+                                               float eta,
+                                               float discr) const
+{
+  return minMaxPt(findEtaSlab(index_[jf][0], eta), discr);
 }
 
 
@@ -227,6 +582,11 @@ BTagCalibrationReader::BTagCalibrationReader(BTagEntry::OperatingPoint op,
                                              const std::vector<std::string> & otherSysTypes):
   pimpl(new BTagCalibrationReaderImpl(op, sysType, otherSysTypes)) {}
 
+void BTagCalibrationReader::setPtGrid(float step, double tolerance)
+{
+  pimpl->setPtGrid(step, tolerance);
+}
+
 void BTagCalibrationReader::load(const BTagCalibration & c,
                                  BTagEntry::JetFlavor jf,
                                  const std::string & measurementType)
@@ -251,6 +611,34 @@ double BTagCalibrationReader::eval_auto_bounds(const std::string & sys,
   return pimpl->eval_auto_bounds(sys, jf, eta, pt, discr);
 }
 
+int BTagCalibrationReader::sys_handle(const std::string & sys) const
+{
+  return pimpl->sys_handle(sys);
+}
+
+double BTagCalibrationReader::eval_auto_bounds(int sys,
+                                               BTagEntry::JetFlavor jf,
+                                               float eta,
+                                               float pt,
+                                               float discr) const
+{
+  return pimpl->eval_auto_bounds(sys, jf, eta, pt, discr);
+}
+
+std::size_t BTagCalibrationReader::num_sys_types() const
+{
+  return pimpl->sysTypes_.size();
+}
+
+bool BTagCalibrationReader::eval_auto_bounds_all(BTagEntry::JetFlavor jf,
+                                                 float eta,
+                                                 float pt,
+                                                 float discr,
+                                                 double * sfs) const
+{
+  return pimpl->eval_auto_bounds_all(jf, eta, pt, discr, sfs);
+}
+
 std::pair<float, float> BTagCalibrationReader::min_max_pt(BTagEntry::JetFlavor jf,
                                                           float eta,
                                                           float discr) const
@@ -2,9 +2,21 @@
 #include <sstream>
 
 #include "BTagEntry.hpp"
+#include "BTagFormula.hpp"
 
 #include "utilities.hpp"
 
+namespace {
+  // Only expressions BTagFormula cannot compile need a TF1 to be checked
+  bool formulaCompiles(const std::string &formula) {
+    if (BTagFormula(formula).isCompiled()) {
+      return true;
+    }
+    TF1 f1("", formula.c_str());
+    return !f1.IsZombie();
+  }
+}
+
 BTagEntry::Parameters::Parameters(
   OperatingPoint op,
   std::string measurement_type,
@@ -61,8 +73,7 @@ BTagEntry::BTagEntry(const std::string &csvLine)
 
   // make formula
   formula = vec[10];
-  TF1 f1("", formula.c_str());  // compile formula to check validity
-  if (f1.IsZombie()) {
+  if (!formulaCompiles(formula)) {
     ERROR(("BTagCalibration: Invalid csv line; formula does not compile: "+csvLine));
   }
 
@@ -93,8 +104,7 @@ BTagEntry::BTagEntry(const std::string &func, BTagEntry::Parameters p):
   formula(func),
   params(p)
 {
-  TF1 f1("", formula.c_str());  // compile formula to check validity
-  if (f1.IsZombie()) {
+  if (!formulaCompiles(formula)) {
     ERROR(("BTagCalibration: Invalid func string; formula does not compile: "+func));
   }
 }
@@ -196,8 +206,7 @@ BTagEntry::BTagEntry(const TH1* hist, BTagEntry::Parameters p):
   }
 
   // compile formula to check validity
-  TF1 f1("", formula.c_str());
-  if (f1.IsZombie()) {
+  if (!formulaCompiles(formula)) {
     ERROR(("BTagCalibration: Invalid histogram; formula does not compile (>150 bins?): "+std::string(hist->GetName())));
   }
 }
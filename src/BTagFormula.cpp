@@ -0,0 +1,471 @@
+#include "BTagFormula.hpp"
+
+#include <cctype>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+#include <algorithm>
+
+#include "utilities.hpp"
+
+// Recursive descent parser with C++ operator precedence, as TFormula hands
+// the expression to the interpreter as C++
+class BTagFormulaParser
+{
+public:
+  BTagFormulaParser(const std::string &expression,
+                    std::vector<BTagFormula::Node> &nodes):
+    s_(expression),
+    pos_(0),
+    nodes_(nodes)
+  {}
+
+  // Index of the root node, or -1 if the expression is outside the subset
+  int parse() {
+    int root = ternary();
+    skipSpace();
+    return pos_ == s_.size() ? root : -1;
+  }
+
+private:
+  int node(BTagFormula::OpCode op, double value, int a=-1, int b=-1, int c=-1) {
+    BTagFormula::Node n;
+    n.op = op;
+    n.value = value;
+    n.arg[0] = a;
+    n.arg[1] = b;
+    n.arg[2] = c;
+    nodes_.push_back(n);
+    return nodes_.size()-1;
+  }
+
+  void skipSpace() {
+    while (pos_ < s_.size() && isspace(static_cast<unsigned char>(s_[pos_]))) ++pos_;
+  }
+
+  bool accept(const char *token) {
+    skipSpace();
+    size_t len = strlen(token);
+    if (s_.compare(pos_, len, token) != 0) return false;
+    pos_ += len;
+    return true;
+  }
+
+  int ternary() {
+    int cond = equality();
+    if (cond < 0 || !accept("?")) return cond;
+    int a = ternary();
+    if (a < 0 || !accept(":")) return -1;
+    int b = ternary();
+    if (b < 0) return -1;
+    return node(BTagFormula::kSelect, 0., cond, a, b);
+  }
+
+  int equality() {
+    int a = relational();
+    while (a >= 0) {
+      BTagFormula::OpCode op;
+      if (accept("==")) op = BTagFormula::kEqual;
+      else if (accept("!=")) op = BTagFormula::kNotEqual;
+      else break;
+      int b = relational();
+      a = b < 0 ? -1 : node(op, 0., a, b);
+    }
+    return a;
+  }
+
+  int relational() {
+    int a = additive();
+    while (a >= 0) {
+      BTagFormula::OpCode op;
+      if (accept("<=")) op = BTagFormula::kLessEq;
+      else if (accept(">=")) op = BTagFormula::kGreaterEq;
+      else if (accept("<")) op = BTagFormula::kLess;
+      else if (accept(">")) op = BTagFormula::kGreater;
+      else break;
+      int b = additive();
+      a = b < 0 ? -1 : node(op, 0., a, b);
+    }
+    return a;
+  }
+
+  int additive() {
+    int a = multiplicative();
+    while (a >= 0) {
+      BTagFormula::OpCode op;
+      if (accept("+")) op = BTagFormula::kAdd;
+      else if (accept("-")) op = BTagFormula::kSub;
+      else break;
+      int b = multiplicative();
+      a = b < 0 ? -1 : node(op, 0., a, b);
+    }
+    return a;
+  }
+
+  int multiplicative() {
+    int a = unary();
+    while (a >= 0) {
+      BTagFormula::OpCode op;
+      if (accept("*")) op = BTagFormula::kMul;
+      else if (accept("/")) op = BTagFormula::kDiv;
+      else break;
+      int b = unary();
+      a = b < 0 ? -1 : node(op, 0., a, b);
+    }
+    return a;
+  }
+
+  int unary() {
+    if (accept("-")) {
+      int a = unary();
+      return a < 0 ? -1 : node(BTagFormula::kNeg, 0., a);
+    }
+    if (accept("+")) return unary();
+    return primary();
+  }
+
+  int primary() {
+    skipSpace();
+    if (pos_ >= s_.size()) return -1;
+    if (accept("(")) {
+      int a = ternary();
+      return (a >= 0 && accept(")")) ? a : -1;
+    }
+    char c = s_[pos_];
+    if (isdigit(static_cast<unsigned char>(c)) || c == '.') return number();
+    if (!isalpha(static_cast<unsigned char>(c)) && c != '_') return -1;
+
+    size_t begin = pos_;
+    while (pos_ < s_.size()
+           && (isalnum(static_cast<unsigned char>(s_[pos_])) || s_[pos_] == '_')) ++pos_;
+    std::string name = s_.substr(begin, pos_-begin);
+    if (name == "x") return node(BTagFormula::kX, 0.);
+
+    BTagFormula::OpCode op;
+    int nargs = 1;
+    if (name == "log") op = BTagFormula::kLog;
+    else if (name == "exp") op = BTagFormula::kExp;
+    else if (name == "sqrt") op = BTagFormula::kSqrt;
+    else if (name == "pow") { op = BTagFormula::kPow; nargs = 2; }
+    else return -1;
+    if (!accept("(")) return -1;
+    int a = ternary();
+    if (a < 0) return -1;
+    int b = -1;
+    if (nargs == 2) {
+      if (!accept(",")) return -1;
+      b = ternary();
+      if (b < 0) return -1;
+    }
+    if (!accept(")")) return -1;
+    return node(op, 0., a, b);
+  }
+
+  // Digits with an optional fraction and exponent; strtod alone would also
+  // take hex, inf and nan
+  int number() {
+    size_t begin = pos_;
+    while (pos_ < s_.size() && isdigit(static_cast<unsigned char>(s_[pos_]))) ++pos_;
+    if (pos_ < s_.size() && s_[pos_] == '.') ++pos_;
+    while (pos_ < s_.size() && isdigit(static_cast<unsigned char>(s_[pos_]))) ++pos_;
+    if (pos_ < s_.size() && (s_[pos_] == 'e' || s_[pos_] == 'E')) {
+      size_t mantissa_end = pos_++;
+      if (pos_ < s_.size() && (s_[pos_] == '+' || s_[pos_] == '-')) ++pos_;
+      if (pos_ < s_.size() && isdigit(static_cast<unsigned char>(s_[pos_]))) {
+        while (pos_ < s_.size() && isdigit(static_cast<unsigned char>(s_[pos_]))) ++pos_;
+      } else {
+        pos_ = mantissa_end;
+      }
+    }
+    std::string text = s_.substr(begin, pos_-begin);
+    if (text == ".") return -1;
+    return node(BTagFormula::kConst, strtod(text.c_str(), nullptr));
+  }
+
+  const std::string &s_;
+  size_t pos_;
+  std::vector<BTagFormula::Node> &nodes_;
+};
+
+BTagFormula::BTagFormula():
+  nodes_(),
+  root_(-1),
+  code_(),
+  native_(nullptr),
+  usesX_(false)
+{}
+
+BTagFormula::BTagFormula(const std::string &expression,
+                         NativeFunction native):
+  nodes_(),
+  root_(-1),
+  code_(),
+  native_(nullptr),
+  usesX_(false)
+{
+  int root = BTagFormulaParser(expression, nodes_).parse();
+  if (root < 0) {
+    nodes_.clear();
+    return;
+  }
+  fold(root);
+  if (emit(root) > kMaxDepth) {
+    nodes_.clear();
+    code_.clear();
+    return;
+  }
+  root_ = root;
+  native_ = native;
+  for (const auto &in : code_) {
+    if (in.op == kX || in.op == kJumpUnlessXLess) usesX_ = true;
+  }
+}
+
+bool BTagFormula::isCompiled() const
+{
+  return root_ >= 0;
+}
+
+bool BTagFormula::usesX() const
+{
+  return usesX_;
+}
+
+double BTagFormula::eval(double x) const
+{
+  if (native_ != nullptr) return native_(x);
+  if (code_.empty()) {
+    ERROR("BTagFormula: evaluating a formula that did not compile");
+  }
+
+  double stack[kMaxDepth];
+  int top = -1;
+  size_t pc = 0;
+  const size_t end = code_.size();
+  while (pc < end) {
+    const Instruction &in = code_[pc++];
+    switch (in.op) {
+    case kConst:
+      stack[++top] = in.value;
+      break;
+    case kX:
+      stack[++top] = x;
+      break;
+    case kNeg:
+    case kLog:
+    case kExp:
+    case kSqrt:
+      stack[top] = apply(in.op, stack[top], 0.);
+      break;
+    case kAdd:
+      --top;
+      stack[top] = stack[top] + stack[top+1];
+      break;
+    case kSub:
+      --top;
+      stack[top] = stack[top] - stack[top+1];
+      break;
+    case kMul:
+      --top;
+      stack[top] = stack[top] * stack[top+1];
+      break;
+    case kDiv:
+      --top;
+      stack[top] = stack[top] / stack[top+1];
+      break;
+    case kPow:
+    case kLess:
+    case kGreater:
+    case kLessEq:
+    case kGreaterEq:
+    case kEqual:
+    case kNotEqual:
+      --top;
+      stack[top] = apply(in.op, stack[top], stack[top+1]);
+      break;
+    case kJump:
+      pc = in.target;
+      break;
+    case kJumpUnless:
+      if (stack[top--] == 0.) pc = in.target;
+      break;
+    case kJumpUnlessXLess:
+      if (!(x < in.value)) pc = in.target;
+      break;
+    case kSelect:
+    default:
+      ERROR("BTagFormula: invalid instruction");
+    }
+  }
+  return stack[0];
+}
+
+std::string BTagFormula::toCpp() const
+{
+  if (!isCompiled()) return "";
+  bool finite = true;
+  std::string cpp = toCpp(root_, finite);
+  return finite ? cpp : "";
+}
+
+double BTagFormula::apply(OpCode op, double a, double b)
+{
+  switch (op) {
+  case kNeg:       return -a;
+  case kLog:       return std::log(a);
+  case kExp:       return std::exp(a);
+  case kSqrt:      return std::sqrt(a);
+  case kAdd:       return a + b;
+  case kSub:       return a - b;
+  case kMul:       return a * b;
+  case kDiv:       return a / b;
+  case kPow:       return std::pow(a, b);
+  case kLess:      return a < b;
+  case kGreater:   return a > b;
+  case kLessEq:    return a <= b;
+  case kGreaterEq: return a >= b;
+  case kEqual:     return a == b;
+  case kNotEqual:  return a != b;
+  case kConst:
+  case kX:
+  case kSelect:
+  case kJump:
+  case kJumpUnless:
+  case kJumpUnlessXLess:
+  default:
+    ERROR("BTagFormula: not an arithmetic operation");
+  }
+}
+
+// Replaces constant subexpressions by their value, evaluated in the same
+// order and precision as at run time
+void BTagFormula::fold(int node)
+{
+  Node &n = nodes_[node];
+  if (n.op == kConst || n.op == kX) return;
+  for (int i = 0; i < 3; ++i) {
+    if (n.arg[i] >= 0) fold(n.arg[i]);
+  }
+  const Node &a = nodes_[n.arg[0]];
+  if (n.op == kSelect) {
+    if (a.op == kConst) nodes_[node] = nodes_[a.value != 0. ? n.arg[1] : n.arg[2]];
+    return;
+  }
+  if (a.op != kConst) return;
+  if (n.arg[1] >= 0 && nodes_[n.arg[1]].op != kConst) return;
+  double value = apply(n.op, a.value, n.arg[1] >= 0 ? nodes_[n.arg[1]].value : 0.);
+  n.op = kConst;
+  n.value = value;
+  n.arg[0] = n.arg[1] = n.arg[2] = -1;
+}
+
+// Appends the bytecode of a node, returning the stack depth it needs
+int BTagFormula::emit(int node)
+{
+  const Node n = nodes_[node];
+  Instruction in;
+  in.op = n.op;
+  in.value = n.value;
+  in.target = -1;
+
+  switch (n.op) {
+  case kConst:
+  case kX:
+    code_.push_back(in);
+    return 1;
+  case kNeg:
+  case kLog:
+  case kExp:
+  case kSqrt: {
+    int depth = emit(n.arg[0]);
+    code_.push_back(in);
+    return depth;
+  }
+  case kAdd:
+  case kSub:
+  case kMul:
+  case kDiv:
+  case kPow:
+  case kLess:
+  case kGreater:
+  case kLessEq:
+  case kGreaterEq:
+  case kEqual:
+  case kNotEqual: {
+    int depth_a = emit(n.arg[0]);
+    int depth_b = emit(n.arg[1]);
+    code_.push_back(in);
+    return std::max(depth_a, depth_b+1);
+  }
+  case kSelect: {
+    // "x<c ? a : b" is the bulk of the binned formulas: test it in one go
+    const Node &cond = nodes_[n.arg[0]];
+    int depth = 0;
+    if (cond.op == kLess && nodes_[cond.arg[0]].op == kX && nodes_[cond.arg[1]].op == kConst) {
+      in.op = kJumpUnlessXLess;
+      in.value = nodes_[cond.arg[1]].value;
+    } else {
+      depth = emit(n.arg[0]);
+      in.op = kJumpUnless;
+    }
+    size_t jump_else = code_.size();
+    code_.push_back(in);
+    depth = std::max(depth, emit(n.arg[1]));
+    in.op = kJump;
+    size_t jump_end = code_.size();
+    code_.push_back(in);
+    code_[jump_else].target = code_.size();
+    depth = std::max(depth, emit(n.arg[2]));
+    code_[jump_end].target = code_.size();
+    return depth;
+  }
+  case kJump:
+  case kJumpUnless:
+  case kJumpUnlessXLess:
+  default:
+    ERROR("BTagFormula: invalid syntax tree");
+  }
+}
+
+std::string BTagFormula::toCpp(int node, bool &finite) const
+{
+  const Node &n = nodes_[node];
+  switch (n.op) {
+  case kConst: {
+    if (!std::isfinite(n.value)) {
+      finite = false;
+      return "0.";
+    }
+    char buff[40];
+    snprintf(buff, sizeof(buff), "%.17g", n.value);
+    std::string text = buff;
+    if (text.find_first_of(".e") == std::string::npos) text += ".";
+    return n.value < 0. ? "("+text+")" : text;
+  }
+  case kX:         return "x";
+  case kNeg:       return "(-"+toCpp(n.arg[0], finite)+")";
+  case kLog:       return "std::log("+toCpp(n.arg[0], finite)+")";
+  case kExp:       return "std::exp("+toCpp(n.arg[0], finite)+")";
+  case kSqrt:      return "std::sqrt("+toCpp(n.arg[0], finite)+")";
+  case kPow:       return "std::pow("+toCpp(n.arg[0], finite)+", "+toCpp(n.arg[1], finite)+")";
+  case kAdd:       return "("+toCpp(n.arg[0], finite)+"+"+toCpp(n.arg[1], finite)+")";
+  case kSub:       return "("+toCpp(n.arg[0], finite)+"-"+toCpp(n.arg[1], finite)+")";
+  case kMul:       return "("+toCpp(n.arg[0], finite)+"*"+toCpp(n.arg[1], finite)+")";
+  case kDiv:       return "("+toCpp(n.arg[0], finite)+"/"+toCpp(n.arg[1], finite)+")";
+  case kLess:      return "("+toCpp(n.arg[0], finite)+"<"+toCpp(n.arg[1], finite)+")";
+  case kGreater:   return "("+toCpp(n.arg[0], finite)+">"+toCpp(n.arg[1], finite)+")";
+  case kLessEq:    return "("+toCpp(n.arg[0], finite)+"<="+toCpp(n.arg[1], finite)+")";
+  case kGreaterEq: return "("+toCpp(n.arg[0], finite)+">="+toCpp(n.arg[1], finite)+")";
+  case kEqual:     return "("+toCpp(n.arg[0], finite)+"=="+toCpp(n.arg[1], finite)+")";
+  case kNotEqual:  return "("+toCpp(n.arg[0], finite)+"!="+toCpp(n.arg[1], finite)+")";
+  case kSelect:
+    return "("+toCpp(n.arg[0], finite)+" ? "+toCpp(n.arg[1], finite)+" : "+toCpp(n.arg[2], finite)+")";
+  case kJump:
+  case kJumpUnless:
+  case kJumpUnlessXLess:
+  default:
+    ERROR("BTagFormula: invalid syntax tree");
+  }
+}
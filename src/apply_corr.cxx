@@ -1,14 +1,19 @@
 #include <iostream>
 #include <ctime>
+#include <thread>
+#include <memory>
+#include <exception>
 #include <getopt.h>
 
 #include "baby_plus.hpp"
 #include "baby_corr.hpp"
 #include "utilities.hpp"
+#include "corrections.hpp"
 #include "hig_utils.hpp"
-#include "cross_sections.hpp"
+#include "corr_server.hpp"
 
 #include "TError.h"
+#include "TROOT.h"
 
 using namespace std;
 
@@ -17,135 +22,138 @@ namespace {
   string infile = "/net/cms29/cms29r0/babymaker/babies/2017_01_27/mc/unprocessed/fullbaby_TTJets_TuneCUETP8M1_13TeV-madgraphMLM-pythia8_RunIISpring16MiniAODv2-PUSpring16_80X_mcRun2_asymptotic_2016_miniAODv2_v0-v1_60.root";
   string outfile = "test.root";
   bool quick = false;
+  bool fast_clone = false;
+  bool delta = false;
+  string deltafile = "";
+  unsigned threads = 1;
+  string weight_cache = "";
+  string serve_socket = "";
+  unsigned server_workers = thread::hardware_concurrency();
 }
 
 void GetOptions(int argc, char *argv[]);
+int ApplyCorr();
+void LoadCorrections(baby_corr &c, bool verbose);
+void ProcessRange(baby_plus &b, baby_corr &c, const WeightCache *cache, bool isSignal, long first, long last);
 
 int main(int argc, char *argv[]){
   // gErrorIgnoreLevel=6000; // Turns off ROOT errors due to missing branches       
   GetOptions(argc, argv);
+  if(serve_socket == "") return ApplyCorr();
+
+  // Workers start with the trigger efficiencies ApplyEntry reads
+  hig_utils::HigTrigCorrection();
+  // Jobs start from the options the server was given
+  RunServer(serve_socket, server_workers, [](const vector<string> &args){
+      return RunWithArgs(args, [](int job_argc, char *job_argv[]){
+          serve_socket = "";
+          GetOptions(job_argc, job_argv);
+          if(serve_socket != "") ERROR("Option --serve is not valid in a job");
+          return ApplyCorr();
+        });
+    });
+}
 
+int ApplyCorr(){
   time_t begtime, endtime;
   time(&begtime);
 
+  if(fast_clone && delta) ERROR("Options --fast_clone and --delta are exclusive");
+  if(fast_clone && threads > 1) ERROR("Option --fast_clone clones every entry and cannot be split in --threads");
+  baby_plus::OutputMode mode = baby_plus::kFullCopy;
+  if(fast_clone) mode = baby_plus::kFastClone;
+  else if(delta) mode = baby_plus::kDelta;
+
   cout<<"Input file: "<<infile<<endl;
-  baby_plus b(infile, outfile);
-  long nent = b.GetEntries();
+  // Signal files are recognized by the type of their first entry, as the
+  // serial loop did; found once here so that every range uses the same flag
+  bool isSignal = false;
+  long nent = 0;
+  {
+    baby_plus probe(infile);
+    nent = probe.GetEntries();
+    if(nent > 0){
+      probe.GetEntry(0);
+      if(probe.type()>100e3) isSignal = true;
+    }
+  }
   cout<<"Running over "<<nent<<" events."<<endl;
+  if(deltafile != "") cout<<"Delta file: "<<deltafile<<endl;
+  unique_ptr<WeightCache> cache;
+  if(weight_cache != ""){
+    cout<<"Weight cache: "<<weight_cache<<endl;
+    cache.reset(new WeightCache(weight_cache));
+    corrections::CheckCache(*cache, nent);
+  }
 
   cout<<"Corr. file: "<<corrfile<<endl;
-  baby_corr c(corrfile);
+  if(threads <= 1){
+    baby_plus b(infile, outfile, mode, corrections::apply_branches);
+    if(deltafile != "") b.AddDelta(deltafile);
+    baby_corr c(corrfile);
+    LoadCorrections(c, true);
+    ProcessRange(b, c, cache.get(), isSignal, 0, nent);
+    b.Write();
+  }else{
+    // Each worker reads its own range and writes it to a part file, which are
+    // merged back in entry order
+    ROOT::EnableThreadSafety();
+    vector<pair<long, long> > ranges = SplitRange(nent, threads);
+    cout<<"Splitting into "<<ranges.size()<<" threads."<<endl;
+    vector<string> parts;
+    vector<exception_ptr> errors(ranges.size());
+    vector<thread> workers;
+    for(size_t i = 0; i < ranges.size(); ++i) parts.push_back(PartFileName(outfile, i));
+    for(size_t i = 0; i < ranges.size(); ++i){
+      workers.push_back(thread([&, i](){
+        try{
+          baby_plus b(infile, parts.at(i), mode, corrections::apply_branches);
+          if(deltafile != "") b.AddDelta(deltafile);
+          baby_corr c(corrfile);
+          LoadCorrections(c, i == 0);
+          ProcessRange(b, c, cache.get(), isSignal, ranges.at(i).first, ranges.at(i).second);
+          b.Write();
+        }catch(...){
+          errors.at(i) = current_exception();
+        }
+      }));
+    }
+    for(auto &worker: workers) worker.join();
+    for(const auto &error: errors){
+      if(error) rethrow_exception(error);
+    }
+    MergeParts(parts, outfile);
+  }
+
+  cout<<endl;
+  time(&endtime); 
+  cout<<"Time passed: "<<hoursMinSec(difftime(endtime, begtime))<<endl<<endl;  
+  return 0;
+}
+
+void LoadCorrections(baby_corr &c, bool verbose){
   if (c.GetEntries()==1) {
-    cout<<"Correction file OK."<<endl;
+    if (verbose) cout<<"Correction file OK."<<endl;
     c.GetEntry(0);
   } else {
-    cout<<"No entries in the corrections files."<<endl;
+    if (verbose) cout<<"No entries in the corrections files."<<endl;
   }
+}
 
-  bool isSignal = false;
-  for(long entry(0); entry<nent; entry++){
-    if (b.type()>100e3) isSignal = true;
-
+void ProcessRange(baby_plus &b, baby_corr &c, const WeightCache *cache, bool isSignal, long first, long last){
+  // The weight cache always has the shape b-tag weight columns
+  const bool has_shape_b_wgt = cache || corrections::HasShapeBTag(b);
+  for(long entry(first); entry<last; entry++){
     b.GetEntry(entry);
     if (entry%100000==0) {
       cout<<"Processing event: "<<entry<<endl;
     }
 
-    if (b.type() == 106e3) { // TCHiHH
-      // trigger efficiency and uncertainty
-      b.out_eff_trig() = hig_utils::eff_higtrig(b);
-      float effunc = hig_utils::effunc_higtrig(b);
-      b.out_sys_trig();
-      b.out_sys_trig().at(0) = 1+effunc;
-      b.out_sys_trig().at(1) = 1-effunc;
-      // fix mass point branch
-      b.out_mgluino() = hig_utils::mchi(b);
-    }
-
-    b.out_baseline() = b.pass_ra2_badmu() && b.met()/b.met_calo()<5
-                       && b.nleps()==1 && b.nveto()==0 && b.met()>200
-                       && b.st()>500 && b.njets()>=6 && b.nbm()>=1;
-    if (!isSignal) b.out_baseline() = b.out_baseline() && b.pass();
-
-    if(b.nleps()==0) { // load from calculated correction
-      b.out_w_lep()         = c.w_lep();
-      b.out_w_fs_lep()      = c.w_fs_lep();
-      for (unsigned i(0); i<b.sys_lep().size(); i++) 
-        b.out_sys_lep()[i] = c.sys_lep()[i];
-      for (unsigned i(0); i<b.sys_fs_lep().size(); i++) 
-        b.out_sys_fs_lep()[i] = c.sys_fs_lep()[i];
-    } else { //load from original tree
-      b.out_w_lep()         = b.w_lep();
-      b.out_w_fs_lep()      = b.w_fs_lep();
-      for (unsigned i(0); i<b.sys_lep().size(); i++) 
-        b.out_sys_lep()[i] = b.sys_lep()[i];
-      for (unsigned i(0); i<b.sys_fs_lep().size(); i++) 
-        b.out_sys_fs_lep()[i] = b.sys_fs_lep()[i];
-    }
-
-    b.out_w_lumi() = b.w_lumi()>0 ? 1. : -1.;
-    b.out_w_lumi() *= c.w_lumi();
-
-    b.out_weight() = c.weight() *b.out_w_lumi() 
-                     *b.out_w_lep() *b.out_w_fs_lep() //post-corr values in order for 0l to be correct
-                     *b.w_btag_deep() *b.w_isr() *b.eff_jetid() *b.w_pu();
-    
-    b.out_w_isr() = c.w_isr()*b.w_isr();
-    for (unsigned i(0); i<b.sys_isr().size(); i++) 
-      b.out_sys_isr()[i] = c.sys_isr()[i]*b.sys_isr()[i];
-
-    //      Cookie-cutter variables
-    //-----------------------------------
-    b.out_w_pu()                   *= c.w_pu();
-    b.out_w_btag_deep()            *= c.w_btag_deep();
-
-    b.out_w_bhig_deep()            *= c.w_bhig_deep();
-    
-    for (unsigned i(0); i<2; i++) {
-      b.out_sys_bctag_deep()[i]              *= c.sys_bctag_deep()[i];
-      b.out_sys_udsgtag_deep()[i]            *= c.sys_udsgtag_deep()[i];
-        
-      b.out_sys_bchig_deep()[i]              *= c.sys_bchig_deep()[i];
-      b.out_sys_udsghig_deep()[i]            *= c.sys_udsghig_deep()[i];
-
-      if (isSignal) { // yes, this ignores the fullsim points
-        b.out_sys_mur()[i]                     *= c.sys_mur()[i];
-        b.out_sys_muf()[i]                     *= c.sys_muf()[i];
-        b.out_sys_murf()[i]                    *= c.sys_murf()[i];
-
-        b.out_sys_fs_bctag_deep()[i]         *= c.sys_fs_bctag_deep()[i];
-        b.out_sys_fs_udsgtag_deep()[i]       *= c.sys_fs_udsgtag_deep()[i];
-        b.out_sys_fs_bchig_deep()[i]         *= c.sys_fs_bchig_deep()[i];
-        b.out_sys_fs_udsghig_deep()[i]       *= c.sys_fs_udsghig_deep()[i];
-      }
-    }
-
-    if (!quick) {
-      b.out_w_btag_loose_deep()      *= c.w_btag_loose_deep();
-      b.out_w_btag_tight_deep()      *= c.w_btag_tight_deep();
-
-      for (unsigned i(0); i<b.w_pdf().size(); i++) b.out_w_pdf()[i] *= c.w_pdf()[i];
-
-      for (unsigned i(0); i<b.sys_mur().size(); i++) {
-        b.out_sys_pu()[i]                      *= c.sys_pu()[i];
-        // b.out_sys_pdf()[i]                     *= c.sys_pdf()[i];
-
-        b.out_sys_bctag_loose_deep()[i]        *= c.sys_bctag_loose_deep()[i];
-        b.out_sys_udsgtag_loose_deep()[i]      *= c.sys_udsgtag_loose_deep()[i];
-        b.out_sys_bctag_tight_deep()[i]        *= c.sys_bctag_tight_deep()[i];
-        b.out_sys_udsgtag_tight_deep()[i]      *= c.sys_udsgtag_tight_deep()[i];
-      } // loop over 2 sys
-    } // if quick
-    
+    if (cache) corrections::ReadCache(*cache, b, entry);
+    corrections::ApplyEntry(b, c, isSignal, quick, has_shape_b_wgt);
     b.Fill();
 
   } // loop over events
-  
-  b.Write();
-
-  cout<<endl;
-  time(&endtime); 
-  cout<<"Time passed: "<<hoursMinSec(difftime(endtime, begtime))<<endl<<endl;  
 }
 
 void GetOptions(int argc, char *argv[]){
@@ -155,12 +163,19 @@ void GetOptions(int argc, char *argv[]){
       {"corrfile", required_argument, 0, 'c'},       // Apply correction
       {"outfile", required_argument, 0, 'o'},    // Luminosity to normalize MC with (no data)
       {"quick", no_argument, 0, 0},  
+      {"fast_clone", no_argument, 0, 0},  // Copy untouched branches without decompressing them
+      {"delta", no_argument, 0, 0},       // Write only modified branches, to be read as a friend of the input
+      {"deltafile", required_argument, 0, 'd'}, // Output of calc_corr --delta for this input
+      {"threads", required_argument, 0, 't'},   // Number of threads over which to split the events
+      {"weight_cache", required_argument, 0, 'w'}, // Take the per-event weights from calc_corr --weight_cache
+      {"serve", required_argument, 0, 0},       // Run jobs sent to this Unix socket by python/corr_client.py
+      {"workers", required_argument, 0, 0},     // Maximum number of jobs the server runs at once
       {0, 0, 0, 0}
     };
 
     char opt = -1;
     int option_index;
-    opt = getopt_long(argc, argv, "qi:c:o:", long_options, &option_index);
+    opt = getopt_long(argc, argv, "qi:c:o:d:t:w:", long_options, &option_index);
     if(opt == -1) break;
 
     string optname;
@@ -174,10 +189,27 @@ void GetOptions(int argc, char *argv[]){
     case 'o':
       outfile = optarg;
       break;
+    case 'd':
+      deltafile = optarg;
+      break;
+    case 't':
+      threads = atoi(optarg);
+      break;
+    case 'w':
+      weight_cache = optarg;
+      break;
     case 0:
       optname = long_options[option_index].name;
       if(optname == "quick"){
         quick = true;
+      }else if(optname == "fast_clone"){
+        fast_clone = true;
+      }else if(optname == "delta"){
+        delta = true;
+      }else if(optname == "serve"){
+        serve_socket = optarg;
+      }else if(optname == "workers"){
+        server_workers = atoi(optarg);
       }else{
         printf("Bad option! Found option name %s\n", optname.c_str());
         exit(1);
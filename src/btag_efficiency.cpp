@@ -0,0 +1,83 @@
+//----------------------------------------------------------------------------
+// btag_efficiency - MC b-tag efficiencies flattened out of TH3D histograms
+//----------------------------------------------------------------------------
+
+#include "btag_efficiency.hpp"
+
+#include <cstdlib>
+
+#include <string>
+
+#include "TH3D.h"
+
+#include "utilities.hpp"
+
+using namespace std;
+
+BTagEfficiencyTable::BTagEfficiencyTable(const vector<const TH3D*> &hists):
+  tables_(),
+  content_(){
+  for(const TH3D *hist: hists){
+    if(hist == nullptr) ERROR("Missing b-tag efficiency histogram");
+    AddTable(HistAxis(*hist->GetXaxis()), HistAxis(*hist->GetYaxis()), HistAxis(*hist->GetZaxis()),
+             [hist](int ix, int iy, int iz){return hist->GetBinContent(ix, iy, iz);});
+  }
+}
+
+BTagEfficiencyTable::BTagEfficiencyTable(const vector<CalibBundle::Hist> &hists):
+  tables_(),
+  content_(){
+  for(const auto &hist: hists){
+    if(hist.ndim != 3) ERROR("Bundled b-tag efficiency is not a 3D histogram");
+    const int nx = hist.axes[0].nbins+2, ny = hist.axes[1].nbins+2;
+    AddTable(HistAxis(hist.axes[0]), HistAxis(hist.axes[1]), HistAxis(hist.axes[2]),
+             [&hist, nx, ny](int ix, int iy, int iz){return hist.content[ix+nx*(iy+ny*iz)];});
+  }
+}
+
+void BTagEfficiencyTable::AddTable(const HistAxis &eta, const HistAxis &pt, const HistAxis &flavor,
+                                   const function<double(int, int, int)> &content){
+  const int flavors[kNumFlavorClasses] = {0, 4, 5};
+  Table table;
+  table.eta = eta;
+  table.pt = pt;
+  table.offset = content_.size();
+  for(int ifl: flavors){
+    int iz = flavor.Bin(ifl);
+    for(int ix = 0; ix < table.eta.Size(); ++ix){
+      for(int iy = 0; iy < table.pt.Size(); ++iy){
+        content_.push_back(content(ix, iy, iz));
+      }
+    }
+  }
+  tables_.push_back(table);
+}
+
+BTagEfficiencyTable::FlavorClass BTagEfficiencyTable::GetFlavorClass(int hadron_flavor){
+  // In the ghost clustering scheme to determine flavor, there are only b, c and other (id=0) flavors
+  hadron_flavor = abs(hadron_flavor);
+  return hadron_flavor == 5 ? kB : (hadron_flavor == 4 ? kC : kUDSG);
+}
+
+size_t BTagEfficiencyTable::NumOps() const{
+  return tables_.size();
+}
+
+size_t BTagEfficiencyTable::Index(const Table &table, FlavorClass flavor, double abs_eta, double pt) const{
+  return table.offset
+    + (static_cast<size_t>(flavor)*table.eta.Size() + table.eta.Bin(abs_eta))*table.pt.Size()
+    + table.pt.Bin(pt);
+}
+
+float BTagEfficiencyTable::Efficiency(size_t iop, FlavorClass flavor, double abs_eta, double pt) const{
+  return content_[Index(tables_.at(iop), flavor, abs_eta, pt)];
+}
+
+void BTagEfficiencyTable::Efficiencies(size_t iop, size_t n, const FlavorClass *flavor,
+                                       const float *abs_eta, const float *pt, float *eff) const{
+  const Table &table = tables_.at(iop);
+  const float *content = content_.data();
+  for(size_t i = 0; i < n; ++i){
+    eff[i] = content[Index(table, flavor[i], abs_eta[i], pt[i])];
+  }
+}
@@ -0,0 +1,151 @@
+//----------------------------------------------------------------------------
+// btag_jet_weight - Per-jet b-tag weight formula over arrays of jets
+//----------------------------------------------------------------------------
+
+#include "btag_jet_weight.hpp"
+
+#include <cmath>
+
+#include <limits>
+
+#include "utilities.hpp"
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define BTAG_JET_WEIGHT_X86
+#include <immintrin.h>
+#endif
+
+using namespace std;
+
+namespace{
+  typedef size_t (*Kernel)(size_t n,
+                           const double *eff1, const double *eff2,
+                           const double *sf1, const double *sf2,
+                           const double *sf1_fs, const double *sf2_fs,
+                           double *result);
+
+  size_t JetWeightsScalar(size_t n,
+                          const double *eff1, const double *eff2,
+                          const double *sf1, const double *sf2,
+                          const double *sf1_fs, const double *sf2_fs,
+                          double *result){
+    size_t nfallback = 0;
+    for(size_t i = 0; i < n; ++i){
+      double eff1_fs(eff1[i]/sf1_fs[i]), eff2_fs(eff2[i]/sf2_fs[i]);
+      double r = (sf1[i]*sf1_fs[i]*eff1_fs-sf2[i]*sf2_fs[i]*eff2_fs)/(eff1_fs-eff2_fs);
+      if(std::isnan(r) || std::isinf(r)){
+        r = 1.;
+        ++nfallback;
+      }
+      result[i] = r;
+    }
+    return nfallback;
+  }
+
+#ifdef BTAG_JET_WEIGHT_X86
+  __attribute__((target("avx2")))
+  size_t JetWeightsAVX2(size_t n,
+                        const double *eff1, const double *eff2,
+                        const double *sf1, const double *sf2,
+                        const double *sf1_fs, const double *sf2_fs,
+                        double *result){
+    const __m256d one = _mm256_set1_pd(1.);
+    const __m256d inf = _mm256_set1_pd(numeric_limits<double>::infinity());
+    const __m256d sign = _mm256_set1_pd(-0.);
+    size_t nfallback = 0;
+    size_t i = 0;
+    for(; i+4 <= n; i += 4){
+      __m256d s1_fs = _mm256_loadu_pd(sf1_fs+i), s2_fs = _mm256_loadu_pd(sf2_fs+i);
+      __m256d e1_fs = _mm256_div_pd(_mm256_loadu_pd(eff1+i), s1_fs);
+      __m256d e2_fs = _mm256_div_pd(_mm256_loadu_pd(eff2+i), s2_fs);
+      __m256d num = _mm256_sub_pd(_mm256_mul_pd(_mm256_mul_pd(_mm256_loadu_pd(sf1+i), s1_fs), e1_fs),
+                                  _mm256_mul_pd(_mm256_mul_pd(_mm256_loadu_pd(sf2+i), s2_fs), e2_fs));
+      __m256d r = _mm256_div_pd(num, _mm256_sub_pd(e1_fs, e2_fs));
+      // |r| < inf is false for both NaN and infinities
+      __m256d finite = _mm256_cmp_pd(_mm256_andnot_pd(sign, r), inf, _CMP_LT_OQ);
+      _mm256_storeu_pd(result+i, _mm256_blendv_pd(one, r, finite));
+      nfallback += 4 - __builtin_popcount(_mm256_movemask_pd(finite));
+    }
+    return nfallback + JetWeightsScalar(n-i, eff1+i, eff2+i, sf1+i, sf2+i, sf1_fs+i, sf2_fs+i, result+i);
+  }
+
+  __attribute__((target("avx512f")))
+  size_t JetWeightsAVX512(size_t n,
+                          const double *eff1, const double *eff2,
+                          const double *sf1, const double *sf2,
+                          const double *sf1_fs, const double *sf2_fs,
+                          double *result){
+    const __m512d one = _mm512_set1_pd(1.);
+    const __m512d inf = _mm512_set1_pd(numeric_limits<double>::infinity());
+    size_t nfallback = 0;
+    size_t i = 0;
+    for(; i+8 <= n; i += 8){
+      __m512d s1_fs = _mm512_loadu_pd(sf1_fs+i), s2_fs = _mm512_loadu_pd(sf2_fs+i);
+      __m512d e1_fs = _mm512_div_pd(_mm512_loadu_pd(eff1+i), s1_fs);
+      __m512d e2_fs = _mm512_div_pd(_mm512_loadu_pd(eff2+i), s2_fs);
+      __m512d num = _mm512_sub_pd(_mm512_mul_pd(_mm512_mul_pd(_mm512_loadu_pd(sf1+i), s1_fs), e1_fs),
+                                  _mm512_mul_pd(_mm512_mul_pd(_mm512_loadu_pd(sf2+i), s2_fs), e2_fs));
+      __m512d r = _mm512_div_pd(num, _mm512_sub_pd(e1_fs, e2_fs));
+      __mmask8 finite = _mm512_cmp_pd_mask(_mm512_abs_pd(r), inf, _CMP_LT_OQ);
+      _mm512_storeu_pd(result+i, _mm512_mask_blend_pd(finite, one, r));
+      nfallback += 8 - __builtin_popcount(finite);
+    }
+    return nfallback + JetWeightsScalar(n-i, eff1+i, eff2+i, sf1+i, sf2+i, sf1_fs+i, sf2_fs+i, result+i);
+  }
+#endif
+
+  struct Dispatch{
+    Kernel kernel;
+    const char *isa;
+  };
+
+  Dispatch SelectKernel(){
+#ifdef BTAG_JET_WEIGHT_X86
+    __builtin_cpu_init();
+    if(__builtin_cpu_supports("avx512f")) return Dispatch{JetWeightsAVX512, "avx512f"};
+    if(__builtin_cpu_supports("avx2")) return Dispatch{JetWeightsAVX2, "avx2"};
+#endif
+    return Dispatch{JetWeightsScalar, "scalar"};
+  }
+
+  const Dispatch & GetDispatch(){
+    static const Dispatch dispatch = SelectKernel();
+    return dispatch;
+  }
+
+  Kernel FindKernel(const string &isa){
+    if(isa == "scalar") return JetWeightsScalar;
+#ifdef BTAG_JET_WEIGHT_X86
+    __builtin_cpu_init();
+    if(isa == "avx2" && __builtin_cpu_supports("avx2")) return JetWeightsAVX2;
+    if(isa == "avx512f" && __builtin_cpu_supports("avx512f")) return JetWeightsAVX512;
+#endif
+    return nullptr;
+  }
+}
+
+size_t BTagJetWeights(size_t n,
+                      const double *eff1, const double *eff2,
+                      const double *sf1, const double *sf2,
+                      const double *sf1_fs, const double *sf2_fs,
+                      double *result){
+  return GetDispatch().kernel(n, eff1, eff2, sf1, sf2, sf1_fs, sf2_fs, result);
+}
+
+const char * BTagJetWeightsISA(){
+  return GetDispatch().isa;
+}
+
+bool BTagJetWeightsSupported(const string &isa){
+  return FindKernel(isa) != nullptr;
+}
+
+size_t BTagJetWeightsWith(const string &isa, size_t n,
+                          const double *eff1, const double *eff2,
+                          const double *sf1, const double *sf2,
+                          const double *sf1_fs, const double *sf2_fs,
+                          double *result){
+  Kernel kernel = FindKernel(isa);
+  if(kernel == nullptr) ERROR("b-tag jet weights for "+isa+" not supported here");
+  return kernel(n, eff1, eff2, sf1, sf2, sf1_fs, sf2_fs, result);
+}
@@ -2,11 +2,19 @@
 
 #include <cmath>
 
+#include <limits>
+
+#include "TFile.h"
+#include "TH3D.h"
+
+#include "btag_jet_weight.hpp"
+#include "calib_bundle.hpp"
 #include "utilities.hpp"
 
 using namespace std;
 
-const vector<BTagEntry::OperatingPoint> BTagWeighter::op_pts_{BTagEntry::OP_LOOSE, BTagEntry::OP_MEDIUM, BTagEntry::OP_TIGHT};
+const size_t BTagWeighter::kNumOps;
+const array<BTagEntry::OperatingPoint, BTagWeighter::kNumOps> BTagWeighter::op_pts_{{BTagEntry::OP_LOOSE, BTagEntry::OP_MEDIUM, BTagEntry::OP_TIGHT}};
 const vector<BTagEntry::JetFlavor> BTagWeighter::flavors_{BTagEntry::FLAV_B, BTagEntry::FLAV_C, BTagEntry::FLAV_UDSG};
 
 namespace{
@@ -14,21 +22,37 @@ namespace{
     std::unique_ptr<T> MakeUnique(Args&&... args){
     return std::unique_ptr<T>(new T(std::forward<Args>(args)...));
   }
+
+  // Index of the SF systematic (central, up, down) a variation uses for a jet
+  size_t SystIndex(BTagWeighter::Variation var, bool is_bc, bool fast){
+    switch(var){
+    case BTagWeighter::kBCUp:         return !fast && is_bc ? 1 : 0;
+    case BTagWeighter::kBCDown:       return !fast && is_bc ? 2 : 0;
+    case BTagWeighter::kUDSGUp:       return !fast && !is_bc ? 1 : 0;
+    case BTagWeighter::kUDSGDown:     return !fast && !is_bc ? 2 : 0;
+    case BTagWeighter::kFastBCUp:     return fast && is_bc ? 1 : 0;
+    case BTagWeighter::kFastBCDown:   return fast && is_bc ? 2 : 0;
+    case BTagWeighter::kFastUDSGUp:   return fast && !is_bc ? 1 : 0;
+    case BTagWeighter::kFastUDSGDown: return fast && !is_bc ? 2 : 0;
+    case BTagWeighter::kCentral:
+    case BTagWeighter::kNumVariations:
+    default:
+      return 0;
+    }
+  }
 }
 
-BTagWeighter::BTagWeighter(string proc, bool is_fast_sim, bool is_cmssw_7):
-  calib_full_(new BTagCalibration("csvv2", "data/CSVv2_Moriond17_B_H.csv")),
-  calib_fast_(new BTagCalibration("csvv2_deep", "data/fastsim_csvv2_ttbar_26_1_2017.csv")),
+BTagWeighter::BTagWeighter(string proc, bool is_fast_sim, bool is_cmssw_7, double sf_grid_tolerance):
+  proc_(proc),
+  sf_grid_tolerance_(sf_grid_tolerance),
   readers_full_(),
   readers_fast_(),
-  btag_efficiencies_(op_pts_.size()),
-  btag_efficiencies_proc_(op_pts_.size()),
-  calib_deep_full_(new BTagCalibration("csvv2_deep", "data/DeepCSV_94XSF_V3_B_F.csv")),
-  calib_deep_fast_(new BTagCalibration("csvv2_deep", "data/fastsim_deepcsv_ttbar_26_1_2017.csv")),
+  btag_efficiencies_(),
+  btag_efficiencies_proc_(),
   readers_deep_full_(),
   readers_deep_fast_(),
-  btag_efficiencies_deep_(op_pts_.size()),
-  btag_efficiencies_deep_proc_(op_pts_.size()),
+  btag_efficiencies_deep_(),
+  btag_efficiencies_deep_proc_(),
   csv_loose_(is_cmssw_7 ? 0.605 : 0.5426),
   csv_medium_(is_cmssw_7 ? 0.890 : 0.8484),
   csv_tight_(is_cmssw_7 ? 0.970 : 0.9535),
@@ -39,124 +63,347 @@ BTagWeighter::BTagWeighter(string proc, bool is_fast_sim, bool is_cmssw_7):
   if(proc != "tt" && proc != "qcd" && proc != "wjets"){
     ERROR("Process "+proc+" not found. Valid processes are tt, qcd, and wjets.");
   }
-  TFile file_eff("data/btagEfficiency.root", "read");
-  TFile file_deep("data/btagEfficiency_deep.root", "read");
-  TFile file_proc(("data/btagEfficiency_"+proc+".root").c_str(), "read");
-  TFile file_deep_proc(("data/btagEfficiency_deep_"+proc+".root").c_str(), "read");
-
+  const double cuts[] = {csv_loose_, csv_medium_, csv_tight_};
+  const double deep_cuts[] = {deep_csv_loose_, deep_csv_medium_, deep_csv_tight_};
   for(size_t i = 0; i < op_pts_.size(); ++i){
-    const auto op = op_pts_.at(i);
-    
-    readers_full_[op] = MakeUnique<BTagCalibrationReader>(op, "central", vector<string>{"up", "down"});
-    readers_full_.at(op)->load(*calib_full_, BTagEntry::FLAV_UDSG, "incl");
-    readers_full_.at(op)->load(*calib_full_, BTagEntry::FLAV_C, "comb");
-    readers_full_.at(op)->load(*calib_full_, BTagEntry::FLAV_B, "comb");
-
-    readers_deep_full_[op] = MakeUnique<BTagCalibrationReader>(op, "central", vector<string>{"up", "down"});
-    readers_deep_full_.at(op)->load(*calib_deep_full_, BTagEntry::FLAV_UDSG, "incl");
-    readers_deep_full_.at(op)->load(*calib_deep_full_, BTagEntry::FLAV_C, "comb");
-    readers_deep_full_.at(op)->load(*calib_deep_full_, BTagEntry::FLAV_B, "comb");
-
-    readers_fast_[op] = MakeUnique<BTagCalibrationReader>(op, "central", vector<string>{"up", "down"});
-    readers_fast_.at(op)->load(*calib_fast_, BTagEntry::FLAV_UDSG, "fastsim");
-    readers_fast_.at(op)->load(*calib_fast_, BTagEntry::FLAV_C, "fastsim");
-    readers_fast_.at(op)->load(*calib_fast_, BTagEntry::FLAV_B, "fastsim");
-
-    readers_deep_fast_[op] = MakeUnique<BTagCalibrationReader>(op, "central", vector<string>{"up", "down"});
-    readers_deep_fast_.at(op)->load(*calib_deep_fast_, BTagEntry::FLAV_UDSG, "fastsim");
-    readers_deep_fast_.at(op)->load(*calib_deep_fast_, BTagEntry::FLAV_C, "fastsim");
-    readers_deep_fast_.at(op)->load(*calib_deep_fast_, BTagEntry::FLAV_B, "fastsim");
-
-    string hist_eff, hist_deep;
-    switch(op){
-    case BTagEntry::OP_LOOSE:
-      hist_eff = "btagEfficiency_loose";
-      hist_deep = "btagEfficiency_deep_loose";
-      break;
-    case BTagEntry::OP_MEDIUM:
-      hist_eff = "btagEfficiency_medium";
-      hist_deep = "btagEfficiency_deep_medium";
-      break;
-    case BTagEntry::OP_TIGHT:
-      hist_eff = "btagEfficiency_tight";
-      hist_deep = "btagEfficiency_deep_tight";
-      break;
-    case BTagEntry::OP_RESHAPING:
-      hist_eff = "btagEfficiency_reshaping";
-      hist_deep = "btagEfficiency_deep_reshaping";
-      break;
-    default:
-      hist_eff = "btagEfficiency";
-      hist_deep = "btagEfficiency";
-      break;
+    csv_cuts_[i] = cuts[i];
+    deep_csv_cuts_[i] = deep_cuts[i];
+  }
+}
+
+void BTagWeighter::Preload(bool do_deep_csv, bool do_by_proc) const{
+  FullReaders(do_deep_csv);
+  if(is_fast_sim_) FastReaders(do_deep_csv);
+  EfficiencyTable(do_deep_csv, do_by_proc);
+  ShapeCalibration(do_deep_csv);
+}
+
+const BTagWeighter::ReaderList & BTagWeighter::FullReaders(bool do_deep_csv) const{
+  return do_deep_csv
+    ? LoadReaders(readers_deep_full_, "csvv2_deep", "data/DeepCSV_94XSF_V3_B_F.csv", "incl", "comb")
+    : LoadReaders(readers_full_, "csvv2", "data/CSVv2_Moriond17_B_H.csv", "incl", "comb");
+}
+
+const BTagWeighter::ReaderList & BTagWeighter::FastReaders(bool do_deep_csv) const{
+  return do_deep_csv
+    ? LoadReaders(readers_deep_fast_, "csvv2_deep", "data/fastsim_deepcsv_ttbar_26_1_2017.csv", "fastsim", "fastsim")
+    : LoadReaders(readers_fast_, "csvv2_deep", "data/fastsim_csvv2_ttbar_26_1_2017.csv", "fastsim", "fastsim");
+}
+
+const BTagWeighter::Shape & BTagWeighter::ShapeCalibration(bool do_deep_csv) const{
+  return do_deep_csv
+    ? LoadShape(shape_deep_, "csvv2_deep", "data/DeepCSV_94XSF_V3_B_F.csv")
+    : LoadShape(shape_, "csvv2", "data/CSVv2_Moriond17_B_H.csv");
+}
+
+const BTagEfficiencyTable & BTagWeighter::EfficiencyTable(bool do_deep_csv, bool do_by_proc) const{
+  if(do_deep_csv){
+    return do_by_proc
+      ? LoadEfficiencies(btag_efficiencies_deep_proc_, "data/btagEfficiency_deep_"+proc_+".root", true)
+      : LoadEfficiencies(btag_efficiencies_deep_, "data/btagEfficiency_deep.root", true);
+  }else{
+    return do_by_proc
+      ? LoadEfficiencies(btag_efficiencies_proc_, "data/btagEfficiency_"+proc_+".root", false)
+      : LoadEfficiencies(btag_efficiencies_, "data/btagEfficiency.root", false);
+  }
+}
+
+const BTagWeighter::ReaderList & BTagWeighter::LoadReaders(Readers &readers, const string &tagger, const string &csv_file,
+							    const string &udsg_meas, const string &bc_meas) const{
+  call_once(readers.loaded, [&](){
+      const CalibBundle *bundle = CalibBundle::Default();
+      if(bundle != nullptr) readers.calib = bundle->Calibration(tagger, csv_file);
+      if(!readers.calib) readers.calib = MakeUnique<BTagCalibration>(tagger, csv_file);
+      readers.readers.resize(op_pts_.size());
+      for(size_t i = 0; i < op_pts_.size(); ++i){
+	auto &reader = readers.readers.at(i);
+	reader = MakeUnique<BTagCalibrationReader>(op_pts_.at(i), "central", vector<string>{"up", "down"});
+	reader->load(*readers.calib, BTagEntry::FLAV_UDSG, udsg_meas);
+	reader->load(*readers.calib, BTagEntry::FLAV_C, bc_meas);
+	reader->load(*readers.calib, BTagEntry::FLAV_B, bc_meas);
+	if(sf_grid_tolerance_ > 0.) reader->setPtGrid(1., sf_grid_tolerance_);
+      }
+    });
+  return readers.readers;
+}
+
+const BTagWeighter::Shape & BTagWeighter::LoadShape(Shape &shape, const string &tagger, const string &csv_file) const{
+  call_once(shape.loaded, [&](){
+      const CalibBundle *bundle = CalibBundle::Default();
+      if(bundle != nullptr) shape.calib = bundle->Calibration(tagger, csv_file);
+      if(!shape.calib) shape.calib = MakeUnique<BTagCalibration>(tagger, csv_file);
+      const vector<string> &systs = ShapeSysTypes();
+      shape.reader = MakeUnique<BTagCalibrationReader>(BTagEntry::OP_RESHAPING, "central", systs);
+      for(const auto flav: flavors_){
+	shape.reader->load(*shape.calib, flav, "iterativefit");
+	vector<bool> &has_sys = shape.has_sys[flav];
+	has_sys.assign(systs.size()+1, false);
+	for(size_t isys = 0; isys <= systs.size(); ++isys){
+	  BTagEntry::Parameters params(BTagEntry::OP_RESHAPING, "iterativefit", isys == 0 ? "central" : systs.at(isys-1));
+	  for(const auto &entry: shape.calib->getEntries(params)){
+	    if(entry.params.jetFlavor == flav) has_sys.at(isys) = true;
+	  }
+	}
+      }
+    });
+  return shape;
+}
+
+const BTagEfficiencyTable & BTagWeighter::LoadEfficiencies(Efficiencies &efficiencies, const string &root_file,
+							   bool do_deep_csv) const{
+  call_once(efficiencies.loaded, [&](){
+      vector<string> names;
+      for(const auto op: op_pts_){
+	string hist_eff, hist_deep;
+	switch(op){
+	case BTagEntry::OP_LOOSE:
+	  hist_eff = "btagEfficiency_loose";
+	  hist_deep = "btagEfficiency_deep_loose";
+	  break;
+	case BTagEntry::OP_MEDIUM:
+	  hist_eff = "btagEfficiency_medium";
+	  hist_deep = "btagEfficiency_deep_medium";
+	  break;
+	case BTagEntry::OP_TIGHT:
+	  hist_eff = "btagEfficiency_tight";
+	  hist_deep = "btagEfficiency_deep_tight";
+	  break;
+	case BTagEntry::OP_RESHAPING:
+	  hist_eff = "btagEfficiency_reshaping";
+	  hist_deep = "btagEfficiency_deep_reshaping";
+	  break;
+	default:
+	  hist_eff = "btagEfficiency";
+	  hist_deep = "btagEfficiency";
+	  break;
+	}
+	names.push_back(do_deep_csv ? hist_deep : hist_eff);
+      }
+
+      const CalibBundle *bundle = CalibBundle::Default();
+      if(bundle != nullptr){
+	vector<CalibBundle::Hist> bundled(names.size());
+	bool found = true;
+	for(size_t i = 0; i < names.size(); ++i) found = found && bundle->FindHist(root_file, names.at(i), bundled.at(i));
+	if(found){
+	  efficiencies.table = BTagEfficiencyTable(bundled);
+	  return;
+	}
+      }
+
+      TFile file(root_file.c_str(), "read");
+      vector<const TH3D*> hists;
+      for(const auto &name: names) hists.push_back(static_cast<const TH3D*>(file.Get(name.c_str())));
+      efficiencies.table = BTagEfficiencyTable(hists);
+    });
+  return efficiencies.table;
+}
+
+BTagWeighter::EventWeightSet BTagWeighter::EventWeights(baby_plus &b, const vector<OpSet> &op_sets,
+							bool do_deep_csv, bool do_by_proc) const{
+  const size_t nops = op_pts_.size();
+
+  EventWeightSet weights;
+  bool requested[kNumOpSets] = {};
+  for(const auto op_set: op_sets) requested[op_set] = true;
+  vector<size_t> &sets = scratch_.sets;
+  sets.clear();
+  for(size_t iset = 0; iset < kNumOpSets; ++iset){
+    if(requested[iset]) sets.push_back(iset);
+    for(size_t ivar = 0; ivar < kNumVariations; ++ivar){
+      weights.weight[iset][ivar] = requested[iset] ? 1. : numeric_limits<double>::quiet_NaN();
     }
-    
-    btag_efficiencies_.at(i) = *static_cast<const TH3D*>(file_eff.Get(hist_eff.c_str()));
-    btag_efficiencies_proc_.at(i) = *static_cast<const TH3D*>(file_proc.Get(hist_eff.c_str()));
-    btag_efficiencies_deep_.at(i) = *static_cast<const TH3D*>(file_deep.Get(hist_deep.c_str()));
-    btag_efficiencies_deep_proc_.at(i) = *static_cast<const TH3D*>(file_deep_proc.Get(hist_deep.c_str()));
   }
+
+  const auto &readers_full = FullReaders(do_deep_csv);
+  const auto *readers_fast = is_fast_sim_ ? &FastReaders(do_deep_csv) : nullptr;
+  const float *opcuts = do_deep_csv ? deep_csv_cuts_ : csv_cuts_;
+
+  // Jets other than leptons as structure of arrays
+  vector<size_t> &jets = scratch_.jets;
+  vector<BTagEfficiencyTable::FlavorClass> &flavors = scratch_.flavors;
+  vector<float> &abs_etas = scratch_.abs_etas, &pts = scratch_.pts;
+  jets.clear();
+  flavors.clear();
+  abs_etas.clear();
+  pts.clear();
+  auto n_jets = b.jets_islep().size();
+  for(size_t ijet = 0; ijet < n_jets; ++ijet){
+    if(b.jets_islep().at(ijet)) continue;
+    jets.push_back(ijet);
+    flavors.push_back(BTagEfficiencyTable::GetFlavorClass(b.jets_hflavor().at(ijet)));
+    abs_etas.push_back(fabs(b.jets_eta().at(ijet)));
+    pts.push_back(b.jets_pt().at(ijet));
+  }
+  const size_t njets = jets.size();
+
+  // Index: position in op_pts_, then jet
+  vector<float> &effs = scratch_.effs;
+  effs.resize(nops*njets);
+  const BTagEfficiencyTable &eff_table = EfficiencyTable(do_deep_csv, do_by_proc);
+  for(size_t iop = 0; iop < nops; ++iop){
+    eff_table.Efficiencies(iop, njets, flavors.data(), abs_etas.data(), pts.data(), effs.data()+iop*njets);
+  }
+
+  // Terms of the jet weight formula. Index: term, then requested OP set, variation and jet
+  enum{kEff1, kEff2, kSF1, kSF2, kSF1Fast, kSF2Fast, kNumTerms};
+  const size_t nvals = sets.size()*kNumVariations*njets;
+  vector<double> &terms = scratch_.terms, &results = scratch_.results;
+  terms.resize(kNumTerms*nvals);
+  results.resize(nvals);
+  double *term[kNumTerms];
+  for(size_t iterm = 0; iterm < kNumTerms; ++iterm) term[iterm] = terms.data()+iterm*nvals;
+
+  // Index: position in op_pts_, then Syst
+  double sf[kNumOps][kNumSysts], sf_fs[kNumOps][kNumSysts];
+  for(size_t i = 0; i < njets; ++i){
+    const size_t ijet = jets.at(i);
+    BTagEntry::JetFlavor flav = BTagEntry::FLAV_UDSG;
+    if(flavors.at(i) == BTagEfficiencyTable::kB) flav = BTagEntry::FLAV_B;
+    else if(flavors.at(i) == BTagEfficiencyTable::kC) flav = BTagEntry::FLAV_C;
+    bool is_bc = flav != BTagEntry::FLAV_UDSG;
+    float csv = do_deep_csv ? b.jets_csvd().at(ijet) : b.jets_csv().at(ijet);
+    double jet_pt = pts.at(i);
+    double jet_eta = b.jets_eta().at(ijet);
+
+    // The readers' sys handles are the Syst values
+    for(size_t iop = 0; iop < nops; ++iop){
+      readers_full[iop]->eval_auto_bounds_all(flav, jet_eta, jet_pt, 0., sf[iop]);
+      if(is_fast_sim_){
+        (*readers_fast)[iop]->eval_auto_bounds_all(flav, jet_eta, jet_pt, 0., sf_fs[iop]);
+      }else{
+        for(int isys = 0; isys < kNumSysts; ++isys) sf_fs[iop][isys] = 1.;
+      }
+    }
+
+    for(size_t irow = 0; irow < sets.size(); ++irow){
+      const size_t iset = sets.at(irow);
+      // OPs [first, last) of op_pts_ in the set, and the tightest one passed
+      int first = iset == kOpAll ? 0 : iset;
+      int last = iset == kOpAll ? nops : iset+1;
+      int tag = first-1;
+      for(int iop = first; iop < last; ++iop){
+        if(csv > opcuts[iop]) tag = iop;
+      }
+
+      for(size_t ivar = 0; ivar < kNumVariations; ++ivar){
+        size_t isys = SystIndex(static_cast<Variation>(ivar), is_bc, false);
+        size_t isys_fs = SystIndex(static_cast<Variation>(ivar), is_bc, true);
+        const size_t k = (irow*kNumVariations+ivar)*njets+i;
+        term[kEff1][k] = 1.; term[kSF1][k] = 1.; term[kSF1Fast][k] = 1.;
+        term[kEff2][k] = 0.; term[kSF2][k] = 1.; term[kSF2Fast][k] = 1.;
+        if(tag >= first){
+          term[kEff1][k] = effs.at(tag*njets+i);
+          term[kSF1][k] = sf[tag][isys];
+          term[kSF1Fast][k] = sf_fs[tag][isys_fs];
+        }
+        if(tag+1 < last){
+          term[kEff2][k] = effs.at((tag+1)*njets+i);
+          term[kSF2][k] = sf[tag+1][isys];
+          term[kSF2Fast][k] = sf_fs[tag+1][isys_fs];
+        }
+      }
+    }
+  }
+
+  size_t nfallback = BTagJetWeights(nvals,
+				    term[kEff1], term[kEff2],
+				    term[kSF1], term[kSF2],
+				    term[kSF1Fast], term[kSF2Fast],
+				    results.data());
+  if(nfallback) DBG(to_string(nfallback)+" SFs are NaN or inf. Setting them to 1.!");
+
+  // Products taken in jet order, as in EventWeight
+  for(size_t irow = 0; irow < sets.size(); ++irow){
+    for(size_t ivar = 0; ivar < kNumVariations; ++ivar){
+      const double *result = results.data()+(irow*kNumVariations+ivar)*njets;
+      double &weight = weights.weight[sets.at(irow)][ivar];
+      for(size_t i = 0; i < njets; ++i) weight *= result[i];
+    }
+  }
+  return weights;
+}
+
+const vector<string> & BTagWeighter::ShapeSysTypes(){
+  static const vector<string> systs = {"up_jes", "down_jes", "up_lf", "down_lf", "up_hf", "down_hf",
+				       "up_hfstats1", "down_hfstats1", "up_hfstats2", "down_hfstats2",
+				       "up_lfstats1", "down_lfstats1", "up_lfstats2", "down_lfstats2",
+				       "up_cferr1", "down_cferr1", "up_cferr2", "down_cferr2"};
+  return systs;
+}
+
+void BTagWeighter::ShapeWeights(baby_plus &b, bool do_deep_csv,
+				float &weight, vector<float> &sys_weights) const{
+  const Shape &shape = ShapeCalibration(do_deep_csv);
+  const size_t nsys = shape.reader->num_sys_types();
+  vector<double> &weights = scratch_.shape_weights, &sfs = scratch_.shape_sfs;
+  weights.assign(nsys, 1.);
+  sfs.resize(nsys);
+  auto n_jets = b.jets_islep().size();
+  for(size_t ijet = 0; ijet < n_jets; ++ijet){
+    if(b.jets_islep().at(ijet)) continue;
+    BTagEfficiencyTable::FlavorClass flavor = BTagEfficiencyTable::GetFlavorClass(b.jets_hflavor().at(ijet));
+    BTagEntry::JetFlavor flav = BTagEntry::FLAV_UDSG;
+    if(flavor == BTagEfficiencyTable::kB) flav = BTagEntry::FLAV_B;
+    else if(flavor == BTagEfficiencyTable::kC) flav = BTagEntry::FLAV_C;
+    float csv = do_deep_csv ? b.jets_csvd().at(ijet) : b.jets_csv().at(ijet);
+
+    // One search of the (eta, pt, discriminant) index gives every variation;
+    // no entry means outside the calibrated range
+    if(!shape.reader->eval_auto_bounds_all(flav, b.jets_eta().at(ijet), b.jets_pt().at(ijet), csv, sfs.data())) continue;
+    const vector<bool> &has_sys = shape.has_sys[flav];
+    for(size_t isys = 0; isys < nsys; ++isys){
+      weights.at(isys) *= has_sys.at(isys) ? sfs.at(isys) : sfs.front();
+    }
+  }
+  weight = weights.front();
+  sys_weights.assign(weights.begin()+1, weights.end());
 }
 
 double BTagWeighter::EventWeight(baby_plus &b, BTagEntry::OperatingPoint op,
 				 const string &bc_full_syst, const string &udsg_full_syst,
 				 const string &bc_fast_syst, const string &udsg_fast_syst,
 				 bool do_deep_csv, bool do_by_proc) const{
-  double product = 1.;
-  auto n_jets = b.jets_islep().size();
-  for(size_t i = 0; i < n_jets; ++i){
-    if(!b.jets_islep().at(i)){
-      product *= JetBTagWeight(b, i, op,
-			       bc_full_syst, udsg_full_syst,
-			       bc_fast_syst, udsg_fast_syst,
-			       do_deep_csv, do_by_proc);
-    }
-  }
-  return product;
+  return EventWeight(b, vector<BTagEntry::OperatingPoint>{op},
+		     bc_full_syst, udsg_full_syst,
+		     bc_fast_syst, udsg_fast_syst,
+		     do_deep_csv, do_by_proc);
 }
 
 double BTagWeighter::EventWeight(baby_plus &b, BTagEntry::OperatingPoint op,
 				 const string &bc_full_syst, const string &udsg_full_syst,
 				 bool do_deep_csv, bool do_by_proc) const{
-  double product = 1.;
-  auto n_jets = b.jets_islep().size();
-  for(size_t i = 0; i < n_jets; ++i){
-    if(!b.jets_islep().at(i)){
-      product *= JetBTagWeight(b, i, op,
-			       bc_full_syst, udsg_full_syst,
-			       do_deep_csv, do_by_proc);
-    }
-  }
-  return product;
+  return EventWeight(b, vector<BTagEntry::OperatingPoint>{op},
+		     bc_full_syst, udsg_full_syst,
+		     "central", "central",
+		     do_deep_csv, do_by_proc);
 }
 
 double BTagWeighter::EventWeight(baby_plus &b, const vector<BTagEntry::OperatingPoint> &ops,
 				 const string &bc_full_syst, const string &udsg_full_syst,
 				 bool do_deep_csv, bool do_by_proc) const{
-  double product = 1.;
-  auto n_jets = b.jets_islep().size();
-  for(size_t i = 0; i < n_jets; ++i){
-    if(!b.jets_islep().at(i)){
-      product *= JetBTagWeight(b, i, ops,
-			       bc_full_syst, udsg_full_syst,
-			       do_deep_csv, do_by_proc);
-    }
-  }
-  return product;
+  return EventWeight(b, ops,
+		     bc_full_syst, udsg_full_syst,
+		     "central", "central",
+		     do_deep_csv, do_by_proc);
 }
 
 double BTagWeighter::EventWeight(baby_plus &b, const vector<BTagEntry::OperatingPoint> &ops,
 				 const string &bc_full_syst, const string &udsg_full_syst,
 				 const string &bc_fast_syst, const string &udsg_fast_syst,
 				 bool do_deep_csv, bool do_by_proc) const{
+  // Names are resolved once per event rather than per jet
+  const OpList op_list = GetOpList(ops);
+  const Syst bc_full = GetSyst(bc_full_syst), udsg_full = GetSyst(udsg_full_syst);
+  const Syst bc_fast = GetSyst(bc_fast_syst), udsg_fast = GetSyst(udsg_fast_syst);
   double product = 1.;
   auto n_jets = b.jets_islep().size();
   for(size_t i = 0; i < n_jets; ++i){
     if(!b.jets_islep().at(i)){
-      product *= JetBTagWeight(b, i, ops,
-			       bc_full_syst, udsg_full_syst,
-			       bc_fast_syst, udsg_fast_syst,
-			       do_deep_csv, do_by_proc);
+      product *= JetWeight(b, i, op_list,
+			   bc_full, udsg_full,
+			   bc_fast, udsg_fast,
+			   do_deep_csv, do_by_proc);
     }
   }
   return product;
@@ -194,10 +441,39 @@ double BTagWeighter::JetBTagWeight(baby_plus &b, size_t ijet, const vector<BTagE
 				   const string &bc_full_syst, const string &udsg_full_syst,
 				   const string &bc_fast_syst, const string &udsg_fast_syst,
 				   bool do_deep_csv, bool do_by_proc) const{
+  return JetWeight(b, ijet, GetOpList(ops),
+		   GetSyst(bc_full_syst), GetSyst(udsg_full_syst),
+		   GetSyst(bc_fast_syst), GetSyst(udsg_fast_syst),
+		   do_deep_csv, do_by_proc);
+}
+
+BTagWeighter::Syst BTagWeighter::GetSyst(const string &syst){
+  if(syst == "central") return kSystCentral;
+  else if(syst == "up") return kSystUp;
+  else if(syst == "down") return kSystDown;
+  ERROR("Systematic "+syst+" not found. Valid systematics are central, up, and down.");
+}
+
+BTagWeighter::OpList BTagWeighter::GetOpList(const vector<BTagEntry::OperatingPoint> &ops){
+  if(ops.size() > op_pts_.size()) ERROR("Too many operating points: "+to_string(ops.size()));
+  OpList op_list;
+  op_list.size = ops.size();
+  for(size_t i = 0; i < ops.size(); ++i){
+    auto it = find(op_pts_.cbegin(), op_pts_.cend(), ops.at(i));
+    if(it == op_pts_.cend()) ERROR("Operating point "+to_string(static_cast<int>(ops.at(i)))+" not supported");
+    op_list.iop[i] = distance(op_pts_.cbegin(), it);
+  }
+  return op_list;
+}
+
+double BTagWeighter::JetWeight(baby_plus &b, size_t ijet, const OpList &ops,
+			       Syst bc_full_syst, Syst udsg_full_syst,
+			       Syst bc_fast_syst, Syst udsg_fast_syst,
+			       bool do_deep_csv, bool do_by_proc) const{
   // procedure from https://twiki.cern.ch/twiki/bin/view/CMS/BTagSFMethods#1a_Event_reweighting_using_scale
   int hadronFlavour = abs(b.jets_hflavor().at(ijet));
   BTagEntry::JetFlavor flav;
-  string full_syst, fast_syst;
+  Syst full_syst, fast_syst;
   switch(hadronFlavour){
     case 5: flav = BTagEntry::FLAV_B; break;
     case 4: flav = BTagEntry::FLAV_C; break;
@@ -217,41 +493,33 @@ double BTagWeighter::JetBTagWeight(baby_plus &b, size_t ijet, const vector<BTagE
       ERROR("Did not recognize BTagEntry::JetFlavor "+std::to_string(static_cast<int>(flav)));
   }
 
-  vector<float> opcuts;
-  for (auto &iop: ops) {
-    if (iop==BTagEntry::OP_LOOSE) opcuts.push_back(do_deep_csv ? deep_csv_loose_ : csv_loose_);
-    else if (iop==BTagEntry::OP_MEDIUM) opcuts.push_back(do_deep_csv ? deep_csv_medium_ : csv_medium_); 
-    else if (iop==BTagEntry::OP_TIGHT) opcuts.push_back(do_deep_csv ? deep_csv_tight_ : csv_tight_);
-  }
+  const float *opcuts = do_deep_csv ? deep_csv_cuts_ : csv_cuts_;
 
   float csv = b.jets_csv().at(ijet);
-  if (do_deep_csv) 
+  if (do_deep_csv)
     csv = b.jets_csvd().at(ijet);
 
   int tag = -1;
-  for (unsigned iop(0); iop<opcuts.size(); iop++) 
-    if (csv>opcuts[iop]) tag = iop;
-
-  const map<BTagEntry::OperatingPoint, unique_ptr<BTagCalibrationReader> > *ireaders_full = nullptr;
-  ireaders_full = do_deep_csv ? &readers_deep_full_ : &readers_full_;
+  for (unsigned iop(0); iop<ops.size; iop++)
+    if (csv>opcuts[ops.iop[iop]]) tag = iop;
 
-  const map<BTagEntry::OperatingPoint, unique_ptr<BTagCalibrationReader> > *ireaders_fast = &readers_fast_;
-  if (do_deep_csv) ireaders_fast = &readers_deep_fast_;
+  const auto &ireaders_full = FullReaders(do_deep_csv);
+  const auto *ireaders_fast = is_fast_sim_ ? &FastReaders(do_deep_csv) : nullptr;
 
   double jet_pt = b.jets_pt().at(ijet);
   double jet_eta = b.jets_eta().at(ijet);
   double eff1(1), eff2(0), sf1(1), sf2(1), sf1_fs(1), sf2_fs(1);
   if (tag >= 0){
-    BTagEntry::OperatingPoint iop = ops[tag];
+    size_t iop = ops.iop[tag];
     eff1 = GetMCTagEfficiency(hadronFlavour, jet_pt, jet_eta, iop, do_deep_csv, do_by_proc);
-    sf1 = ireaders_full->at(iop)->eval_auto_bounds(full_syst, flav, jet_eta, jet_pt);
-    if (is_fast_sim_) sf1_fs = ireaders_fast->at(iop)->eval_auto_bounds(fast_syst, flav, jet_eta, jet_pt);
+    sf1 = ireaders_full[iop]->eval_auto_bounds(full_syst, flav, jet_eta, jet_pt);
+    if (is_fast_sim_) sf1_fs = (*ireaders_fast)[iop]->eval_auto_bounds(fast_syst, flav, jet_eta, jet_pt);
   }
-  if (tag < int(ops.size())-1) {
-    BTagEntry::OperatingPoint iop = ops[tag+1];
+  if (tag < int(ops.size)-1) {
+    size_t iop = ops.iop[tag+1];
     eff2 = GetMCTagEfficiency(hadronFlavour, jet_pt, jet_eta, iop, do_deep_csv, do_by_proc);
-    sf2 = ireaders_full->at(iop)->eval_auto_bounds(full_syst, flav, jet_eta, jet_pt);
-    if (is_fast_sim_) sf2_fs = ireaders_fast->at(iop)->eval_auto_bounds(fast_syst, flav, jet_eta, jet_pt);
+    sf2 = ireaders_full[iop]->eval_auto_bounds(full_syst, flav, jet_eta, jet_pt);
+    if (is_fast_sim_) sf2_fs = (*ireaders_fast)[iop]->eval_auto_bounds(fast_syst, flav, jet_eta, jet_pt);
   }
 
   double eff1_fs(eff1/sf1_fs), eff2_fs(eff2/sf2_fs);
@@ -264,33 +532,6 @@ double BTagWeighter::JetBTagWeight(baby_plus &b, size_t ijet, const vector<BTagE
 }
 
 double BTagWeighter::GetMCTagEfficiency(int pdgId, float pT, float eta,
-					BTagEntry::OperatingPoint op, bool do_deep_csv, bool do_by_proc) const{
-  size_t rdr_idx = distance(op_pts_.cbegin(), find(op_pts_.cbegin(), op_pts_.cend(), op));
-  pdgId = abs(pdgId);
-  if(pdgId != 4 && pdgId != 5){
-    // in the ghost clustering scheme to determine flavor, there are only b, c and other (id=0) flavors
-    pdgId = 0;
-  }
-
-  int bin;
-  float eff;
-  if(!do_deep_csv){
-    if(!do_by_proc){
-      bin = btag_efficiencies_.at(rdr_idx).FindFixBin(fabs(eta), pT, pdgId);
-      eff = btag_efficiencies_.at(rdr_idx).GetBinContent(bin);
-    }else{
-      bin = btag_efficiencies_proc_.at(rdr_idx).FindFixBin(fabs(eta), pT, pdgId);
-      eff = btag_efficiencies_proc_.at(rdr_idx).GetBinContent(bin);
-    }
-  }else{
-    if(!do_by_proc){
-      bin = btag_efficiencies_deep_.at(rdr_idx).FindFixBin(fabs(eta), pT, pdgId);
-      eff = btag_efficiencies_deep_.at(rdr_idx).GetBinContent(bin);
-    }else{
-      bin = btag_efficiencies_deep_proc_.at(rdr_idx).FindFixBin(fabs(eta), pT, pdgId);
-      eff = btag_efficiencies_deep_proc_.at(rdr_idx).GetBinContent(bin);
-    }
-  }
-  
-  return eff;
+					size_t rdr_idx, bool do_deep_csv, bool do_by_proc) const{
+  return EfficiencyTable(do_deep_csv, do_by_proc).Efficiency(rdr_idx, BTagEfficiencyTable::GetFlavorClass(pdgId), fabs(eta), pT);
 }
@@ -0,0 +1,143 @@
+// build_calib_bundle: preprocesses the b-tag calibration csv files and the
+// histograms and graphs of the ROOT files in data/ into the binary bundle
+// read by CalibBundle, so jobs skip parsing and ROOT file reads at startup
+
+#include <dirent.h>
+
+#include <algorithm>
+#include <fstream>
+#include <iostream>
+#include <set>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <getopt.h>
+
+#include "TError.h"
+#include "TFile.h"
+#include "TGraphAsymmErrors.h"
+#include "TH1.h"
+#include "TH2D.h"
+#include "TKey.h"
+#include "TList.h"
+
+#include "BTagEntry.hpp"
+#include "calib_bundle.hpp"
+#include "utilities.hpp"
+
+using namespace std;
+
+namespace {
+  string data_dir = "data";
+  string out_file = CalibBundle::DefaultPath();
+}
+
+void GetOptions(int argc, char *argv[]);
+
+vector<string> ListFiles(const string &dir, const string &extension){
+  vector<string> files;
+  DIR *dp = opendir(dir.c_str());
+  if(dp == nullptr) ERROR("Could not open directory "+dir);
+  while(struct dirent *entry = readdir(dp)){
+    string name = entry->d_name;
+    if(name.size() > extension.size()
+       && name.compare(name.size()-extension.size(), extension.size(), extension) == 0){
+      files.push_back(dir+"/"+name);
+    }
+  }
+  closedir(dp);
+  sort(files.begin(), files.end());
+  return files;
+}
+
+// Entries in file order, read as BTagCalibration::readCSV does
+vector<BTagEntry> ReadEntries(const string &csv_file){
+  ifstream file(csv_file.c_str());
+  if(!file.good()) ERROR("Could not open "+csv_file);
+  vector<BTagEntry> entries;
+  string line;
+  getline(file, line);
+  if(line.find("OperatingPoint") == string::npos) entries.push_back(BTagEntry(line));
+  while(getline(file, line)){
+    line = BTagEntry::trimStr(line);
+    if(line.empty()) continue;
+    entries.push_back(BTagEntry(line));
+  }
+  return entries;
+}
+
+// Number of items bundled from root_file
+size_t AddRootFile(CalibBundleWriter &writer, const string &root_file){
+  TFile file(root_file.c_str(), "read");
+  if(!file.IsOpen()) ERROR("Could not open "+root_file);
+  set<string> names;
+  TIter next(file.GetListOfKeys());
+  while(TKey *key = static_cast<TKey*>(next())){
+    string name = key->GetName();
+    if(!names.insert(name).second) continue; // Later cycles; Get reads the highest
+    TObject *obj = file.Get(name.c_str());
+    if(obj == nullptr) continue;
+    if(obj->InheritsFrom("TH1")){
+      writer.AddHist(root_file, name, *static_cast<TH1*>(obj));
+    }else if(obj->InheritsFrom("TGraphAsymmErrors")){
+      writer.AddHist(root_file, name, GraphToHist(*static_cast<TGraphAsymmErrors*>(obj)));
+    }else{
+      names.erase(name);
+    }
+  }
+  return names.size();
+}
+
+int main(int argc, char *argv[]){
+  gErrorIgnoreLevel = 6000;
+  GetOptions(argc, argv);
+
+  CalibBundleWriter writer;
+  for(const auto &csv_file: ListFiles(data_dir, ".csv")){
+    try{
+      vector<BTagEntry> entries = ReadEntries(csv_file);
+      writer.AddCalibration(csv_file, entries);
+      writer.AddSource(csv_file);
+      cout << "Bundled " << entries.size() << " b-tag calibration entries from " << csv_file << endl;
+    }catch(const runtime_error &e){
+      cerr << "Skipping " << csv_file << ": " << e.what() << endl;
+    }
+  }
+  for(const auto &root_file: ListFiles(data_dir, ".root")){
+    size_t nitems = AddRootFile(writer, root_file);
+    if(nitems == 0) continue;
+    writer.AddSource(root_file);
+    cout << "Bundled " << nitems << " histograms from " << root_file << endl;
+  }
+
+  writer.Write(out_file);
+  cout << "Wrote " << out_file << endl;
+}
+
+void GetOptions(int argc, char *argv[]){
+  while(true){
+    static struct option long_options[] = {
+      {"data_dir", required_argument, 0, 'd'}, // Directory with the csv and ROOT files, as named by their users
+      {"out_file", required_argument, 0, 'o'}, // Bundle to write
+      {0, 0, 0, 0}
+    };
+
+    char opt = -1;
+    int option_index;
+    opt = getopt_long(argc, argv, "d:o:", long_options, &option_index);
+    if(opt == -1) break;
+
+    switch(opt){
+    case 'd':
+      data_dir = optarg;
+      break;
+    case 'o':
+      out_file = optarg;
+      break;
+    default:
+      printf("Bad option! getopt_long returned character code 0%o\n", opt);
+      break;
+    }
+  }
+}
@@ -1,10 +1,16 @@
 #include <ctime>
 
 #include <iostream>
+#include <map>
+#include <memory>
+#include <thread>
+#include <tuple>
+#include <exception>
 
 #include <getopt.h>
 
 #include "TError.h"
+#include "TROOT.h"
 
 #include "baby_plus.hpp"
 #include "baby_corr.hpp"
@@ -12,6 +18,8 @@
 #include "cross_sections.hpp"
 #include "btag_weighter.hpp"
 #include "lepton_weighter.hpp"
+#include "corrections.hpp"
+#include "corr_server.hpp"
 
 using namespace std;
 
@@ -22,14 +30,62 @@ namespace {
   bool quick = false;
   bool fix_b_wgt = true;
   bool fix_lep_wgt = false;
+  bool fast_clone = false;
+  bool delta = false;
+  double sf_grid_tolerance = 0.;
+  string lep_sf_set = "";
+  unsigned threads = 1;
+  string weight_cache = "";
+  string serve_socket = "";
+  unsigned server_workers = thread::hardware_concurrency();
+
+  // Kept across the jobs of a server, loaded before its workers fork
+  map<tuple<string, bool, double>, unique_ptr<BTagWeighter> > weighters;
+  map<string, unique_ptr<LeptonWeighter> > lepton_weighters;
 }
 
 void GetOptions(int argc, char *argv[]);
+int CalcCorr();
+BTagWeighter & GetWeighter(const string &proc, bool isSignal);
+const LeptonWeighter & GetLeptonWeighter();
+void ProcessRange(baby_plus &b, BTagWeighter &btw, const LeptonWeighter &lw, baby_corr &c, WeightCacheWriter *cache,
+                  bool isSignal, long first, long last);
 
 int main(int argc, char *argv[]){
   // gErrorIgnoreLevel=6000; // Turns off ROOT errors due to missing branches       
   GetOptions(argc, argv);
+  if(serve_socket == "") return CalcCorr();
 
+  // Workers start from these weighters, with the calibrations CalcEntry reads
+  for(const char *proc: {"tt", "wjets", "qcd"}){
+    for(bool isSignal: {false, true}) GetWeighter(proc, isSignal).Preload(true, false);
+  }
+  GetLeptonWeighter().Preload(true);
+  // Jobs start from the options the server was given
+  RunServer(serve_socket, server_workers, [](const vector<string> &args){
+      return RunWithArgs(args, [](int job_argc, char *job_argv[]){
+          serve_socket = "";
+          GetOptions(job_argc, job_argv);
+          if(serve_socket != "") ERROR("Option --serve is not valid in a job");
+          return CalcCorr();
+        });
+    });
+}
+
+BTagWeighter & GetWeighter(const string &proc, bool isSignal){
+  auto &btw = weighters[make_tuple(proc, isSignal, sf_grid_tolerance)];
+  if(!btw) btw.reset(new BTagWeighter(proc, isSignal, false, sf_grid_tolerance));
+  return *btw;
+}
+
+// Nothing is read from the SF files until the first lepton weight
+const LeptonWeighter & GetLeptonWeighter(){
+  auto &lw = lepton_weighters[lep_sf_set];
+  if(!lw) lw.reset(new LeptonWeighter(lep_sf_set == "" ? LeptonWeighter::DefaultSFSet() : LeptonWeighter::ReadSFSet(lep_sf_set)));
+  return *lw;
+}
+
+int CalcCorr(){
   time_t begtime, endtime;
   time(&begtime);
 
@@ -42,194 +98,106 @@ int main(int argc, char *argv[]){
   string corr_file = corr_dir + "/" + file_name;
   string out_file = out_dir + "/" + file_name;
   
-  cout << "Input file: " << in_file << endl;
-  baby_plus b(in_file, out_file);
+  if(fast_clone && delta) ERROR("Options --fast_clone and --delta are exclusive");
+  if(fast_clone && threads > 1) ERROR("Option --fast_clone clones every entry and cannot be split in --threads");
+  baby_plus::OutputMode mode = baby_plus::kFullCopy;
+  if(fast_clone) mode = baby_plus::kFastClone;
+  else if(delta) mode = baby_plus::kDelta;
 
+  cout << "Input file: " << in_file << endl;
   cout << "Writing output to: " << out_file << endl;
   cout << "Writing sum-of-weights to: " << corr_file << endl;
 
   bool isSignal = false;
-  if(b.GetEntries() > 0){
-    b.GetEntry(0);
-    if(b.type()>=100e3) isSignal = true;
+  long nent = 0;
+  {
+    baby_plus probe(in_file);
+    nent = probe.GetEntries();
+    if(nent > 0){
+      probe.GetEntry(0);
+      if(probe.type()>=100e3) isSignal = true;
+    }
   }
 
   string proc = "tt";
   if(Contains(file_name, "WJets")) proc = "wjets";
   else if(Contains(file_name, "QCD")) proc = "qcd";
-  //Need to improve to handle FullSim signal points
-  BTagWeighter btw(proc, isSignal, false);
 
   baby_corr c("", corr_file);
-  c.out_w_pdf().resize(100,0);
-  c.out_sys_isr().resize(2,0);
-  c.out_sys_lep().resize(2,0);
-  c.out_sys_fs_lep().resize(2,0);
-  c.out_sys_bctag_deep().resize(2,0);
-  c.out_sys_udsgtag_deep().resize(2,0);
-  c.out_sys_bchig_deep().resize(2,0);
-  c.out_sys_udsghig_deep().resize(2,0);
-  c.out_sys_mur().resize(2,0);
-  c.out_sys_muf().resize(2,0);
-  c.out_sys_murf().resize(2,0);
-  c.out_sys_fs_bctag_deep().resize(2,0);
-  c.out_sys_fs_udsgtag_deep().resize(2,0);
-  c.out_sys_fs_bchig_deep().resize(2,0);
-  c.out_sys_fs_udsghig_deep().resize(2,0);
-  c.out_sys_pu().resize(2,0);
-  c.out_sys_pdf().resize(2,0);
-  c.out_sys_bctag_loose_deep().resize(2,0);
-  c.out_sys_udsgtag_loose_deep().resize(2,0);
-  c.out_sys_bctag_tight_deep().resize(2,0);
-  c.out_sys_udsgtag_tight_deep().resize(2,0);
-
-  // quantities to keep track of;
-  int neff(0);
-  double wgt(0);
-
-  c.out_nent_zlep() = 0.;
-  c.out_tot_weight_l0() = 0.;
-  c.out_tot_weight_l1() = 0.;
-  c.out_nent() = b.GetEntries();
+  corrections::InitSums(c);
+  c.out_nent() = nent;
   cout<<"Running over "<<c.out_nent()<<" events."<<endl;
 
-  const string ctr = "central";
-  const string vup = "up";
-  const string vdown = "down";
-  const auto op_loose = BTagEntry::OP_LOOSE;
-  const auto op_med = BTagEntry::OP_MEDIUM;
-  const auto op_tight = BTagEntry::OP_TIGHT;
-  const vector<BTagEntry::OperatingPoint> op_all = {BTagEntry::OP_LOOSE, BTagEntry::OP_MEDIUM, BTagEntry::OP_TIGHT};
-
-  for(long entry(0); entry<c.out_nent(); ++entry){
-    b.GetEntry(entry);
-    if (entry%100000==0 || entry == c.out_nent()-1) {
-      cout<<"Processing event: "<<entry<<endl;
-    }
+  unique_ptr<WeightCacheWriter> cache;
+  if(weight_cache != ""){
+    cout << "Writing weight cache to: " << weight_cache << endl;
+    cache.reset(new WeightCacheWriter(weight_cache, corrections::CacheColumns(), nent));
+  }
 
-    float w_btag_deep = fix_b_wgt ? btw.EventWeight(b, op_med, ctr, ctr, true, false) : b.w_btag_deep();
-    float w_lep(1.), w_fs_lep(1.);
-    vector<float> sys_lep(2,1.), sys_fs_lep(2,1.);
-    if(fix_lep_wgt){
-      LeptonWeighter::FullSim(b, w_lep, sys_lep);
-      if(isSignal) LeptonWeighter::FastSim(b, w_fs_lep, sys_fs_lep);
-      b.out_w_lep() = w_lep;
-      b.out_sys_lep() = sys_lep;
-      b.out_w_fs_lep() = w_fs_lep;
-      b.out_sys_fs_lep() = sys_fs_lep;
-    }else{
-      w_lep = b.w_lep();
-      sys_lep = b.sys_lep();
-      if(isSignal){
-	    w_fs_lep = b.w_lep();
-	    sys_fs_lep = b.sys_fs_lep();
-      }
+  const LeptonWeighter &lw = GetLeptonWeighter();
+  if(threads <= 1){
+    baby_plus b(in_file, out_file, mode, corrections::calc_branches);
+    //Need to improve to handle FullSim signal points
+    BTagWeighter &btw = GetWeighter(proc, isSignal);
+    ProcessRange(b, btw, lw, c, cache.get(), isSignal, 0, nent);
+    b.Write();
+  }else{
+    // Each worker reads its own range and writes it to a part file, which are
+    // merged back in entry order; sums of weights are reduced at the end
+    ROOT::EnableThreadSafety();
+    vector<pair<long, long> > ranges = SplitRange(nent, threads);
+    cout<<"Splitting into "<<ranges.size()<<" threads."<<endl;
+    vector<string> parts;
+    vector<unique_ptr<baby_corr> > sums;
+    vector<exception_ptr> errors(ranges.size());
+    vector<thread> workers;
+    for(size_t i = 0; i < ranges.size(); ++i){
+      parts.push_back(PartFileName(out_file, i));
+      sums.push_back(unique_ptr<baby_corr>(new baby_corr("", "")));
+      corrections::InitSums(*sums.back());
     }
-
-    wgt = w_lep*(isSignal ? w_fs_lep : 1.)*
-          w_btag_deep*b.w_isr()*b.w_pu();
-
-    // need special treatment in summing and/or renormalizing
-    neff += b.w_lumi()>0 ? 1:-1;
-
-    c.out_w_isr() += b.w_isr();
-    for(size_t i = 0; i<b.sys_isr().size(); ++i){
-      c.out_sys_isr().at(i) += b.sys_isr().at(i);
+    for(size_t i = 0; i < ranges.size(); ++i){
+      workers.push_back(thread([&, i](){
+        try{
+          baby_plus b(in_file, parts.at(i), mode, corrections::calc_branches);
+          BTagWeighter btw(proc, isSignal, false, sf_grid_tolerance);
+          ProcessRange(b, btw, lw, *sums.at(i), cache.get(), isSignal, ranges.at(i).first, ranges.at(i).second);
+          b.Write();
+        }catch(...){
+          errors.at(i) = current_exception();
+        }
+      }));
     }
-
-    if(b.nleps()==0){
-      c.out_nent_zlep()     += 1.;
-      c.out_tot_weight_l0() += wgt;
-    }else{
-      c.out_tot_weight_l1() += wgt;
-      c.out_w_lep()         += w_lep;
-      for(size_t i = 0; i<b.sys_lep().size(); ++i){
-        c.out_sys_lep().at(i) += sys_lep.at(i);
-      }
-      if(isSignal){
-	c.out_w_fs_lep()      += w_fs_lep;
-	for(size_t i = 0; i<b.sys_fs_lep().size(); ++i){
-	  c.out_sys_fs_lep().at(i) += sys_fs_lep.at(i);
-	}
-      }
+    for(auto &worker: workers) worker.join();
+    for(const auto &error: errors){
+      if(error) rethrow_exception(error);
     }
-    
-    //      Cookie-cutter variables
-    //-----------------------------------
-    c.out_w_pu()             += b.w_pu();
-
-    double tmp = 0.;
-    
-    c.out_w_btag_deep()+= w_btag_deep; b.out_w_btag_deep() = w_btag_deep;
-
-    tmp = fix_b_wgt ? btw.EventWeight(b, op_all, ctr, ctr, true, false)        : b.w_bhig_deep();
-    c.out_w_bhig_deep()+= tmp; b.out_w_bhig_deep() = tmp;
-    
-    for(size_t i = 0; i<2; ++i){
-      tmp = fix_b_wgt ? btw.EventWeight(b, op_med, i==0 ? vup : vdown, ctr, true, false)        : b.sys_bctag_deep().at(i);
-      c.out_sys_bctag_deep().at(i)+= tmp; b.out_sys_bctag_deep().at(i) = tmp;
-      tmp = fix_b_wgt ? btw.EventWeight(b, op_med, ctr, i==0 ? vup : vdown, true, false)        : b.sys_udsgtag_deep().at(i);
-      c.out_sys_udsgtag_deep().at(i)+= tmp; b.out_sys_udsgtag_deep().at(i) = tmp;
-      
-      tmp = fix_b_wgt ? btw.EventWeight(b, op_all, i==0 ? vup : vdown, ctr, true, false)        : b.sys_bchig_deep().at(i);
-      c.out_sys_bchig_deep().at(i)+= tmp; b.out_sys_bchig_deep().at(i) = tmp;
-      tmp = fix_b_wgt ? btw.EventWeight(b, op_all, ctr, i==0 ? vup : vdown, true, false)        : b.sys_udsghig_deep().at(i);
-      c.out_sys_udsghig_deep().at(i)+= tmp; b.out_sys_udsghig_deep().at(i) = tmp;
-
-      if(isSignal){ // yes, this ignores the fullsim points
-        c.out_sys_mur().at(i)             += b.sys_mur().at(i);
-        c.out_sys_muf().at(i)             += b.sys_muf().at(i);
-        c.out_sys_murf().at(i)            += b.sys_murf().at(i);
-
-        tmp = fix_b_wgt ? btw.EventWeight(b, op_med, ctr, ctr, i==0 ? vup : vdown, ctr, true, false)  : b.sys_fs_bctag_deep().at(i);
-        c.out_sys_fs_bctag_deep().at(i)+= tmp; b.out_sys_fs_bctag_deep().at(i) = tmp;
-        tmp = fix_b_wgt ? btw.EventWeight(b, op_med, ctr, ctr, ctr, i==0 ? vup : vdown, true, false)  : b.sys_fs_udsgtag_deep().at(i);
-        c.out_sys_fs_udsgtag_deep().at(i)+= tmp; b.out_sys_fs_udsgtag_deep().at(i) = tmp;
-        tmp = fix_b_wgt ? btw.EventWeight(b, op_all, ctr, ctr, i==0 ? vup : vdown, ctr, false, false) : b.sys_fs_bchig_deep().at(i);
-        c.out_sys_fs_bchig_deep().at(i)+= tmp; b.out_sys_fs_bchig_deep().at(i) = tmp;
-        tmp = fix_b_wgt ? btw.EventWeight(b, op_all, ctr, ctr, i==0 ? vup : vdown, ctr, false, false) : b.sys_fs_udsghig_deep().at(i);
-        c.out_sys_fs_udsghig_deep().at(i)+= tmp; b.out_sys_fs_udsghig_deep().at(i) = tmp;
-      }
-    }
-
-    if(!quick){
-      tmp = fix_b_wgt ? btw.EventWeight(b, op_loose, ctr, ctr, true, false)        : b.w_btag_loose_deep();
-      c.out_w_btag_loose_deep()+= tmp; b.out_w_btag_loose_deep() = tmp;
-      tmp = fix_b_wgt ? btw.EventWeight(b, op_tight, ctr, ctr, true, false)        : b.w_btag_tight_deep();
-      c.out_w_btag_tight_deep()+= tmp; b.out_w_btag_tight_deep() = tmp;
-
-      for(size_t i = 0; i<b.w_pdf().size(); ++i){
-	    c.out_w_pdf().at(i) += b.w_pdf().at(i);
-      }
-
-      for(size_t i = 0; i<b.sys_mur().size(); ++i){
-        c.out_sys_pu().at(i)                      += b.sys_pu().at(i);
-	if(i < b.sys_pdf().size()){
-	  c.out_sys_pdf().at(i)                   += b.sys_pdf().at(i);
-	}
-
-        tmp = fix_b_wgt ? btw.EventWeight(b, op_loose, i==0 ? vup : vdown, ctr, true, false)        : b.sys_bctag_loose_deep().at(i);
-        c.out_sys_bctag_loose_deep().at(i)+= tmp; b.out_sys_bctag_loose_deep().at(i) = tmp;
-        tmp = fix_b_wgt ? btw.EventWeight(b, op_loose, ctr, i==0 ? vup : vdown, true, false)        : b.sys_udsgtag_loose_deep().at(i);
-        c.out_sys_udsgtag_loose_deep().at(i)+= tmp; b.out_sys_udsgtag_loose_deep().at(i) = tmp;
-        tmp = fix_b_wgt ? btw.EventWeight(b, op_tight, i==0 ? vup : vdown, ctr, true, false)        : b.sys_bctag_tight_deep().at(i);
-        c.out_sys_bctag_tight_deep().at(i)+= tmp; b.out_sys_bctag_tight_deep().at(i) = tmp;
-        tmp = fix_b_wgt ? btw.EventWeight(b, op_tight, ctr, i==0 ? vup : vdown, true, false)        : b.sys_udsgtag_tight_deep().at(i);
-        c.out_sys_udsgtag_tight_deep().at(i)+= tmp; b.out_sys_udsgtag_tight_deep().at(i) = tmp;
-      } // loop over 2 sys
-    } // if quick
-    b.Fill();
-  } // loop over events
-
-  c.out_neff() = neff;
+    for(const auto &sum: sums) c.Add(*sum);
+    MergeParts(parts, out_file);
+  }
 
   c.Fill();
   c.Write();
-  b.Write();
 
   cout<<endl;
   time(&endtime); 
   cout<<"Time passed: "<<hoursMinSec(difftime(endtime, begtime))<<endl<<endl;  
+  return 0;
+}
+
+void ProcessRange(baby_plus &b, BTagWeighter &btw, const LeptonWeighter &lw, baby_corr &c, WeightCacheWriter *cache,
+                  bool isSignal, long first, long last){
+  const bool has_shape_b_wgt = corrections::HasShapeBTag(b);
+  for(long entry(first); entry<last; ++entry){
+    b.GetEntry(entry);
+    if (entry%100000==0 || entry == last-1) {
+      cout<<"Processing event: "<<entry<<endl;
+    }
+
+    corrections::CalcEntry(b, btw, lw, c, isSignal, quick, fix_b_wgt, fix_lep_wgt, has_shape_b_wgt);
+    if(cache) corrections::WriteCache(b, *cache, entry);
+    b.Fill();
+  } // loop over events
 }
 
 void GetOptions(int argc, char *argv[]){
@@ -241,12 +209,20 @@ void GetOptions(int argc, char *argv[]){
       {"keep_b_wgt", no_argument, 0, 0},       // Use existing b-tag weights/systematics instead of applying new SFs
       {"keep_lep_wgt", no_argument, 0, 0},     // Use existing lepton weights/systematics instead of applying new SFs
       {"quick", no_argument, 0, 0},            // Leave less important variables uncorrected
+      {"fast_clone", no_argument, 0, 0},       // Copy untouched branches without decompressing them
+      {"delta", no_argument, 0, 0},            // Write only modified branches, to be read as a friend of the input
+      {"sf_grid", required_argument, 0, 0},    // Interpolate b-tag SFs tabulated every GeV where within this tolerance
+      {"lep_sf_set", required_argument, 0, 0}, // Apply new lepton SFs, with the tables listed in this file replacing the default ones
+      {"threads", required_argument, 0, 't'},  // Number of threads over which to split the events
+      {"weight_cache", required_argument, 0, 'w'}, // Also write the new per-event weights to this columnar file
+      {"serve", required_argument, 0, 0},      // Run jobs sent to this Unix socket by python/corr_client.py
+      {"workers", required_argument, 0, 0},    // Maximum number of jobs the server runs at once
       {0, 0, 0, 0}
     };
 
     char opt = -1;
     int option_index;
-    opt = getopt_long(argc, argv, "f:c:o:", long_options, &option_index);
+    opt = getopt_long(argc, argv, "f:c:o:t:w:", long_options, &option_index);
     if(opt == -1) break;
 
     string optname;
@@ -260,6 +236,12 @@ void GetOptions(int argc, char *argv[]){
     case 'o':
       out_dir = optarg;
       break;
+    case 't':
+      threads = atoi(optarg);
+      break;
+    case 'w':
+      weight_cache = optarg;
+      break;
     case 0:
       optname = long_options[option_index].name;
       if(optname == "quick"){
@@ -268,6 +250,19 @@ void GetOptions(int argc, char *argv[]){
         fix_b_wgt = false;
       }else if(optname == "keep_lep_wgt"){
         fix_lep_wgt = false;
+      }else if(optname == "fast_clone"){
+        fast_clone = true;
+      }else if(optname == "delta"){
+        delta = true;
+      }else if(optname == "sf_grid"){
+        sf_grid_tolerance = atof(optarg);
+      }else if(optname == "lep_sf_set"){
+        fix_lep_wgt = true;
+        lep_sf_set = optarg;
+      }else if(optname == "serve"){
+        serve_socket = optarg;
+      }else if(optname == "workers"){
+        server_workers = atoi(optarg);
       }else{
         printf("Bad option! Found option name %s\n", optname.c_str());
         exit(1);
@@ -0,0 +1,421 @@
+//----------------------------------------------------------------------------
+// calib_bundle - Calibration inputs of data/ preprocessed into one binary file
+//----------------------------------------------------------------------------
+
+#include "calib_bundle.hpp"
+
+#include <cstdio>
+#include <cstring>
+
+#include <algorithm>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <stdexcept>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "TAxis.h"
+#include "TH1.h"
+
+#include "utilities.hpp"
+
+using namespace std;
+
+namespace{
+  const char magic[8] = {'C', 'A', 'L', 'I', 'B', 'B', 'N', 'D'};
+  const uint32_t version = 1;
+  const size_t key_size = 128;
+
+  enum Kind{kBTagCsv = 1, kHist = 2};
+
+  struct Header{
+    char magic[8];
+    uint32_t version;
+    uint32_t nsources;
+    uint32_t nrecords;
+    uint32_t unused;
+    uint64_t payload_offset;
+    uint64_t payload_size;
+    uint64_t checksum;
+  };
+
+  struct SourceEntry{
+    char path[key_size];
+    uint64_t size;
+    int64_t mtime;
+    uint64_t hash;
+  };
+
+  struct RecordEntry{
+    char key[key_size];
+    uint32_t kind;
+    uint32_t unused;
+    uint64_t offset;
+    uint64_t size;
+  };
+
+  // Followed by the string pool; strings are offsets into it
+  struct PackedBTagEntry{
+    int32_t op, flavor;
+    float eta_min, eta_max, pt_min, pt_max, discr_min, discr_max;
+    uint32_t measurement, sys, formula, unused;
+  };
+
+  // Followed by the edges of the variable axes, then contents and errors
+  struct PackedAxis{
+    int32_t nbins, variable;
+    double min, max;
+  };
+  struct PackedHist{
+    int32_t ndim, unused;
+    PackedAxis axes[3];
+  };
+
+  uint64_t Fnv1a(const char *data, size_t size, uint64_t hash = UINT64_C(14695981039346656037)){
+    for(size_t i = 0; i < size; ++i){
+      hash ^= static_cast<unsigned char>(data[i]);
+      hash *= UINT64_C(1099511628211);
+    }
+    return hash;
+  }
+
+  template<typename T>
+    void Append(vector<char> &buffer, const T &value){
+    const char *bytes = reinterpret_cast<const char*>(&value);
+    buffer.insert(buffer.end(), bytes, bytes+sizeof(T));
+  }
+
+  void Align(vector<char> &buffer){
+    buffer.resize(((buffer.size()+7)/8)*8, 0);
+  }
+
+  Header ReadHeader(const char *map){
+    Header header;
+    memcpy(&header, map, sizeof(Header));
+    return header;
+  }
+
+  const SourceEntry * Sources(const char *map){
+    return reinterpret_cast<const SourceEntry*>(map + sizeof(Header));
+  }
+
+  const RecordEntry * Records(const char *map){
+    return reinterpret_cast<const RecordEntry*>(map + sizeof(Header)
+                                                + ReadHeader(map).nsources*sizeof(SourceEntry));
+  }
+
+  void CopyKey(char *dest, const string &key){
+    if(key.size() >= key_size) ERROR("Calibration bundle key "+key+" is too long");
+    memset(dest, 0, key_size);
+    memcpy(dest, key.c_str(), key.size());
+  }
+
+  unique_ptr<CalibBundle> OpenDefault(){
+    const string &path = CalibBundle::DefaultPath();
+    if(access(path.c_str(), F_OK) != 0) return unique_ptr<CalibBundle>();
+    unique_ptr<CalibBundle> bundle;
+    try{
+      bundle.reset(new CalibBundle(path));
+    }catch(const runtime_error &e){
+      cerr << e.what() << "\nReading the calibration source files instead." << endl;
+      return unique_ptr<CalibBundle>();
+    }
+    if(!bundle->IsCurrent()){
+      cerr << "Calibration bundle " << path << " is out of date. Reading the calibration source files instead;"
+           << " rebuild it with run/build_calib_bundle.exe." << endl;
+      return unique_ptr<CalibBundle>();
+    }
+    return bundle;
+  }
+}
+
+const string & CalibBundle::DefaultPath(){
+  static const string path = "data/calib_bundle.bin";
+  return path;
+}
+
+const CalibBundle * CalibBundle::Default(){
+  static const unique_ptr<CalibBundle> bundle = OpenDefault();
+  return bundle.get();
+}
+
+CalibBundle::CalibBundle(const string &path):
+  path_(path),
+  size_(0),
+  map_(nullptr){
+  int fd = open(path.c_str(), O_RDONLY);
+  if(fd < 0) ERROR("Could not open calibration bundle "+path);
+  struct stat st;
+  if(fstat(fd, &st) != 0 || static_cast<size_t>(st.st_size) < sizeof(Header)){
+    close(fd);
+    ERROR("Calibration bundle "+path+" is truncated");
+  }
+  size_ = st.st_size;
+  void *mapped = mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd, 0);
+  close(fd);
+  if(mapped == MAP_FAILED) ERROR("Could not map calibration bundle "+path);
+  map_ = static_cast<char*>(mapped);
+
+  Header header = ReadHeader(map_);
+  if(memcmp(header.magic, magic, sizeof(magic)) != 0 || header.version != version){
+    munmap(map_, size_);
+    ERROR(path+" is not a version "+to_string(version)+" calibration bundle");
+  }
+  if(header.payload_offset != sizeof(Header) + header.nsources*sizeof(SourceEntry) + header.nrecords*sizeof(RecordEntry)
+     || header.payload_offset + header.payload_size != size_){
+    munmap(map_, size_);
+    ERROR("Size of calibration bundle "+path+" does not match its header");
+  }
+  if(Fnv1a(map_ + sizeof(Header), size_ - sizeof(Header)) != header.checksum){
+    munmap(map_, size_);
+    ERROR("Calibration bundle "+path+" is corrupt (checksum mismatch)");
+  }
+}
+
+CalibBundle::~CalibBundle(){
+  munmap(map_, size_);
+}
+
+bool CalibBundle::IsCurrent() const{
+  Header header = ReadHeader(map_);
+  const SourceEntry *sources = Sources(map_);
+  for(size_t i = 0; i < header.nsources; ++i){
+    const SourceEntry &source = sources[i];
+    string path(source.path, strnlen(source.path, key_size));
+    struct stat st;
+    if(stat(path.c_str(), &st) != 0 || static_cast<uint64_t>(st.st_size) != source.size) return false;
+    if(static_cast<int64_t>(st.st_mtime) != source.mtime && HashFile(path) != source.hash) return false;
+  }
+  return true;
+}
+
+const char * CalibBundle::FindRecord(const string &key, uint32_t kind, uint64_t &size) const{
+  Header header = ReadHeader(map_);
+  const RecordEntry *begin = Records(map_), *end = begin + header.nrecords;
+  const RecordEntry *record = lower_bound(begin, end, key, [](const RecordEntry &r, const string &k){
+      return strncmp(r.key, k.c_str(), key_size) < 0;
+    });
+  if(record == end || strncmp(record->key, key.c_str(), key_size) != 0 || record->kind != kind) return nullptr;
+  size = record->size;
+  return map_ + header.payload_offset + record->offset;
+}
+
+unique_ptr<BTagCalibration> CalibBundle::Calibration(const string &tagger, const string &csv_file) const{
+  uint64_t size;
+  const char *payload = FindRecord("btag_csv:"+csv_file, kBTagCsv, size);
+  if(payload == nullptr) return unique_ptr<BTagCalibration>();
+
+  uint64_t nentries = 0;
+  if(size >= sizeof(nentries)) memcpy(&nentries, payload, sizeof(nentries));
+  if(size < sizeof(nentries) || (size-sizeof(nentries))/sizeof(PackedBTagEntry) < nentries){
+    ERROR("Record of "+csv_file+" in calibration bundle "+path_+" is too short for its entries");
+  }
+  const PackedBTagEntry *entries = reinterpret_cast<const PackedBTagEntry*>(payload + sizeof(nentries));
+  const char *pool = payload + sizeof(nentries) + nentries*sizeof(PackedBTagEntry);
+  unique_ptr<BTagCalibration> calib(new BTagCalibration(tagger));
+  for(size_t i = 0; i < nentries; ++i){
+    const PackedBTagEntry &packed = entries[i];
+    // Formulas were checked when the bundle was built
+    BTagEntry entry;
+    entry.formula = pool + packed.formula;
+    entry.params = BTagEntry::Parameters(static_cast<BTagEntry::OperatingPoint>(packed.op),
+                                         pool + packed.measurement, pool + packed.sys,
+                                         static_cast<BTagEntry::JetFlavor>(packed.flavor),
+                                         packed.eta_min, packed.eta_max,
+                                         packed.pt_min, packed.pt_max,
+                                         packed.discr_min, packed.discr_max);
+    calib->addEntry(entry);
+  }
+  return calib;
+}
+
+bool CalibBundle::FindHist(const string &root_file, const string &name, Hist &hist) const{
+  uint64_t size;
+  const char *payload = FindRecord("hist:"+root_file+":"+name, kHist, size);
+  if(payload == nullptr) return false;
+
+  // The record must hold exactly the edges, contents and errors its axes call for
+  const string error = "Record of "+name+" from "+root_file+" in calibration bundle "+path_+" is malformed";
+  PackedHist packed;
+  if(size < sizeof(PackedHist)) ERROR(error);
+  memcpy(&packed, payload, sizeof(PackedHist));
+  if(packed.ndim < 1 || packed.ndim > 3) ERROR(error);
+  const double *data = reinterpret_cast<const double*>(payload + sizeof(PackedHist));
+  uint64_t ncells = 1, nvalues = 0;
+  hist.ndim = packed.ndim;
+  for(int i = 0; i < 3; ++i){
+    Axis &axis = hist.axes[i];
+    axis.nbins = packed.axes[i].nbins;
+    axis.min = packed.axes[i].min;
+    axis.max = packed.axes[i].max;
+    axis.edges = nullptr;
+    if(i >= packed.ndim) continue;
+    if(axis.nbins < 1) ERROR(error);
+    ncells *= axis.nbins+2;
+    if(packed.axes[i].variable){
+      axis.edges = data + nvalues;
+      nvalues += axis.nbins+1;
+    }
+  }
+  nvalues += 2*ncells;
+  if(size != sizeof(PackedHist) + nvalues*sizeof(double)) ERROR(error);
+  hist.content = data + (nvalues - 2*ncells);
+  hist.errors = hist.content + ncells;
+  return true;
+}
+
+uint64_t CalibBundle::HashFile(const string &path){
+  ifstream file(path.c_str(), ios::binary);
+  if(!file.good()) ERROR("Could not open "+path);
+  uint64_t hash = Fnv1a(nullptr, 0);
+  vector<char> buffer(1 << 16);
+  while(file){
+    file.read(buffer.data(), buffer.size());
+    hash = Fnv1a(buffer.data(), file.gcount(), hash);
+  }
+  return hash;
+}
+
+CalibBundleWriter::CalibBundleWriter():
+  sources_(),
+  records_(){
+}
+
+void CalibBundleWriter::AddSource(const string &path){
+  struct stat st;
+  if(stat(path.c_str(), &st) != 0) ERROR("Could not stat "+path);
+  Source source;
+  source.path = path;
+  source.size = st.st_size;
+  source.mtime = st.st_mtime;
+  source.hash = CalibBundle::HashFile(path);
+  sources_.push_back(source);
+}
+
+void CalibBundleWriter::AddCalibration(const string &csv_file, const vector<BTagEntry> &entries){
+  string pool;
+  map<string, uint32_t> offsets;
+  auto intern = [&](const string &text){
+    auto it = offsets.find(text);
+    if(it != offsets.end()) return it->second;
+    uint32_t offset = pool.size();
+    pool += text;
+    pool += '\0';
+    offsets[text] = offset;
+    return offset;
+  };
+
+  Record record;
+  record.key = "btag_csv:"+csv_file;
+  record.kind = kBTagCsv;
+  Append(record.payload, static_cast<uint64_t>(entries.size()));
+  for(const auto &entry: entries){
+    const BTagEntry::Parameters &par = entry.params;
+    PackedBTagEntry packed;
+    packed.op = par.operatingPoint;
+    packed.flavor = par.jetFlavor;
+    packed.eta_min = par.etaMin;
+    packed.eta_max = par.etaMax;
+    packed.pt_min = par.ptMin;
+    packed.pt_max = par.ptMax;
+    packed.discr_min = par.discrMin;
+    packed.discr_max = par.discrMax;
+    packed.measurement = intern(par.measurementType);
+    packed.sys = intern(par.sysType);
+    packed.formula = intern(entry.formula);
+    packed.unused = 0;
+    Append(record.payload, packed);
+  }
+  record.payload.insert(record.payload.end(), pool.begin(), pool.end());
+  Align(record.payload);
+  records_.push_back(record);
+}
+
+void CalibBundleWriter::AddHist(const string &root_file, const string &name, const TH1 &hist){
+  const TAxis *axes[3] = {hist.GetXaxis(), hist.GetYaxis(), hist.GetZaxis()};
+  PackedHist packed;
+  memset(&packed, 0, sizeof(PackedHist));
+  packed.ndim = hist.GetDimension();
+  vector<double> edges;
+  size_t ncells = 1;
+  for(int i = 0; i < packed.ndim; ++i){
+    const TAxis &axis = *axes[i];
+    PackedAxis &packed_axis = packed.axes[i];
+    packed_axis.nbins = axis.GetNbins();
+    packed_axis.variable = axis.IsVariableBinSize();
+    packed_axis.min = axis.GetXmin();
+    packed_axis.max = axis.GetXmax();
+    ncells *= packed_axis.nbins+2;
+    if(packed_axis.variable){
+      const double *bins = axis.GetXbins()->GetArray();
+      edges.insert(edges.end(), bins, bins+packed_axis.nbins+1);
+    }
+  }
+
+  Record record;
+  record.key = "hist:"+root_file+":"+name;
+  record.kind = kHist;
+  Append(record.payload, packed);
+  for(double edge: edges) Append(record.payload, edge);
+  for(size_t bin = 0; bin < ncells; ++bin) Append(record.payload, hist.GetBinContent(bin));
+  for(size_t bin = 0; bin < ncells; ++bin) Append(record.payload, hist.GetBinError(bin));
+  records_.push_back(record);
+}
+
+void CalibBundleWriter::Write(const string &path) const{
+  vector<const Record*> records;
+  for(const auto &record: records_) records.push_back(&record);
+  sort(records.begin(), records.end(), [](const Record *a, const Record *b){return a->key < b->key;});
+  for(size_t i = 1; i < records.size(); ++i){
+    if(records.at(i)->key == records.at(i-1)->key) ERROR("Duplicate calibration bundle key "+records.at(i)->key);
+  }
+
+  Header header;
+  memcpy(header.magic, magic, sizeof(magic));
+  header.version = version;
+  header.nsources = sources_.size();
+  header.nrecords = records.size();
+  header.unused = 0;
+  header.payload_offset = sizeof(Header) + sources_.size()*sizeof(SourceEntry) + records.size()*sizeof(RecordEntry);
+
+  vector<char> buffer(sizeof(Header));
+  for(const auto &source: sources_){
+    SourceEntry entry;
+    CopyKey(entry.path, source.path);
+    entry.size = source.size;
+    entry.mtime = source.mtime;
+    entry.hash = source.hash;
+    Append(buffer, entry);
+  }
+  uint64_t offset = 0;
+  for(const auto record: records){
+    RecordEntry entry;
+    CopyKey(entry.key, record->key);
+    entry.kind = record->kind;
+    entry.unused = 0;
+    entry.offset = offset;
+    entry.size = record->payload.size();
+    Append(buffer, entry);
+    offset += record->payload.size();
+  }
+  for(const auto record: records){
+    buffer.insert(buffer.end(), record->payload.begin(), record->payload.end());
+  }
+  header.payload_size = offset;
+  header.checksum = Fnv1a(buffer.data() + sizeof(Header), buffer.size() - sizeof(Header));
+  memcpy(buffer.data(), &header, sizeof(Header));
+
+  string tmp_path = path+".tmp"+to_string(getpid());
+  ofstream file(tmp_path.c_str(), ios::binary | ios::trunc);
+  if(!file.good()) ERROR("Could not create "+tmp_path);
+  file.write(buffer.data(), buffer.size());
+  file.close();
+  if(!file.good() || rename(tmp_path.c_str(), path.c_str()) != 0){
+    remove(tmp_path.c_str());
+    ERROR("Could not write calibration bundle "+path);
+  }
+}
@@ -0,0 +1,145 @@
+// check_btag_kernel: checks that every version of BTagJetWeights the CPU
+// supports gives bit for bit the results and fallback count of the scalar
+// version, on random jets of every length up to a few vectors and a long
+// array; exits with 1 on the first difference
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <cmath>
+
+#include <iostream>
+#include <limits>
+#include <random>
+#include <string>
+#include <vector>
+
+#include <getopt.h>
+
+#include "btag_jet_weight.hpp"
+
+using namespace std;
+
+namespace {
+  unsigned seed = 1;
+  size_t ntrials = 1000;
+}
+
+void GetOptions(int argc, char *argv[]);
+
+struct Jets{
+  explicit Jets(size_t n):
+    eff1(n), eff2(n), sf1(n), sf2(n), sf1_fs(n), sf2_fs(n){
+  }
+
+  vector<double> eff1, eff2, sf1, sf2, sf1_fs, sf2_fs;
+};
+
+Jets RandomJets(size_t n, mt19937_64 &rng);
+bool SameResults(const string &isa, const Jets &jets);
+
+int main(int argc, char *argv[]){
+  GetOptions(argc, argv);
+
+  cout << "BTagJetWeights uses " << BTagJetWeightsISA() << endl;
+  mt19937_64 rng(seed);
+  uniform_int_distribution<size_t> short_length(0, 33);
+  for(const string isa: {"avx2", "avx512f"}){
+    if(!BTagJetWeightsSupported(isa)){
+      cout << isa << " not supported here, skipped" << endl;
+      continue;
+    }
+    for(size_t trial = 0; trial < ntrials; ++trial){
+      if(!SameResults(isa, RandomJets(short_length(rng), rng))) return EXIT_FAILURE;
+    }
+    if(!SameResults(isa, RandomJets(100003, rng))) return EXIT_FAILURE;
+    cout << isa << " matches scalar" << endl;
+  }
+}
+
+Jets RandomJets(size_t n, mt19937_64 &rng){
+  uniform_real_distribution<double> eff(0., 1.), sf(0.5, 1.5);
+  uniform_int_distribution<int> special(0, 19);
+  Jets jets(n);
+  for(size_t i = 0; i < n; ++i){
+    jets.eff1[i] = eff(rng);
+    jets.eff2[i] = eff(rng);
+    jets.sf1[i] = sf(rng);
+    jets.sf2[i] = sf(rng);
+    jets.sf1_fs[i] = sf(rng);
+    jets.sf2_fs[i] = sf(rng);
+    // Degenerate jets, giving 0/0, x/0 or NaN inputs, which fall back to 1
+    switch(special(rng)){
+    case 0:
+      jets.eff2[i] = jets.eff1[i];
+      jets.sf2_fs[i] = jets.sf1_fs[i];
+      break;
+    case 1:
+      jets.eff1[i] = jets.eff2[i] = 0.;
+      break;
+    case 2:
+      jets.sf1_fs[i] = 0.;
+      break;
+    case 3:
+      jets.sf2[i] = numeric_limits<double>::quiet_NaN();
+      break;
+    default:
+      break;
+    }
+  }
+  return jets;
+}
+
+bool SameResults(const string &isa, const Jets &jets){
+  size_t n = jets.eff1.size();
+  vector<double> expected(n), result(n);
+  size_t nexpected = BTagJetWeightsWith("scalar", n, jets.eff1.data(), jets.eff2.data(),
+                                        jets.sf1.data(), jets.sf2.data(),
+                                        jets.sf1_fs.data(), jets.sf2_fs.data(), expected.data());
+  size_t nfallback = BTagJetWeightsWith(isa, n, jets.eff1.data(), jets.eff2.data(),
+                                        jets.sf1.data(), jets.sf2.data(),
+                                        jets.sf1_fs.data(), jets.sf2_fs.data(), result.data());
+  if(nfallback != nexpected){
+    cout << isa << " replaced " << nfallback << " results by 1 instead of " << nexpected
+         << " for " << n << " jets" << endl;
+    return false;
+  }
+  for(size_t i = 0; i < n; ++i){
+    if(memcmp(&result[i], &expected[i], sizeof(double)) != 0){
+      cout.precision(17);
+      cout << isa << " gives " << result[i] << " instead of " << expected[i]
+           << " for jet " << i << " of " << n << ": eff " << jets.eff1[i] << ", " << jets.eff2[i]
+           << ", sf " << jets.sf1[i] << ", " << jets.sf2[i]
+           << ", fastsim sf " << jets.sf1_fs[i] << ", " << jets.sf2_fs[i] << endl;
+      return false;
+    }
+  }
+  return true;
+}
+
+void GetOptions(int argc, char *argv[]){
+  while(true){
+    static struct option long_options[] = {
+      {"seed", required_argument, 0, 's'},   // Seed of the random jets
+      {"trials", required_argument, 0, 'n'}, // Number of short arrays per version
+      {0, 0, 0, 0}
+    };
+
+    char opt = -1;
+    int option_index;
+    opt = getopt_long(argc, argv, "s:n:", long_options, &option_index);
+    if(opt == -1) break;
+
+    switch(opt){
+    case 's':
+      seed = atoi(optarg);
+      break;
+    case 'n':
+      ntrials = atoi(optarg);
+      break;
+    default:
+      printf("Bad option! getopt_long returned character code 0%o\n", opt);
+      break;
+    }
+  }
+}
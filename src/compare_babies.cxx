@@ -0,0 +1,176 @@
+// compare_babies: compares the trees of two files entry by entry, e.g. the
+// outputs of calc_corr or apply_corr with and without --threads, or before
+// and after a change. Every branch in both trees is compared value by value;
+// exits with 1 if the entries, the branches or any value differ
+
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+
+#include <algorithm>
+#include <iostream>
+#include <set>
+#include <string>
+
+#include <getopt.h>
+
+#include "TError.h"
+#include "TFile.h"
+#include "TObjArray.h"
+#include "TTree.h"
+#include "TTreeFormula.h"
+
+#include "utilities.hpp"
+
+using namespace std;
+
+namespace {
+  string tree_name = "tree";
+  double tolerance = 0.;
+  string file_a = "", file_b = "";
+}
+
+void GetOptions(int argc, char *argv[]);
+
+set<string> BranchNames(TTree &tree);
+bool SameValues(double a, double b);
+bool CompareBranch(const string &branch, TTree &tree_a, TTree &tree_b);
+
+int main(int argc, char *argv[]){
+  gErrorIgnoreLevel = 6000;
+  GetOptions(argc, argv);
+  if(file_a == "" || file_b == "") ERROR("Usage: compare_babies.exe [-t tree] [-r tolerance] file_a file_b");
+
+  TFile tfile_a(file_a.c_str(), "read"), tfile_b(file_b.c_str(), "read");
+  if(!tfile_a.IsOpen() || tfile_a.IsZombie()) ERROR("Could not open "+file_a);
+  if(!tfile_b.IsOpen() || tfile_b.IsZombie()) ERROR("Could not open "+file_b);
+  TTree *tree_a = nullptr, *tree_b = nullptr;
+  tfile_a.GetObject(tree_name.c_str(), tree_a);
+  tfile_b.GetObject(tree_name.c_str(), tree_b);
+  if(tree_a == nullptr) ERROR("No tree "+tree_name+" in "+file_a);
+  if(tree_b == nullptr) ERROR("No tree "+tree_name+" in "+file_b);
+
+  bool same = true;
+  if(tree_a->GetEntries() != tree_b->GetEntries()){
+    cout << file_a << " has " << tree_a->GetEntries() << " entries, "
+         << file_b << " " << tree_b->GetEntries() << endl;
+    same = false;
+  }
+
+  set<string> branches_a = BranchNames(*tree_a), branches_b = BranchNames(*tree_b);
+  for(const auto &branch: branches_a){
+    if(!branches_b.count(branch)){
+      cout << "Branch " << branch << " only in " << file_a << endl;
+      same = false;
+    }
+  }
+  for(const auto &branch: branches_b){
+    if(!branches_a.count(branch)){
+      cout << "Branch " << branch << " only in " << file_b << endl;
+      same = false;
+    }
+  }
+
+  size_t ncompared = 0;
+  if(tree_a->GetEntries() == tree_b->GetEntries()){
+    for(const auto &branch: branches_a){
+      if(!branches_b.count(branch)) continue;
+      if(!CompareBranch(branch, *tree_a, *tree_b)) same = false;
+      ++ncompared;
+    }
+  }
+
+  cout << "Compared " << ncompared << " branches of " << tree_a->GetEntries() << " entries: "
+       << (same ? "same" : "different") << endl;
+  return same ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+set<string> BranchNames(TTree &tree){
+  set<string> names;
+  TObjArray *branches = tree.GetListOfBranches();
+  for(int i = 0; branches != nullptr && i < branches->GetEntriesFast(); ++i){
+    names.insert(branches->At(i)->GetName());
+  }
+  return names;
+}
+
+bool SameValues(double a, double b){
+  if(std::isnan(a) || std::isnan(b)) return std::isnan(a) && std::isnan(b);
+  if(a == b) return true;
+  return fabs(a-b) <= tolerance*max(fabs(a), fabs(b));
+}
+
+bool CompareBranch(const string &branch, TTree &tree_a, TTree &tree_b){
+  // One formula per tree evaluates the branch, scalar or vector, as doubles
+  // or, for string branches, as text
+  TTreeFormula formula_a(("a_"+branch).c_str(), branch.c_str(), &tree_a);
+  TTreeFormula formula_b(("b_"+branch).c_str(), branch.c_str(), &tree_b);
+  if(formula_a.GetNdim() == 0 || formula_b.GetNdim() == 0){
+    cout << "Branch " << branch << " cannot be evaluated, skipped" << endl;
+    return true;
+  }
+  bool is_string = formula_a.IsString();
+  if(is_string != formula_b.IsString()){
+    cout << "Branch " << branch << " is a string in only one file" << endl;
+    return false;
+  }
+
+  Long64_t ndiff = 0, first_diff = -1;
+  double max_diff = 0.;
+  for(Long64_t entry = 0; entry < tree_a.GetEntries(); ++entry){
+    tree_a.LoadTree(entry);
+    tree_b.LoadTree(entry);
+    int n = formula_a.GetNdata();
+    bool same = n == formula_b.GetNdata();
+    for(int i = 0; same && i < n; ++i){
+      if(is_string){
+        same = string(formula_a.EvalStringInstance(i)) == formula_b.EvalStringInstance(i);
+      }else{
+        double a = formula_a.EvalInstance(i), b = formula_b.EvalInstance(i);
+        same = SameValues(a, b);
+        if(!same) max_diff = max(max_diff, fabs(a-b)/max(fabs(a), fabs(b)));
+      }
+    }
+    if(!same){
+      if(first_diff < 0) first_diff = entry;
+      ++ndiff;
+    }
+  }
+
+  if(ndiff == 0) return true;
+  cout << "Branch " << branch << " differs in " << ndiff << " entries, first " << first_diff;
+  if(!is_string && max_diff > 0.) cout << ", by up to " << max_diff << " relative";
+  cout << endl;
+  return false;
+}
+
+void GetOptions(int argc, char *argv[]){
+  while(true){
+    static struct option long_options[] = {
+      {"tree", required_argument, 0, 't'},      // Name of the tree in both files
+      {"tolerance", required_argument, 0, 'r'}, // Largest relative difference of values taken as the same; 0 for exact
+      {0, 0, 0, 0}
+    };
+
+    char opt = -1;
+    int option_index;
+    opt = getopt_long(argc, argv, "t:r:", long_options, &option_index);
+    if(opt == -1) break;
+
+    switch(opt){
+    case 't':
+      tree_name = optarg;
+      break;
+    case 'r':
+      tolerance = atof(optarg);
+      break;
+    default:
+      printf("Bad option! getopt_long returned character code 0%o\n", opt);
+      break;
+    }
+  }
+  if(optind+2 == argc){
+    file_a = argv[optind];
+    file_b = argv[optind+1];
+  }
+}
@@ -0,0 +1,267 @@
+//----------------------------------------------------------------------------
+// corr_server - Local prefork server running one job per connection
+//----------------------------------------------------------------------------
+
+#include "corr_server.hpp"
+
+#include <csignal>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <cerrno>
+
+#include <iostream>
+#include <set>
+#include <stdexcept>
+
+#include <getopt.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include "utilities.hpp"
+
+using namespace std;
+
+namespace{
+  volatile sig_atomic_t stop_requested = 0;
+
+  void RequestStop(int){
+    stop_requested = 1;
+  }
+
+  void Wakeup(int){
+  }
+
+  void SetHandler(int sig, void (*handler)(int)){
+    struct sigaction action;
+    memset(&action, 0, sizeof(action));
+    action.sa_handler = handler;
+    sigemptyset(&action.sa_mask);
+    action.sa_flags = 0; // No SA_RESTART, so poll returns on signals
+    if(sigaction(sig, &action, nullptr) != 0) ERROR("sigaction failed: "+string(strerror(errno)));
+  }
+
+  // False if the client is gone
+  bool WriteAll(int fd, const string &data){
+    size_t done = 0;
+    while(done < data.size()){
+      ssize_t n = write(fd, data.data()+done, data.size()-done);
+      if(n < 0 && errno == EINTR) continue;
+      if(n <= 0) return false;
+      done += n;
+    }
+    return true;
+  }
+
+  string EncodeSize(size_t size){
+    string encoded(4, '\0');
+    for(size_t i = 0; i < 4; ++i) encoded[i] = static_cast<char>((size >> (24-8*i)) & 0xff);
+    return encoded;
+  }
+
+  bool WriteFrame(int fd, char type, const string &payload){
+    return WriteAll(fd, string(1, type)+EncodeSize(payload.size())+payload);
+  }
+
+  // Throws if the client hangs up before n bytes
+  string ReadExact(int fd, size_t n){
+    string data(n, '\0');
+    size_t done = 0;
+    while(done < n){
+      ssize_t nread = read(fd, &data[done], n-done);
+      if(nread < 0 && errno == EINTR) continue;
+      if(nread <= 0) ERROR("Incomplete request");
+      done += nread;
+    }
+    return data;
+  }
+
+  size_t ReadSize(int fd){
+    string encoded = ReadExact(fd, 4);
+    size_t size = 0;
+    for(char c: encoded) size = (size << 8) | static_cast<unsigned char>(c);
+    return size;
+  }
+
+  // Field count, then each field as its size and bytes
+  vector<string> ReadRequest(int fd){
+    const size_t max_size = 1 << 20;
+    size_t nfields = ReadSize(fd);
+    if(nfields > max_size/4) ERROR("Request too long");
+    vector<string> fields;
+    size_t total = 0;
+    for(size_t ifield = 0; ifield < nfields; ++ifield){
+      size_t size = ReadSize(fd);
+      total += 4+size;
+      if(total > max_size) ERROR("Request too long");
+      fields.push_back(ReadExact(fd, size));
+    }
+    return fields;
+  }
+
+  int Listen(const string &socket_path){
+    struct sockaddr_un addr;
+    memset(&addr, 0, sizeof(addr));
+    addr.sun_family = AF_UNIX;
+    if(socket_path.size() >= sizeof(addr.sun_path)) ERROR("Socket path too long: "+socket_path);
+    strncpy(addr.sun_path, socket_path.c_str(), sizeof(addr.sun_path)-1);
+
+    // A socket left behind by a server that did not shut down cleanly
+    struct stat st;
+    if(lstat(socket_path.c_str(), &st) == 0){
+      if(!S_ISSOCK(st.st_mode)) ERROR(socket_path+" exists and is not a socket");
+      unlink(socket_path.c_str());
+    }
+
+    int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+    if(fd < 0) ERROR("Could not create socket: "+string(strerror(errno)));
+    if(bind(fd, reinterpret_cast<struct sockaddr*>(&addr), sizeof(addr)) != 0
+       || listen(fd, SOMAXCONN) != 0){
+      string error = strerror(errno);
+      close(fd);
+      ERROR("Could not listen on "+socket_path+": "+error);
+    }
+    return fd;
+  }
+
+  void RunJob(int output, const vector<string> &fields, const ServerJob &job){
+    int status = 1;
+    try{
+      dup2(output, STDOUT_FILENO);
+      dup2(output, STDERR_FILENO);
+      close(output);
+      if(chdir(fields.front().c_str()) != 0) ERROR("Could not change directory to "+fields.front());
+      status = job(vector<string>(fields.begin()+1, fields.end()));
+    }catch(const exception &e){
+      cerr << e.what() << endl;
+    }
+    cout.flush();
+    cerr.flush();
+    exit(status);
+  }
+
+  // Runs the job in its own process and relays its output, so the exit status
+  // frame always follows all of it
+  void RunWorker(int listen_fd, int conn, const ServerJob &job){
+    close(listen_fd);
+    signal(SIGINT, SIG_DFL);
+    signal(SIGTERM, SIG_DFL);
+    signal(SIGCHLD, SIG_DFL);
+
+    int status = 1;
+    try{
+      vector<string> fields = ReadRequest(conn);
+      if(fields.size() < 2) ERROR("Request needs a working directory and a program name");
+      int output[2];
+      if(pipe(output) != 0) ERROR("pipe failed: "+string(strerror(errno)));
+      fflush(nullptr);
+      cout.flush();
+      cerr.flush();
+      pid_t pid = fork();
+      if(pid < 0) ERROR("fork failed: "+string(strerror(errno)));
+      if(pid == 0){
+        close(conn);
+        close(output[0]);
+        signal(SIGPIPE, SIG_DFL);
+        RunJob(output[1], fields, job);
+      }
+      close(output[1]);
+
+      // If the client leaves, the job gets SIGPIPE on its next write
+      char buffer[65536];
+      ssize_t n;
+      while((n = read(output[0], buffer, sizeof(buffer))) != 0){
+        if(n < 0){
+          if(errno == EINTR) continue;
+          break;
+        }
+        if(!WriteFrame(conn, 'o', string(buffer, n))) break;
+      }
+      close(output[0]);
+
+      int wstatus;
+      while(waitpid(pid, &wstatus, 0) < 0){
+        if(errno != EINTR) ERROR("waitpid failed: "+string(strerror(errno)));
+      }
+      status = WIFEXITED(wstatus) ? WEXITSTATUS(wstatus) : 128+WTERMSIG(wstatus);
+    }catch(const exception &e){
+      WriteFrame(conn, 'o', string(e.what())+"\n");
+    }
+    WriteFrame(conn, 's', to_string(status));
+    close(conn);
+    exit(0);
+  }
+}
+
+void RunServer(const string &socket_path, unsigned max_workers, const ServerJob &job){
+  if(max_workers == 0) max_workers = 1;
+  stop_requested = 0;
+  SetHandler(SIGINT, RequestStop);
+  SetHandler(SIGTERM, RequestStop);
+  SetHandler(SIGCHLD, Wakeup);
+  signal(SIGPIPE, SIG_IGN);
+
+  int listen_fd = Listen(socket_path);
+  cout << "Serving on " << socket_path << " with up to " << max_workers << " workers" << endl;
+
+  // Workers own their connection, which the server closes right after the
+  // fork: no other worker inherits it, so the client sees EOF as soon as the
+  // worker holding it exits
+  set<pid_t> workers;
+  while(!stop_requested || !workers.empty()){
+    pid_t pid;
+    while((pid = waitpid(-1, nullptr, WNOHANG)) > 0) workers.erase(pid);
+
+    // Connections beyond max_workers wait in the listen backlog
+    bool accepting = !stop_requested && workers.size() < max_workers;
+    struct pollfd pfd;
+    pfd.fd = listen_fd;
+    pfd.events = POLLIN;
+    pfd.revents = 0;
+    // The timeout covers a SIGCHLD arriving between waitpid and poll
+    if(poll(&pfd, accepting ? 1 : 0, 1000) <= 0 || !(pfd.revents & POLLIN)) continue;
+
+    int conn = accept(listen_fd, nullptr, nullptr);
+    if(conn < 0){
+      if(errno == EINTR || errno == ECONNABORTED) continue;
+      ERROR("accept failed: "+string(strerror(errno)));
+    }
+    fflush(nullptr);
+    cout.flush();
+    cerr.flush();
+    pid = fork();
+    if(pid == 0) RunWorker(listen_fd, conn, job);
+    if(pid < 0){
+      DBG("fork failed: " << strerror(errno));
+      WriteFrame(conn, 's', "1");
+    }else{
+      workers.insert(pid);
+    }
+    close(conn);
+  }
+
+  close(listen_fd);
+  unlink(socket_path.c_str());
+  signal(SIGINT, SIG_DFL);
+  signal(SIGTERM, SIG_DFL);
+  signal(SIGCHLD, SIG_DFL);
+  cout << "Server on " << socket_path << " stopped" << endl;
+}
+
+int RunWithArgs(const vector<string> &args, const function<int(int, char*[])> &run){
+  // getopt permutes argv, so it gets its own copies of the strings
+  vector<vector<char> > storage;
+  vector<char*> argv;
+  for(const auto &arg: args){
+    storage.push_back(vector<char>(arg.begin(), arg.end()));
+    storage.back().push_back('\0');
+  }
+  for(auto &arg: storage) argv.push_back(arg.data());
+  argv.push_back(nullptr);
+  optind = 0; // Reinitializes getopt, which the server may have run already
+  return run(static_cast<int>(args.size()), argv.data());
+}
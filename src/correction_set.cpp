@@ -0,0 +1,869 @@
+//----------------------------------------------------------------------------
+// correction_set - Declarative corrections read from JSON and compiled into
+//                  flat evaluation programs
+//----------------------------------------------------------------------------
+
+#include "correction_set.hpp"
+
+#include <cctype>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+
+#include <algorithm>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+#include <utility>
+
+#include "utilities.hpp"
+
+using namespace std;
+
+// Parsed JSON document; objects keep their members in file order
+class JsonValue{
+public:
+  enum Type{kNull, kBool, kNumber, kString, kArray, kObject};
+
+  JsonValue():
+    type(kNull),
+    number(0.),
+    text(),
+    items(),
+    keys(){
+  }
+
+  static JsonValue Number(double value){
+    JsonValue json;
+    json.type = kNumber;
+    json.number = value;
+    return json;
+  }
+
+  static JsonValue String(const string &value){
+    JsonValue json;
+    json.type = kString;
+    json.text = value;
+    return json;
+  }
+
+  static JsonValue Array(){
+    JsonValue json;
+    json.type = kArray;
+    return json;
+  }
+
+  static JsonValue Object(){
+    JsonValue json;
+    json.type = kObject;
+    return json;
+  }
+
+  JsonValue & Push(const JsonValue &value){
+    items.push_back(value);
+    return *this;
+  }
+
+  JsonValue & Set(const string &key, const JsonValue &value){
+    keys.push_back(key);
+    items.push_back(value);
+    return *this;
+  }
+
+  const JsonValue * Find(const string &key) const{
+    if(type != kObject) return nullptr;
+    for(size_t i = 0; i < keys.size(); ++i){
+      if(keys[i] == key) return &items[i];
+    }
+    return nullptr;
+  }
+
+  Type type;
+  double number; // Also 0 or 1 for booleans
+  string text;
+  vector<JsonValue> items; // Array elements, or object values
+  vector<string> keys;     // Object keys, aligned with items
+};
+
+namespace{
+  class JsonParser{
+  public:
+    JsonParser(const string &text, const string &source):
+      text_(text),
+      source_(source),
+      pos_(0){
+    }
+
+    JsonValue Parse(){
+      JsonValue json = Value(0);
+      SkipSpace();
+      if(pos_ != text_.size()) Fail("unexpected trailing characters");
+      return json;
+    }
+
+  private:
+    static const int kMaxDepth = 256;
+
+    void Fail(const string &what) const{
+      size_t line = 1 + count(text_.begin(), text_.begin()+min(pos_, text_.size()), '\n');
+      ERROR("Invalid JSON in "+source_+" at line "+to_string(line)+": "+what);
+    }
+
+    void SkipSpace(){
+      while(pos_ < text_.size()
+            && (text_[pos_] == ' ' || text_[pos_] == '\t' || text_[pos_] == '\n' || text_[pos_] == '\r')) ++pos_;
+    }
+
+    bool Accept(char c){
+      SkipSpace();
+      if(pos_ < text_.size() && text_[pos_] == c){
+        ++pos_;
+        return true;
+      }
+      return false;
+    }
+
+    void Expect(char c){
+      if(!Accept(c)) Fail(string("expected '")+c+"'");
+    }
+
+    bool AcceptWord(const string &word){
+      if(text_.compare(pos_, word.size(), word) != 0) return false;
+      pos_ += word.size();
+      return true;
+    }
+
+    JsonValue Value(int depth){
+      if(depth > kMaxDepth) Fail("nested too deep");
+      SkipSpace();
+      if(pos_ >= text_.size()) Fail("unexpected end");
+      char c = text_[pos_];
+      if(c == '{'){
+        ++pos_;
+        JsonValue json = JsonValue::Object();
+        if(Accept('}')) return json;
+        do{
+          SkipSpace();
+          string key = StringLiteral();
+          Expect(':');
+          json.Set(key, Value(depth+1));
+        }while(Accept(','));
+        Expect('}');
+        return json;
+      }else if(c == '['){
+        ++pos_;
+        JsonValue json = JsonValue::Array();
+        if(Accept(']')) return json;
+        do{
+          json.Push(Value(depth+1));
+        }while(Accept(','));
+        Expect(']');
+        return json;
+      }else if(c == '"'){
+        return JsonValue::String(StringLiteral());
+      }else if(AcceptWord("true")){
+        JsonValue json;
+        json.type = JsonValue::kBool;
+        json.number = 1.;
+        return json;
+      }else if(AcceptWord("false")){
+        JsonValue json;
+        json.type = JsonValue::kBool;
+        return json;
+      }else if(AcceptWord("null")){
+        return JsonValue();
+      }
+      return JsonValue::Number(NumberLiteral());
+    }
+
+    double NumberLiteral(){
+      size_t begin = pos_;
+      if(pos_ < text_.size() && text_[pos_] == '-') ++pos_;
+      while(pos_ < text_.size() && (isdigit(static_cast<unsigned char>(text_[pos_]))
+                                    || text_[pos_] == '.' || text_[pos_] == 'e' || text_[pos_] == 'E'
+                                    || text_[pos_] == '+' || text_[pos_] == '-')) ++pos_;
+      string literal = text_.substr(begin, pos_-begin);
+      if(literal.empty() || literal == "-") Fail("unexpected character");
+      char *end = nullptr;
+      double value = strtod(literal.c_str(), &end);
+      if(end != literal.c_str()+literal.size()) Fail("invalid number "+literal);
+      return value;
+    }
+
+    string StringLiteral(){
+      if(pos_ >= text_.size() || text_[pos_] != '"') Fail("expected a string");
+      ++pos_;
+      string value;
+      while(true){
+        if(pos_ >= text_.size()) Fail("unterminated string");
+        char c = text_[pos_++];
+        if(c == '"') return value;
+        if(c != '\\'){
+          value += c;
+          continue;
+        }
+        if(pos_ >= text_.size()) Fail("unterminated string");
+        c = text_[pos_++];
+        if(c == 'n') value += '\n';
+        else if(c == 't') value += '\t';
+        else if(c == 'r') value += '\r';
+        else if(c == 'b') value += '\b';
+        else if(c == 'f') value += '\f';
+        else if(c == 'u') AppendUtf8(value, CodePoint());
+        else value += c; // " \ /
+      }
+    }
+
+    unsigned CodePoint(){
+      unsigned code = Hex4();
+      // Surrogate pair
+      if(code >= 0xD800 && code < 0xDC00 && AcceptWord("\\u")){
+        unsigned low = Hex4();
+        if(low < 0xDC00 || low >= 0xE000) Fail("invalid surrogate pair");
+        code = 0x10000 + ((code-0xD800) << 10) + (low-0xDC00);
+      }
+      return code;
+    }
+
+    unsigned Hex4(){
+      if(pos_+4 > text_.size()) Fail("invalid \\u escape");
+      unsigned code = 0;
+      for(int i = 0; i < 4; ++i){
+        char c = text_[pos_++];
+        code <<= 4;
+        if(c >= '0' && c <= '9') code += c-'0';
+        else if(c >= 'a' && c <= 'f') code += c-'a'+10;
+        else if(c >= 'A' && c <= 'F') code += c-'A'+10;
+        else Fail("invalid \\u escape");
+      }
+      return code;
+    }
+
+    static void AppendUtf8(string &out, unsigned code){
+      if(code < 0x80){
+        out += static_cast<char>(code);
+      }else if(code < 0x800){
+        out += static_cast<char>(0xC0 | (code >> 6));
+        out += static_cast<char>(0x80 | (code & 0x3F));
+      }else if(code < 0x10000){
+        out += static_cast<char>(0xE0 | (code >> 12));
+        out += static_cast<char>(0x80 | ((code >> 6) & 0x3F));
+        out += static_cast<char>(0x80 | (code & 0x3F));
+      }else{
+        out += static_cast<char>(0xF0 | (code >> 18));
+        out += static_cast<char>(0x80 | ((code >> 12) & 0x3F));
+        out += static_cast<char>(0x80 | ((code >> 6) & 0x3F));
+        out += static_cast<char>(0x80 | (code & 0x3F));
+      }
+    }
+
+    const string &text_;
+    string source_;
+    size_t pos_;
+  };
+
+  const JsonValue & Member(const JsonValue &json, const string &key, const string &where){
+    if(json.type != JsonValue::kObject) ERROR(where+" is not an object");
+    const JsonValue *member = json.Find(key);
+    if(member == nullptr) ERROR(where+" has no \""+key+"\"");
+    return *member;
+  }
+
+  const string & StringOf(const JsonValue &json, const string &where){
+    if(json.type != JsonValue::kString) ERROR(where+" is not a string");
+    return json.text;
+  }
+
+  double NumberOf(const JsonValue &json, const string &where){
+    if(json.type != JsonValue::kNumber) ERROR(where+" is not a number");
+    return json.number;
+  }
+
+  const vector<JsonValue> & ArrayOf(const JsonValue &json, const string &where){
+    if(json.type != JsonValue::kArray) ERROR(where+" is not an array");
+    return json.items;
+  }
+
+  void WriteString(const string &value, string &out){
+    out += '"';
+    for(char c: value){
+      if(c == '"' || c == '\\'){
+        out += '\\';
+        out += c;
+      }else if(c == '\n'){
+        out += "\\n";
+      }else if(c == '\t'){
+        out += "\\t";
+      }else if(static_cast<unsigned char>(c) < 0x20){
+        char escape[8];
+        snprintf(escape, sizeof(escape), "\\u%04x", static_cast<unsigned>(c));
+        out += escape;
+      }else{
+        out += c;
+      }
+    }
+    out += '"';
+  }
+
+  // Shortest form that reads back to the same double
+  void WriteNumber(double value, string &out){
+    if(!std::isfinite(value)) ERROR("JSON has no representation for "+to_string(value));
+    char buffer[32];
+    for(int precision = 15; precision <= 17; ++precision){
+      snprintf(buffer, sizeof(buffer), "%.*g", precision, value);
+      if(strtod(buffer, nullptr) == value) break;
+    }
+    out += buffer;
+  }
+}
+
+Correction Correction::Table(const string &name, const vector<Axis> &axes,
+                             const vector<string> &outputs, const vector<double> &content){
+  if(axes.empty() || outputs.empty()) ERROR("Table "+name+" needs axes and outputs");
+  JsonValue inputs = JsonValue::Array(), names = JsonValue::Array(), edges = JsonValue::Array();
+  size_t ncells = 1;
+  for(const auto &axis: axes){
+    inputs.Push(JsonValue::Object()
+                .Set("name", JsonValue::String(axis.input))
+                .Set("type", JsonValue::String("real")));
+    names.Push(JsonValue::String(axis.input));
+    if(axis.edges.empty()){
+      edges.Push(JsonValue::Object()
+                 .Set("n", JsonValue::Number(axis.nbins))
+                 .Set("low", JsonValue::Number(axis.low))
+                 .Set("high", JsonValue::Number(axis.high)));
+    }else{
+      JsonValue axis_edges = JsonValue::Array();
+      for(double edge: axis.edges) axis_edges.Push(JsonValue::Number(edge));
+      edges.Push(axis_edges);
+    }
+    ncells *= (axis.edges.empty() ? static_cast<size_t>(axis.nbins) : axis.edges.size()-1) + 2;
+  }
+  if(content.size() != ncells*outputs.size()) ERROR("Table "+name+" needs "+to_string(ncells*outputs.size())+" values");
+
+  JsonValue output_names = JsonValue::Array(), cells = JsonValue::Array();
+  for(const auto &output: outputs) output_names.Push(JsonValue::String(output));
+  for(size_t cell = 0; cell < ncells; ++cell){
+    if(outputs.size() == 1){
+      cells.Push(JsonValue::Number(content[cell]));
+      continue;
+    }
+    JsonValue values = JsonValue::Array();
+    for(size_t i = 0; i < outputs.size(); ++i) values.Push(JsonValue::Number(content[cell*outputs.size()+i]));
+    cells.Push(values);
+  }
+
+  JsonValue json = JsonValue::Object();
+  json.Set("name", JsonValue::String(name))
+    .Set("inputs", inputs)
+    .Set("outputs", output_names)
+    .Set("data", JsonValue::Object()
+         .Set("nodetype", JsonValue::String("binning"))
+         .Set("inputs", names)
+         .Set("edges", edges)
+         .Set("content", cells)
+         .Set("flow", JsonValue::String("bins")));
+  return Correction(json);
+}
+
+const size_t Correction::kMaxInputs;
+
+Correction::Correction():
+  name_(),
+  description_(),
+  inputs_(),
+  outputs_(),
+  codes_(),
+  nodes_(),
+  values_(),
+  formulas_(),
+  expressions_(),
+  axes_(),
+  edges_(),
+  keys_(),
+  children_(){
+}
+
+Correction::Correction(const JsonValue &json):
+  Correction(){
+  name_ = StringOf(Member(json, "name", "Correction"), "Correction name");
+  const string where = "Correction "+name_;
+  const JsonValue *description = json.Find("description");
+  if(description != nullptr) description_ = StringOf(*description, where+" description");
+
+  for(const auto &input: ArrayOf(Member(json, "inputs", where), where+" inputs")){
+    Input in;
+    in.name = StringOf(Member(input, "name", where+" input"), where+" input name");
+    const string &type = StringOf(Member(input, "type", where+" input "+in.name), where+" input "+in.name+" type");
+    if(type == "real") in.type = kReal;
+    else if(type == "int") in.type = kInt;
+    else if(type == "string") in.type = kString;
+    else ERROR(where+" input "+in.name+" has unknown type "+type);
+    for(const auto &other: inputs_){
+      if(other.name == in.name) ERROR(where+" has two inputs called "+in.name);
+    }
+    inputs_.push_back(in);
+  }
+  if(inputs_.size() > kMaxInputs) ERROR(where+" has more than "+to_string(kMaxInputs)+" inputs");
+  for(const auto &output: ArrayOf(Member(json, "outputs", where), where+" outputs")){
+    outputs_.push_back(StringOf(output, where+" output"));
+  }
+  if(outputs_.empty()) ERROR(where+" has no outputs");
+  codes_.resize(inputs_.size());
+
+  Compile(Member(json, "data", where), where);
+}
+
+size_t Correction::InputIndex(const string &name) const{
+  size_t i = 0;
+  while(i < inputs_.size() && inputs_[i].name != name) ++i;
+  if(i == inputs_.size()) ERROR("Correction "+name_+" has no input "+name);
+  return i;
+}
+
+double Correction::Code(size_t input, const string &value) const{
+  if(input >= inputs_.size() || inputs_[input].type != kString) ERROR("Input "+to_string(input)+" of "+name_+" is not a string");
+  auto code = codes_[input].find(value);
+  return code == codes_[input].end() ? -1. : code->second;
+}
+
+size_t Correction::AddNode(const Node &node){
+  nodes_.push_back(node);
+  return nodes_.size()-1;
+}
+
+// Each node is added before its children, so the root is node 0
+size_t Correction::Compile(const JsonValue &json, const string &where){
+  Node node;
+  node.type = kConstant;
+  node.input = npos;
+  node.begin = values_.size();
+  node.size = 0;
+  node.children = 0;
+  node.flow = kFlowClamp;
+  node.fallback = npos;
+  node.right_closed = false;
+  if(json.type == JsonValue::kNumber){
+    if(outputs_.size() != 1) ERROR(where+" needs "+to_string(outputs_.size())+" values, not a number");
+    values_.push_back(json.number);
+    return AddNode(node);
+  }else if(json.type == JsonValue::kArray){
+    const vector<JsonValue> &items = json.items;
+    if(items.size() != outputs_.size()) ERROR(where+" needs "+to_string(outputs_.size())+" values");
+    for(const auto &item: items) values_.push_back(NumberOf(item, where));
+    return AddNode(node);
+  }
+
+  const string &type = StringOf(Member(json, "nodetype", where), where+" nodetype");
+  if(type == "binning") return CompileBinning(json, where);
+  if(type == "category") return CompileCategory(json, where);
+  if(type != "formula") ERROR(where+" has unknown nodetype "+type);
+
+  if(outputs_.size() != 1) ERROR(where+": formulas need a single output");
+  const string &variable = StringOf(Member(json, "variable", where), where+" variable");
+  const string &expression = StringOf(Member(json, "expression", where), where+" expression");
+  node.type = kFormula;
+  node.input = InputIndex(variable);
+  if(inputs_[node.input].type == kString) ERROR(where+" formula of string input "+variable);
+  node.begin = formulas_.size();
+  formulas_.push_back(BTagFormula(expression));
+  expressions_.push_back(expression);
+  if(!formulas_.back().isCompiled()) ERROR(where+" formula outside the supported subset: "+expression);
+  return AddNode(node);
+}
+
+size_t Correction::CompileBinning(const JsonValue &json, const string &where){
+  const vector<JsonValue> &names = ArrayOf(Member(json, "inputs", where), where+" inputs");
+  const vector<JsonValue> &axes = ArrayOf(Member(json, "edges", where), where+" edges");
+  if(names.empty() || names.size() != axes.size()) ERROR(where+" needs one edges entry per input");
+
+  Node node;
+  node.type = kBinning;
+  node.input = npos;
+  node.begin = axes_.size();
+  node.size = names.size();
+  node.flow = kFlowClamp;
+  node.fallback = npos;
+  node.right_closed = false;
+  const JsonValue *closed = json.Find("closed");
+  if(closed != nullptr){
+    const string &side = StringOf(*closed, where+" closed");
+    if(side == "right") node.right_closed = true;
+    else if(side != "left") ERROR(where+" closed must be left or right, not "+side);
+  }
+  const JsonValue *flow = json.Find("flow");
+  if(flow != nullptr && flow->type == JsonValue::kString){
+    if(flow->text == "clamp") node.flow = kFlowClamp;
+    else if(flow->text == "error") node.flow = kFlowError;
+    else if(flow->text == "bins") node.flow = kFlowBins;
+    else ERROR(where+" has unknown flow "+flow->text);
+  }else if(flow != nullptr){
+    node.flow = kFlowNode;
+  }
+
+  // Axes are contiguous in axes_, so they are all added before any child
+  size_t ncells = 1;
+  for(size_t i = 0; i < names.size(); ++i){
+    BinAxis axis;
+    axis.input = InputIndex(StringOf(names[i], where+" input"));
+    if(inputs_[axis.input].type == kString) ERROR(where+" bins string input "+inputs_[axis.input].name);
+    if(axes[i].type == JsonValue::kArray){
+      axis.edges = edges_.size();
+      for(const auto &edge: axes[i].items){
+        double value = NumberOf(edge, where+" edge");
+        if(!std::isfinite(value) || (edges_.size() > axis.edges && !(edges_.back() < value))){
+          ERROR(where+" edges must be finite and increasing");
+        }
+        edges_.push_back(value);
+      }
+      if(edges_.size()-axis.edges < 2) ERROR(where+" needs at least two edges per axis");
+      axis.nbins = static_cast<int>(edges_.size()-axis.edges-1);
+      axis.low = edges_[axis.edges];
+      axis.high = edges_.back();
+    }else{
+      axis.edges = npos;
+      double nbins = NumberOf(Member(axes[i], "n", where+" axis"), where+" axis n");
+      axis.low = NumberOf(Member(axes[i], "low", where+" axis"), where+" axis low");
+      axis.high = NumberOf(Member(axes[i], "high", where+" axis"), where+" axis high");
+      if(!(nbins >= 1.) || nbins != floor(nbins) || !(axis.low < axis.high)) ERROR(where+" has an invalid uniform axis");
+      axis.nbins = static_cast<int>(nbins);
+    }
+    axis.width = axis.high-axis.low;
+    axis.stride = 0;
+    axes_.push_back(axis);
+    ncells *= axis.nbins + (node.flow == kFlowBins ? 2 : 0);
+  }
+  size_t stride = 1;
+  for(size_t i = names.size(); i-- > 0; ){
+    BinAxis &axis = axes_[node.begin+i];
+    axis.stride = stride;
+    stride *= axis.nbins + (node.flow == kFlowBins ? 2 : 0);
+  }
+
+  const vector<JsonValue> &content = ArrayOf(Member(json, "content", where), where+" content");
+  if(content.size() != ncells) ERROR(where+" content has "+to_string(content.size())+" bins instead of "+to_string(ncells));
+  node.children = children_.size();
+  children_.resize(children_.size()+ncells);
+  size_t inode = AddNode(node);
+  for(size_t cell = 0; cell < ncells; ++cell){
+    size_t child = Compile(content[cell], where+" bin "+to_string(cell));
+    children_[node.children+cell] = child;
+  }
+  if(node.flow == kFlowNode){
+    size_t fallback = Compile(*flow, where+" flow");
+    nodes_[inode].fallback = fallback;
+  }
+  return inode;
+}
+
+size_t Correction::CompileCategory(const JsonValue &json, const string &where){
+  Node node;
+  node.type = kCategory;
+  node.input = InputIndex(StringOf(Member(json, "input", where), where+" input"));
+  node.fallback = npos;
+  node.flow = kFlowClamp;
+  node.right_closed = false;
+  const Input &input = inputs_[node.input];
+  if(input.type == kReal) ERROR(where+" switches on real input "+input.name);
+
+  vector<pair<double, const JsonValue*> > entries;
+  for(const auto &entry: ArrayOf(Member(json, "content", where), where+" content")){
+    const JsonValue &key = Member(entry, "key", where+" content");
+    double code;
+    if(input.type == kString){
+      const string &text = StringOf(key, where+" key");
+      auto found = codes_[node.input].find(text);
+      code = found == codes_[node.input].end() ? codes_[node.input].size() : found->second;
+      codes_[node.input][text] = code;
+    }else{
+      code = NumberOf(key, where+" key");
+      if(code != floor(code)) ERROR(where+" has non-integer key "+to_string(code));
+    }
+    entries.push_back(make_pair(code, &Member(entry, "value", where+" content")));
+  }
+  sort(entries.begin(), entries.end(),
+       [](const pair<double, const JsonValue*> &a, const pair<double, const JsonValue*> &b){
+         return a.first < b.first;
+       });
+  for(size_t i = 1; i < entries.size(); ++i){
+    if(entries[i].first == entries[i-1].first) ERROR(where+" has a repeated key");
+  }
+
+  node.begin = keys_.size();
+  node.size = entries.size();
+  node.children = children_.size();
+  for(const auto &entry: entries) keys_.push_back(entry.first);
+  children_.resize(children_.size()+entries.size());
+  size_t inode = AddNode(node);
+  for(size_t i = 0; i < entries.size(); ++i){
+    size_t child = Compile(*entries[i].second, where+" key "+to_string(entries[i].first));
+    children_[node.children+i] = child;
+  }
+  const JsonValue *fallback = json.Find("default");
+  if(fallback != nullptr){
+    size_t child = Compile(*fallback, where+" default");
+    nodes_[inode].fallback = child;
+  }
+  return inode;
+}
+
+int Correction::Bin(const BinAxis &axis, double value, bool right_closed) const{
+  if(std::isnan(value)) return axis.nbins;
+  if(axis.edges == npos){
+    if(right_closed){
+      if(!(value > axis.low)) return -1;
+      if(value > axis.high) return axis.nbins;
+      int bin = static_cast<int>(ceil(axis.nbins*(value-axis.low)/axis.width))-1;
+      return max(0, min(bin, axis.nbins-1));
+    }
+    // Same expression as TAxis::FindFixBin
+    if(value < axis.low) return -1;
+    if(!(value < axis.high)) return axis.nbins;
+    return min(static_cast<int>(axis.nbins*(value-axis.low)/axis.width), axis.nbins);
+  }
+  const double *first = edges_.data()+axis.edges, *last = first+axis.nbins+1;
+  const double *edge = right_closed ? lower_bound(first, last, value) : upper_bound(first, last, value);
+  return static_cast<int>(edge-first)-1;
+}
+
+size_t Correction::Child(const Node &node, const double *inputs) const{
+  if(node.type == kCategory){
+    double value = inputs[node.input];
+    const double *first = keys_.data()+node.begin, *last = first+node.size;
+    const double *key = lower_bound(first, last, value);
+    if(key != last && *key == value) return children_[node.children+(key-first)];
+    if(node.fallback == npos) ERROR("No entry for "+inputs_[node.input].name+" = "+to_string(value)+" in "+name_);
+    return node.fallback;
+  }
+
+  size_t cell = node.children;
+  for(size_t i = 0; i < node.size; ++i){
+    const BinAxis &axis = axes_[node.begin+i];
+    int bin = Bin(axis, inputs[axis.input], node.right_closed);
+    if(node.flow == kFlowBins){
+      bin += 1;
+    }else if(bin < 0 || bin >= axis.nbins){
+      if(node.flow == kFlowNode) return node.fallback;
+      if(node.flow == kFlowError){
+        ERROR(inputs_[axis.input].name+" = "+to_string(inputs[axis.input])+" outside the bins of "+name_);
+      }
+      bin = bin < 0 ? 0 : axis.nbins-1;
+    }
+    cell += bin*axis.stride;
+  }
+  return children_[cell];
+}
+
+void Correction::Evaluate(const double *inputs, double *out) const{
+  if(nodes_.empty()) ERROR("Evaluating an empty correction");
+  size_t inode = 0;
+  while(true){
+    const Node &node = nodes_[inode];
+    if(node.type == kConstant){
+      for(size_t i = 0; i < outputs_.size(); ++i) out[i] = values_[node.begin+i];
+      return;
+    }else if(node.type == kFormula){
+      out[0] = formulas_[node.begin].eval(inputs[node.input]);
+      return;
+    }
+    inode = Child(node, inputs);
+  }
+}
+
+double Correction::Evaluate(const vector<double> &inputs) const{
+  if(inputs.size() != inputs_.size()) ERROR(name_+" takes "+to_string(inputs_.size())+" inputs");
+  vector<double> out(outputs_.size());
+  Evaluate(inputs.data(), out.data());
+  return out.front();
+}
+
+void Correction::Evaluate(size_t n, const double * const *inputs, double *out) const{
+  double entry[kMaxInputs];
+  for(size_t i = 0; i < n; ++i){
+    for(size_t j = 0; j < inputs_.size(); ++j) entry[j] = inputs[j][i];
+    Evaluate(entry, out+i*outputs_.size());
+  }
+}
+
+void Correction::WriteNode(size_t inode, string &out) const{
+  const Node &node = nodes_.at(inode);
+  if(node.type == kConstant){
+    if(outputs_.size() == 1){
+      WriteNumber(values_[node.begin], out);
+      return;
+    }
+    out += '[';
+    for(size_t i = 0; i < outputs_.size(); ++i){
+      if(i) out += ", ";
+      WriteNumber(values_[node.begin+i], out);
+    }
+    out += ']';
+  }else if(node.type == kFormula){
+    out += "{\"nodetype\": \"formula\", \"variable\": ";
+    WriteString(inputs_[node.input].name, out);
+    out += ", \"expression\": ";
+    WriteString(expressions_[node.begin], out);
+    out += '}';
+  }else if(node.type == kBinning){
+    out += "{\"nodetype\": \"binning\", \"inputs\": [";
+    size_t ncells = 1;
+    for(size_t i = 0; i < node.size; ++i){
+      if(i) out += ", ";
+      WriteString(inputs_[axes_[node.begin+i].input].name, out);
+    }
+    out += "], \"edges\": [";
+    for(size_t i = 0; i < node.size; ++i){
+      const BinAxis &axis = axes_[node.begin+i];
+      if(i) out += ", ";
+      if(axis.edges == npos){
+        out += "{\"n\": "+to_string(axis.nbins)+", \"low\": ";
+        WriteNumber(axis.low, out);
+        out += ", \"high\": ";
+        WriteNumber(axis.high, out);
+        out += '}';
+      }else{
+        out += '[';
+        for(int edge = 0; edge <= axis.nbins; ++edge){
+          if(edge) out += ", ";
+          WriteNumber(edges_[axis.edges+edge], out);
+        }
+        out += ']';
+      }
+      ncells *= axis.nbins + (node.flow == kFlowBins ? 2 : 0);
+    }
+    out += "],\n  \"content\": [";
+    for(size_t cell = 0; cell < ncells; ++cell){
+      if(cell) out += ", ";
+      WriteNode(children_[node.children+cell], out);
+    }
+    out += "],\n  \"flow\": ";
+    if(node.flow == kFlowNode) WriteNode(node.fallback, out);
+    else if(node.flow == kFlowError) out += "\"error\"";
+    else if(node.flow == kFlowBins) out += "\"bins\"";
+    else out += "\"clamp\"";
+    if(node.right_closed) out += ", \"closed\": \"right\"";
+    out += '}';
+  }else{
+    const Input &input = inputs_[node.input];
+    out += "{\"nodetype\": \"category\", \"input\": ";
+    WriteString(input.name, out);
+    out += ", \"content\": [";
+    for(size_t i = 0; i < node.size; ++i){
+      if(i) out += ", ";
+      out += "{\"key\": ";
+      double key = keys_[node.begin+i];
+      if(input.type == kString){
+        for(const auto &code: codes_[node.input]){
+          if(code.second == key) WriteString(code.first, out);
+        }
+      }else{
+        WriteNumber(key, out);
+      }
+      out += ", \"value\": ";
+      WriteNode(children_[node.children+i], out);
+      out += '}';
+    }
+    out += ']';
+    if(node.fallback != npos){
+      out += ", \"default\": ";
+      WriteNode(node.fallback, out);
+    }
+    out += '}';
+  }
+}
+
+string Correction::ToJSON() const{
+  string out = "{\"name\": ";
+  WriteString(name_, out);
+  if(description_ != ""){
+    out += ", \"description\": ";
+    WriteString(description_, out);
+  }
+  out += ",\n \"inputs\": [";
+  for(size_t i = 0; i < inputs_.size(); ++i){
+    if(i) out += ", ";
+    out += "{\"name\": ";
+    WriteString(inputs_[i].name, out);
+    out += ", \"type\": ";
+    out += inputs_[i].type == kReal ? "\"real\"" : (inputs_[i].type == kInt ? "\"int\"" : "\"string\"");
+    out += '}';
+  }
+  out += "],\n \"outputs\": [";
+  for(size_t i = 0; i < outputs_.size(); ++i){
+    if(i) out += ", ";
+    WriteString(outputs_[i], out);
+  }
+  out += "],\n \"data\": ";
+  if(!nodes_.empty()) WriteNode(0, out);
+  else out += "null";
+  out += '}';
+  return out;
+}
+
+CorrectionSet::CorrectionSet(const string &file):
+  CorrectionSet(){
+  ifstream in(file.c_str());
+  if(!in.good()) ERROR("Could not open correction set "+file);
+  ostringstream text;
+  text << in.rdbuf();
+  *this = Parse(text.str(), file);
+}
+
+CorrectionSet CorrectionSet::Parse(const string &json, const string &source){
+  JsonValue root = JsonParser(json, source).Parse();
+  const JsonValue *version = root.Find("schema_version");
+  if(version != nullptr && NumberOf(*version, source+" schema_version") != 1.){
+    ERROR(source+" has unsupported schema_version "+to_string(version->number));
+  }
+  CorrectionSet set;
+  for(const auto &correction: ArrayOf(Member(root, "corrections", source), source+" corrections")){
+    Correction compiled(correction);
+    set.Add(compiled.Name(), compiled);
+  }
+  return set;
+}
+
+bool CorrectionSet::Has(const string &name) const{
+  return index_.find(name) != index_.end();
+}
+
+const Correction & CorrectionSet::Get(const string &name) const{
+  auto found = index_.find(name);
+  if(found == index_.end()) ERROR("No correction "+name+" in correction set");
+  return corrections_[found->second];
+}
+
+vector<string> CorrectionSet::Names() const{
+  vector<string> names;
+  for(const auto &correction: corrections_) names.push_back(correction.Name());
+  return names;
+}
+
+void CorrectionSet::Add(const string &name, const Correction &correction){
+  auto found = index_.find(name);
+  if(found == index_.end()){
+    index_[name] = corrections_.size();
+    corrections_.push_back(correction);
+    corrections_.back().name_ = name;
+  }else{
+    corrections_[found->second] = correction;
+    corrections_[found->second].name_ = name;
+  }
+}
+
+string CorrectionSet::ToJSON() const{
+  string out = "{\"schema_version\": 1, \"corrections\": [\n";
+  for(size_t i = 0; i < corrections_.size(); ++i){
+    if(i) out += ",\n";
+    out += corrections_[i].ToJSON();
+  }
+  out += "\n]}\n";
+  return out;
+}
+
+void CorrectionSet::Write(const string &file) const{
+  ofstream out(file.c_str());
+  out << ToJSON();
+  out.close();
+  if(!out.good()) ERROR("Could not write correction set "+file);
+}
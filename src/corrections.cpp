@@ -0,0 +1,604 @@
+//----------------------------------------------------------------------------
+// corrections - Per-event weight recalculation, sum-of-weights reduction and
+//               renormalization shared by calc_corr, merge_corrections,
+//               apply_corr and reweight
+//----------------------------------------------------------------------------
+
+#include "corrections.hpp"
+
+#include <iostream>
+#include <limits>
+
+#include "utilities.hpp"
+#include "hig_utils.hpp"
+#include "cross_sections.hpp"
+#include "lepton_weighter.hpp"
+
+using namespace std;
+
+namespace corrections{
+
+  const vector<string> calc_branches = {"w_lep", "sys_lep", "w_fs_lep", "sys_fs_lep",
+                                       "w_btag_deep", "w_bhig_deep",
+                                       "sys_bctag_deep", "sys_udsgtag_deep", "sys_bchig_deep", "sys_udsghig_deep",
+                                       "sys_fs_bctag_deep", "sys_fs_udsgtag_deep", "sys_fs_bchig_deep", "sys_fs_udsghig_deep",
+                                       "w_btag_loose_deep", "w_btag_tight_deep",
+                                       "sys_bctag_loose_deep", "sys_udsgtag_loose_deep",
+                                       "sys_bctag_tight_deep", "sys_udsgtag_tight_deep",
+                                       "w_btag_shape_deep", "sys_btag_shape_deep"};
+
+  const vector<string> apply_branches = {"eff_trig", "sys_trig", "mgluino",
+                                        "w_lep", "sys_lep", "w_fs_lep", "sys_fs_lep",
+                                        "w_lumi", "weight", "w_isr", "sys_isr", "w_pu",
+                                        "w_btag_deep", "w_bhig_deep",
+                                        "sys_bctag_deep", "sys_udsgtag_deep", "sys_bchig_deep", "sys_udsghig_deep",
+                                        "sys_mur", "sys_muf", "sys_murf",
+                                        "sys_fs_bctag_deep", "sys_fs_udsgtag_deep", "sys_fs_bchig_deep", "sys_fs_udsghig_deep",
+                                        "w_btag_loose_deep", "w_btag_tight_deep", "w_pdf", "sys_pu",
+                                        "sys_bctag_loose_deep", "sys_udsgtag_loose_deep",
+                                        "sys_bctag_tight_deep", "sys_udsgtag_tight_deep",
+                                        "w_btag_shape_deep", "sys_btag_shape_deep"};
+
+  namespace{
+    typedef float & (baby_plus::*ScalarWeight)();
+    typedef std::vector<float> & (baby_plus::*VectorWeight)();
+    // weight gives the value to write, set_weight takes the cached one
+    // without reading the input branch
+    struct ScalarColumn{
+      string name;
+      ScalarWeight weight, set_weight;
+    };
+    struct VectorColumns{
+      string name;
+      VectorWeight weight, set_weight;
+      size_t size;
+    };
+    const size_t nsys = 2;
+
+    // Same branches as calc_branches; vectors are stored as size columns, NaN-padded
+    const vector<ScalarColumn> scalar_weights = {
+      {"w_lep", &baby_plus::out_w_lep, &baby_plus::set_out_w_lep},
+      {"w_fs_lep", &baby_plus::out_w_fs_lep, &baby_plus::set_out_w_fs_lep},
+      {"w_btag_deep", &baby_plus::out_w_btag_deep, &baby_plus::set_out_w_btag_deep},
+      {"w_bhig_deep", &baby_plus::out_w_bhig_deep, &baby_plus::set_out_w_bhig_deep},
+      {"w_btag_loose_deep", &baby_plus::out_w_btag_loose_deep, &baby_plus::set_out_w_btag_loose_deep},
+      {"w_btag_tight_deep", &baby_plus::out_w_btag_tight_deep, &baby_plus::set_out_w_btag_tight_deep},
+      {"w_btag_shape_deep", &baby_plus::out_w_btag_shape_deep, &baby_plus::set_out_w_btag_shape_deep}
+    };
+    const vector<VectorColumns> vector_weights = {
+      {"sys_lep", &baby_plus::out_sys_lep, &baby_plus::set_out_sys_lep, nsys},
+      {"sys_fs_lep", &baby_plus::out_sys_fs_lep, &baby_plus::set_out_sys_fs_lep, nsys},
+      {"sys_bctag_deep", &baby_plus::out_sys_bctag_deep, &baby_plus::set_out_sys_bctag_deep, nsys},
+      {"sys_udsgtag_deep", &baby_plus::out_sys_udsgtag_deep, &baby_plus::set_out_sys_udsgtag_deep, nsys},
+      {"sys_bchig_deep", &baby_plus::out_sys_bchig_deep, &baby_plus::set_out_sys_bchig_deep, nsys},
+      {"sys_udsghig_deep", &baby_plus::out_sys_udsghig_deep, &baby_plus::set_out_sys_udsghig_deep, nsys},
+      {"sys_fs_bctag_deep", &baby_plus::out_sys_fs_bctag_deep, &baby_plus::set_out_sys_fs_bctag_deep, nsys},
+      {"sys_fs_udsgtag_deep", &baby_plus::out_sys_fs_udsgtag_deep, &baby_plus::set_out_sys_fs_udsgtag_deep, nsys},
+      {"sys_fs_bchig_deep", &baby_plus::out_sys_fs_bchig_deep, &baby_plus::set_out_sys_fs_bchig_deep, nsys},
+      {"sys_fs_udsghig_deep", &baby_plus::out_sys_fs_udsghig_deep, &baby_plus::set_out_sys_fs_udsghig_deep, nsys},
+      {"sys_bctag_loose_deep", &baby_plus::out_sys_bctag_loose_deep, &baby_plus::set_out_sys_bctag_loose_deep, nsys},
+      {"sys_udsgtag_loose_deep", &baby_plus::out_sys_udsgtag_loose_deep, &baby_plus::set_out_sys_udsgtag_loose_deep, nsys},
+      {"sys_bctag_tight_deep", &baby_plus::out_sys_bctag_tight_deep, &baby_plus::set_out_sys_bctag_tight_deep, nsys},
+      {"sys_udsgtag_tight_deep", &baby_plus::out_sys_udsgtag_tight_deep, &baby_plus::set_out_sys_udsgtag_tight_deep, nsys},
+      {"sys_btag_shape_deep", &baby_plus::out_sys_btag_shape_deep, &baby_plus::set_out_sys_btag_shape_deep, BTagWeighter::ShapeSysTypes().size()}
+    };
+  }
+
+  void InitSums(baby_corr &c){
+    c.out_w_pdf().resize(100,0);
+    c.out_sys_isr().resize(2,0);
+    c.out_sys_lep().resize(2,0);
+    c.out_sys_fs_lep().resize(2,0);
+    c.out_sys_bctag_deep().resize(2,0);
+    c.out_sys_udsgtag_deep().resize(2,0);
+    c.out_sys_bchig_deep().resize(2,0);
+    c.out_sys_udsghig_deep().resize(2,0);
+    c.out_sys_mur().resize(2,0);
+    c.out_sys_muf().resize(2,0);
+    c.out_sys_murf().resize(2,0);
+    c.out_sys_fs_bctag_deep().resize(2,0);
+    c.out_sys_fs_udsgtag_deep().resize(2,0);
+    c.out_sys_fs_bchig_deep().resize(2,0);
+    c.out_sys_fs_udsghig_deep().resize(2,0);
+    c.out_sys_pu().resize(2,0);
+    c.out_sys_pdf().resize(2,0);
+    c.out_sys_bctag_loose_deep().resize(2,0);
+    c.out_sys_udsgtag_loose_deep().resize(2,0);
+    c.out_sys_bctag_tight_deep().resize(2,0);
+    c.out_sys_udsgtag_tight_deep().resize(2,0);
+    c.out_sys_btag_shape_deep().resize(BTagWeighter::ShapeSysTypes().size(),0);
+  }
+
+  bool HasShapeBTag(const baby_plus &b){
+    return b.HasBranch("w_btag_shape_deep");
+  }
+
+  void CalcEntry(baby_plus &b, BTagWeighter &btw, const LeptonWeighter &lw, baby_corr &c, bool isSignal,
+                 bool quick, bool fix_b_wgt, bool fix_lep_wgt, bool has_shape_b_wgt){
+    double wgt(0);
+
+    // All b-tag weight variations come from a single pass over the jets
+    typedef BTagWeighter BW;
+    const BW::Variation bc[] = {BW::kBCUp, BW::kBCDown};
+    const BW::Variation udsg[] = {BW::kUDSGUp, BW::kUDSGDown};
+    const BW::Variation fs_bc[] = {BW::kFastBCUp, BW::kFastBCDown};
+    const BW::Variation fs_udsg[] = {BW::kFastUDSGUp, BW::kFastUDSGDown};
+    static const vector<BW::OpSet> quick_op_sets = {BW::kOpMedium, BW::kOpAll};
+    static const vector<BW::OpSet> all_op_sets = {BW::kOpMedium, BW::kOpAll, BW::kOpLoose, BW::kOpTight};
+    BW::EventWeightSet bw = BW::EventWeightSet();
+    if(fix_b_wgt){
+      bw = btw.EventWeights(b, quick ? quick_op_sets : all_op_sets, true, false);
+      // Shape SFs need no efficiencies: one lookup per jet at its discriminant
+      btw.ShapeWeights(b, true, b.out_w_btag_shape_deep(), b.out_sys_btag_shape_deep());
+    }
+
+    float w_btag_deep = fix_b_wgt ? bw(BW::kOpMedium, BW::kCentral) : b.w_btag_deep();
+    float w_lep(1.), w_fs_lep(1.);
+    vector<float> sys_lep(2,1.), sys_fs_lep(2,1.);
+    if(fix_lep_wgt){
+      lw.FullSim(b, w_lep, sys_lep);
+      if(isSignal) lw.FastSim(b, w_fs_lep, sys_fs_lep);
+      b.out_w_lep() = w_lep;
+      b.out_sys_lep() = sys_lep;
+      b.out_w_fs_lep() = w_fs_lep;
+      b.out_sys_fs_lep() = sys_fs_lep;
+    }else{
+      w_lep = b.w_lep();
+      sys_lep = b.sys_lep();
+      if(isSignal){
+            w_fs_lep = b.w_lep();
+            sys_fs_lep = b.sys_fs_lep();
+      }
+    }
+
+    wgt = w_lep*(isSignal ? w_fs_lep : 1.)*
+          w_btag_deep*b.w_isr()*b.w_pu();
+
+    // need special treatment in summing and/or renormalizing
+    c.out_neff() += b.w_lumi()>0 ? 1:-1;
+
+    c.out_w_isr() += b.w_isr();
+    for(size_t i = 0; i<b.sys_isr().size(); ++i){
+      c.out_sys_isr().at(i) += b.sys_isr().at(i);
+    }
+
+    if(b.nleps()==0){
+      c.out_nent_zlep()     += 1.;
+      c.out_tot_weight_l0() += wgt;
+    }else{
+      c.out_tot_weight_l1() += wgt;
+      c.out_w_lep()         += w_lep;
+      for(size_t i = 0; i<b.sys_lep().size(); ++i){
+        c.out_sys_lep().at(i) += sys_lep.at(i);
+      }
+      if(isSignal){
+        c.out_w_fs_lep()      += w_fs_lep;
+        for(size_t i = 0; i<b.sys_fs_lep().size(); ++i){
+          c.out_sys_fs_lep().at(i) += sys_fs_lep.at(i);
+        }
+      }
+    }
+
+    //      Cookie-cutter variables
+    //-----------------------------------
+    c.out_w_pu()             += b.w_pu();
+
+    double tmp = 0.;
+
+    c.out_w_btag_deep()+= w_btag_deep; b.out_w_btag_deep() = w_btag_deep;
+
+    // Without new or stored shape weights the output keeps the input value,
+    // which does not enter the sums
+    if(fix_b_wgt || has_shape_b_wgt){
+      c.out_w_btag_shape_deep()+= b.out_w_btag_shape_deep();
+      for(size_t i = 0; i<b.out_sys_btag_shape_deep().size() && i<c.out_sys_btag_shape_deep().size(); ++i){
+        c.out_sys_btag_shape_deep().at(i)+= b.out_sys_btag_shape_deep().at(i);
+      }
+    }
+
+    tmp = fix_b_wgt ? bw(BW::kOpAll, BW::kCentral)      : b.w_bhig_deep();
+    c.out_w_bhig_deep()+= tmp; b.out_w_bhig_deep() = tmp;
+
+    for(size_t i = 0; i<2; ++i){
+      tmp = fix_b_wgt ? bw(BW::kOpMedium, bc[i])            : b.sys_bctag_deep().at(i);
+      c.out_sys_bctag_deep().at(i)+= tmp; b.out_sys_bctag_deep().at(i) = tmp;
+      tmp = fix_b_wgt ? bw(BW::kOpMedium, udsg[i])          : b.sys_udsgtag_deep().at(i);
+      c.out_sys_udsgtag_deep().at(i)+= tmp; b.out_sys_udsgtag_deep().at(i) = tmp;
+
+      tmp = fix_b_wgt ? bw(BW::kOpAll, bc[i])               : b.sys_bchig_deep().at(i);
+      c.out_sys_bchig_deep().at(i)+= tmp; b.out_sys_bchig_deep().at(i) = tmp;
+      tmp = fix_b_wgt ? bw(BW::kOpAll, udsg[i])             : b.sys_udsghig_deep().at(i);
+      c.out_sys_udsghig_deep().at(i)+= tmp; b.out_sys_udsghig_deep().at(i) = tmp;
+
+      if(isSignal){ // yes, this ignores the fullsim points
+        c.out_sys_mur().at(i)             += b.sys_mur().at(i);
+        c.out_sys_muf().at(i)             += b.sys_muf().at(i);
+        c.out_sys_murf().at(i)            += b.sys_murf().at(i);
+
+        tmp = fix_b_wgt ? bw(BW::kOpMedium, fs_bc[i])         : b.sys_fs_bctag_deep().at(i);
+        c.out_sys_fs_bctag_deep().at(i)+= tmp; b.out_sys_fs_bctag_deep().at(i) = tmp;
+        tmp = fix_b_wgt ? bw(BW::kOpMedium, fs_udsg[i])       : b.sys_fs_udsgtag_deep().at(i);
+        c.out_sys_fs_udsgtag_deep().at(i)+= tmp; b.out_sys_fs_udsgtag_deep().at(i) = tmp;
+        tmp = fix_b_wgt ? bw(BW::kOpAll, fs_bc[i])            : b.sys_fs_bchig_deep().at(i);
+        c.out_sys_fs_bchig_deep().at(i)+= tmp; b.out_sys_fs_bchig_deep().at(i) = tmp;
+        tmp = fix_b_wgt ? bw(BW::kOpAll, fs_udsg[i])          : b.sys_fs_udsghig_deep().at(i);
+        c.out_sys_fs_udsghig_deep().at(i)+= tmp; b.out_sys_fs_udsghig_deep().at(i) = tmp;
+      }
+    }
+
+    if(!quick){
+      tmp = fix_b_wgt ? bw(BW::kOpLoose, BW::kCentral)    : b.w_btag_loose_deep();
+      c.out_w_btag_loose_deep()+= tmp; b.out_w_btag_loose_deep() = tmp;
+      tmp = fix_b_wgt ? bw(BW::kOpTight, BW::kCentral)    : b.w_btag_tight_deep();
+      c.out_w_btag_tight_deep()+= tmp; b.out_w_btag_tight_deep() = tmp;
+
+      for(size_t i = 0; i<b.w_pdf().size(); ++i){
+            c.out_w_pdf().at(i) += b.w_pdf().at(i);
+      }
+
+      for(size_t i = 0; i<b.sys_mur().size(); ++i){
+        c.out_sys_pu().at(i)                      += b.sys_pu().at(i);
+        if(i < b.sys_pdf().size()){
+          c.out_sys_pdf().at(i)                   += b.sys_pdf().at(i);
+        }
+
+        tmp = fix_b_wgt ? bw(BW::kOpLoose, bc[i])             : b.sys_bctag_loose_deep().at(i);
+        c.out_sys_bctag_loose_deep().at(i)+= tmp; b.out_sys_bctag_loose_deep().at(i) = tmp;
+        tmp = fix_b_wgt ? bw(BW::kOpLoose, udsg[i])           : b.sys_udsgtag_loose_deep().at(i);
+        c.out_sys_udsgtag_loose_deep().at(i)+= tmp; b.out_sys_udsgtag_loose_deep().at(i) = tmp;
+        tmp = fix_b_wgt ? bw(BW::kOpTight, bc[i])             : b.sys_bctag_tight_deep().at(i);
+        c.out_sys_bctag_tight_deep().at(i)+= tmp; b.out_sys_bctag_tight_deep().at(i) = tmp;
+        tmp = fix_b_wgt ? bw(BW::kOpTight, udsg[i])           : b.sys_udsgtag_tight_deep().at(i);
+        c.out_sys_udsgtag_tight_deep().at(i)+= tmp; b.out_sys_udsgtag_tight_deep().at(i) = tmp;
+      } // loop over 2 sys
+    } // if quick
+  }
+
+  template<typename T, typename U>
+  void CopySize(const vector<T> &in, vector<U> &out){
+    out = vector<U>(in.size(), static_cast<U>(0.));
+  }
+
+  void Initialize(baby_corr &in, baby_corr &out){
+    out.out_w_bhig_deep() = 0.;
+    out.out_w_btag_deep() = 0.;
+    out.out_w_btag_loose_deep() = 0.;
+    out.out_w_btag_tight_deep() = 0.;
+    out.out_w_btag_shape_deep() = 0.;
+    out.out_w_fs_lep() = 0.;
+    out.out_w_isr() = 0.;
+    out.out_w_lep() = 0.;
+    out.out_w_lumi() = 0.;
+    out.out_w_pu() = 0.;
+    out.out_weight() = 0.;
+
+    out.out_neff() = 0.;
+
+    CopySize(in.sys_bchig_deep(),         out.out_sys_bchig_deep());
+    CopySize(in.sys_bctag_deep(),         out.out_sys_bctag_deep());
+    CopySize(in.sys_bctag_loose_deep(),   out.out_sys_bctag_loose_deep());
+    CopySize(in.sys_bctag_tight_deep(),   out.out_sys_bctag_tight_deep());
+    CopySize(in.sys_btag_shape_deep(),    out.out_sys_btag_shape_deep());
+    CopySize(in.sys_fs_bchig_deep(),      out.out_sys_fs_bchig_deep());
+    CopySize(in.sys_fs_bctag_deep(),      out.out_sys_fs_bctag_deep());
+    CopySize(in.sys_fs_lep(),             out.out_sys_fs_lep());
+    CopySize(in.sys_fs_udsghig_deep(),    out.out_sys_fs_udsghig_deep());
+    CopySize(in.sys_fs_udsgtag_deep(),    out.out_sys_fs_udsgtag_deep());
+    CopySize(in.sys_isr(),                out.out_sys_isr());
+    CopySize(in.sys_lep(),                out.out_sys_lep());
+    CopySize(in.sys_muf(),                out.out_sys_muf());
+    CopySize(in.sys_mur(),                out.out_sys_mur());
+    CopySize(in.sys_murf(),               out.out_sys_murf());
+    CopySize(in.sys_pdf(),                out.out_sys_pdf());
+    CopySize(in.sys_pu(),                 out.out_sys_pu());
+    CopySize(in.sys_udsghig_deep(),       out.out_sys_udsghig_deep());
+    CopySize(in.sys_udsgtag_deep(),       out.out_sys_udsgtag_deep());
+    CopySize(in.sys_udsgtag_loose_deep(), out.out_sys_udsgtag_loose_deep());
+    CopySize(in.sys_udsgtag_tight_deep(), out.out_sys_udsgtag_tight_deep());
+    CopySize(in.w_pdf(),                  out.out_w_pdf());
+  }
+
+  template<typename T, typename U>
+  void VecAdd(const vector<T> &in, vector<U> &out){
+    for(size_t i = 0; i < in.size(); ++i){
+      out.at(i) += in.at(i);
+    }
+  }
+
+  void AddEntry(baby_corr &in, baby_corr &out){
+    out.out_neff() += in.neff();
+    out.out_nent() += in.nent();
+    out.out_nent_zlep() += in.nent_zlep();
+    out.out_tot_weight_l0() += in.tot_weight_l0();
+    out.out_tot_weight_l1() += in.tot_weight_l1();
+
+    out.out_w_bhig_deep()       += in.w_bhig_deep();
+    out.out_w_btag_deep()       += in.w_btag_deep();
+    out.out_w_btag_loose_deep() += in.w_btag_loose_deep();
+    out.out_w_btag_tight_deep() += in.w_btag_tight_deep();
+    out.out_w_btag_shape_deep() += in.w_btag_shape_deep();
+    out.out_w_fs_lep()          += in.w_fs_lep();
+    out.out_w_isr()             += in.w_isr();
+    out.out_w_lep()             += in.w_lep();
+    out.out_w_pu()              += in.w_pu();
+    out.out_weight()            += in.weight();
+
+    VecAdd(in.sys_bchig_deep(),         out.out_sys_bchig_deep());
+    VecAdd(in.sys_bctag_deep(),         out.out_sys_bctag_deep());
+    VecAdd(in.sys_bctag_loose_deep(),   out.out_sys_bctag_loose_deep());
+    VecAdd(in.sys_bctag_tight_deep(),   out.out_sys_bctag_tight_deep());
+    VecAdd(in.sys_btag_shape_deep(),    out.out_sys_btag_shape_deep());
+    VecAdd(in.sys_fs_bchig_deep(),      out.out_sys_fs_bchig_deep());
+    VecAdd(in.sys_fs_bctag_deep(),      out.out_sys_fs_bctag_deep());
+    VecAdd(in.sys_fs_lep(),             out.out_sys_fs_lep());
+    VecAdd(in.sys_fs_udsghig_deep(),    out.out_sys_fs_udsghig_deep());
+    VecAdd(in.sys_fs_udsgtag_deep(),    out.out_sys_fs_udsgtag_deep());
+    VecAdd(in.sys_isr(),                out.out_sys_isr());
+    VecAdd(in.sys_lep(),                out.out_sys_lep());
+    VecAdd(in.sys_muf(),                out.out_sys_muf());
+    VecAdd(in.sys_mur(),                out.out_sys_mur());
+    VecAdd(in.sys_murf(),               out.out_sys_murf());
+    VecAdd(in.sys_pdf(),                out.out_sys_pdf());
+    VecAdd(in.sys_pu(),                 out.out_sys_pu());
+    VecAdd(in.sys_udsghig_deep(),       out.out_sys_udsghig_deep());
+    VecAdd(in.sys_udsgtag_deep(),       out.out_sys_udsgtag_deep());
+    VecAdd(in.sys_udsgtag_loose_deep(), out.out_sys_udsgtag_loose_deep());
+    VecAdd(in.sys_udsgtag_tight_deep(), out.out_sys_udsgtag_tight_deep());
+    VecAdd(in.w_pdf(),                  out.out_w_pdf());
+  }
+
+  int GetGluinoMass(const string &path){
+    string key = "_mGluino-";
+    auto pos1 = path.rfind(key)+key.size();
+    auto pos2 = path.find("_", pos1);
+    string mass_string = path.substr(pos1, pos2-pos1);
+    return stoi(mass_string);
+  }
+
+  void FixLumi(baby_corr &out, const string &out_path){
+    double xsec(0.); const float lumi = 1000.;
+    if (Contains(out_path, "SMS")){
+      double exsec(0.);
+      int mglu = GetGluinoMass(out_path);
+      if(Contains(out_path, "T1") || Contains(out_path, "T5")){
+        xsec::signalCrossSection(mglu, xsec, exsec);
+      }else if(Contains(out_path, "TChiHH")){
+        xsec::higgsinoCrossSection(mglu, xsec, exsec);
+      }else{
+        xsec::stopCrossSection(mglu, xsec, exsec);
+      }
+    }else{
+      xsec = xsec::crossSection(out_path);
+    }
+
+    out.out_w_lumi() = xsec*lumi/out.out_neff();
+  }
+
+  void FixISR(baby_corr &out, const string &out_path){
+    double corr_w_isr(1.);
+    vector<double> corr_sys_isr(2,1.);
+    double tot_w_isr = out.out_w_isr();
+    if(Contains(out_path,"TTJets_HT") || Contains(out_path,"genMET-150")){
+      // in this case take correction from inclusive since should not norm. to unity
+      corr_w_isr = 1/1.013;
+      corr_sys_isr[0] = 1/1.065;
+      corr_sys_isr[1] = 1/0.9612;
+    }else{
+      corr_w_isr = out.out_w_isr() ? out.out_nent()/out.out_w_isr() : 1.;
+      for(size_t i = 0; i<out.out_sys_isr().size(); i++){
+        corr_sys_isr[i] = out.out_sys_isr()[i] ? out.out_nent()/out.out_sys_isr()[i] : 1.;
+      }
+    }
+    out.out_w_isr() = corr_w_isr;
+    for(size_t i = 0; i<out.out_sys_isr().size(); i++){
+      out.out_sys_isr()[i] = corr_sys_isr[i];
+    }
+    double nent = out.out_nent();
+    double nent_zlep = out.out_nent_zlep();
+
+    // Calculate correction to total weight whilst correcting zero lepton
+    //----------------------------------------------------------------------
+    double w_corr_l0 = 1.;
+    if (out.out_w_lep()) w_corr_l0 *= (nent-out.out_w_lep())/nent_zlep;
+    if (out.out_w_fs_lep()) w_corr_l0 *= (nent-out.out_w_fs_lep())/nent_zlep;
+    if(nent_zlep==0) w_corr_l0 = 1.;
+    // again normalize to total w_isr, not unity
+    out.out_weight() = (tot_w_isr*corr_w_isr)/(out.out_tot_weight_l0()*w_corr_l0 + out.out_tot_weight_l1());
+  }
+
+  void Fix0L(baby_corr &out){
+    double nent = out.out_nent();
+    double nent_zlep = out.out_nent_zlep();
+
+    // Lepton weights corrections to be applied only to 0-lep events
+    //----------------------------------------------------------------
+    out.out_w_lep()           = out.out_w_lep() ? (nent-out.out_w_lep())/nent_zlep : 1.;
+    out.out_w_fs_lep()        = out.out_w_fs_lep() ? (nent-out.out_w_fs_lep())/nent_zlep : 1.;
+    for(size_t i = 0; i<out.out_sys_lep().size(); i++){
+      out.out_sys_lep()[i]    = out.out_sys_lep()[i] ? (nent-out.out_sys_lep()[i])/nent_zlep : 1.;
+    }
+    for(size_t i = 0; i<out.out_sys_fs_lep().size(); i++){
+      out.out_sys_fs_lep()[i] = out.out_sys_fs_lep()[i] ? (nent-out.out_sys_fs_lep()[i])/nent_zlep : 1.;
+    }
+  }
+
+  template<typename T>
+  void Normalize(T &x, double nent){
+    x = x ? nent/x : 1.;
+  }
+
+  template<typename T>
+  void Normalize(vector<T> &v, double nent){
+    for(auto &x: v) x = x ? nent/x : 1.;
+  }
+
+  void Normalize(baby_corr &out){
+    double nent = out.out_nent();
+
+    Normalize(out.out_w_pu(), nent);
+
+    Normalize(out.out_w_btag_deep(), nent);
+
+    Normalize(out.out_w_bhig_deep(), nent);
+
+    Normalize(out.out_w_btag_shape_deep(), nent);
+    Normalize(out.out_sys_btag_shape_deep(), nent);
+
+    Normalize(out.out_sys_bctag_deep(), nent);
+    Normalize(out.out_sys_udsgtag_deep(), nent);
+
+    Normalize(out.out_sys_bchig_deep(), nent);
+    Normalize(out.out_sys_udsghig_deep(), nent);
+
+    Normalize(out.out_sys_mur(), nent);
+    Normalize(out.out_sys_muf(), nent);
+    Normalize(out.out_sys_murf(), nent);
+
+    Normalize(out.out_sys_fs_bctag_deep(), nent);
+    Normalize(out.out_sys_fs_udsgtag_deep(), nent);
+    Normalize(out.out_sys_fs_bchig_deep(), nent);
+    Normalize(out.out_sys_fs_udsghig_deep(), nent);
+
+    Normalize(out.out_w_btag_loose_deep(), nent);
+    Normalize(out.out_w_btag_tight_deep(), nent);
+
+    Normalize(out.out_w_pdf(), nent);
+
+    Normalize(out.out_sys_pu(), nent);
+    Normalize(out.out_sys_pdf(), nent);
+
+    Normalize(out.out_sys_bctag_loose_deep(), nent);
+    Normalize(out.out_sys_udsgtag_loose_deep(), nent);
+    Normalize(out.out_sys_bctag_tight_deep(), nent);
+    Normalize(out.out_sys_udsgtag_tight_deep(), nent);
+  }
+
+  void ApplyEntry(baby_plus &b, baby_corr &c, bool isSignal, bool quick, bool has_shape_b_wgt){
+    if (b.type() == 106e3) { // TCHiHH
+      // trigger efficiency and uncertainty
+      hig_utils::TrigEff trig = hig_utils::higtrig(b);
+      b.out_eff_trig() = trig.eff;
+      b.out_sys_trig();
+      b.out_sys_trig().at(0) = 1+trig.unc;
+      b.out_sys_trig().at(1) = 1-trig.unc;
+      // fix mass point branch
+      b.out_mgluino() = hig_utils::mchi(b);
+    }
+
+    b.out_baseline() = b.pass_ra2_badmu() && b.met()/b.met_calo()<5
+                       && b.nleps()==1 && b.nveto()==0 && b.met()>200
+                       && b.st()>500 && b.njets()>=6 && b.nbm()>=1;
+    if (!isSignal) b.out_baseline() = b.out_baseline() && b.pass();
+
+    if(b.nleps()==0) { // load from calculated correction
+      b.out_w_lep()         = c.w_lep();
+      b.out_w_fs_lep()      = c.w_fs_lep();
+      for (unsigned i(0); i<b.sys_lep().size(); i++)
+        b.out_sys_lep()[i] = c.sys_lep()[i];
+      for (unsigned i(0); i<b.sys_fs_lep().size(); i++)
+        b.out_sys_fs_lep()[i] = c.sys_fs_lep()[i];
+    } // otherwise keep the per-event values, read from the original tree or the weight cache
+
+    b.out_w_lumi() = b.w_lumi()>0 ? 1. : -1.;
+    b.out_w_lumi() *= c.w_lumi();
+
+    b.out_weight() = c.weight() *b.out_w_lumi()
+                     *b.out_w_lep() *b.out_w_fs_lep() //post-corr values in order for 0l to be correct
+                     *b.out_w_btag_deep() *b.w_isr() *b.eff_jetid() *b.w_pu();
+
+    b.out_w_isr() = c.w_isr()*b.w_isr();
+    for (unsigned i(0); i<b.sys_isr().size(); i++)
+      b.out_sys_isr()[i] = c.sys_isr()[i]*b.sys_isr()[i];
+
+    //      Cookie-cutter variables
+    //-----------------------------------
+    b.out_w_pu()                   *= c.w_pu();
+    b.out_w_btag_deep()            *= c.w_btag_deep();
+
+    b.out_w_bhig_deep()            *= c.w_bhig_deep();
+
+    if (has_shape_b_wgt) {
+      b.out_w_btag_shape_deep()      *= c.w_btag_shape_deep();
+      for (unsigned i(0); i<b.out_sys_btag_shape_deep().size() && i<c.sys_btag_shape_deep().size(); i++)
+        b.out_sys_btag_shape_deep()[i]         *= c.sys_btag_shape_deep()[i];
+    }
+
+    for (unsigned i(0); i<2; i++) {
+      b.out_sys_bctag_deep()[i]              *= c.sys_bctag_deep()[i];
+      b.out_sys_udsgtag_deep()[i]            *= c.sys_udsgtag_deep()[i];
+
+      b.out_sys_bchig_deep()[i]              *= c.sys_bchig_deep()[i];
+      b.out_sys_udsghig_deep()[i]            *= c.sys_udsghig_deep()[i];
+
+      if (isSignal) { // yes, this ignores the fullsim points
+        b.out_sys_mur()[i]                     *= c.sys_mur()[i];
+        b.out_sys_muf()[i]                     *= c.sys_muf()[i];
+        b.out_sys_murf()[i]                    *= c.sys_murf()[i];
+
+        b.out_sys_fs_bctag_deep()[i]         *= c.sys_fs_bctag_deep()[i];
+        b.out_sys_fs_udsgtag_deep()[i]       *= c.sys_fs_udsgtag_deep()[i];
+        b.out_sys_fs_bchig_deep()[i]         *= c.sys_fs_bchig_deep()[i];
+        b.out_sys_fs_udsghig_deep()[i]       *= c.sys_fs_udsghig_deep()[i];
+      }
+    }
+
+    if (!quick) {
+      b.out_w_btag_loose_deep()      *= c.w_btag_loose_deep();
+      b.out_w_btag_tight_deep()      *= c.w_btag_tight_deep();
+
+      for (unsigned i(0); i<b.w_pdf().size(); i++) b.out_w_pdf()[i] *= c.w_pdf()[i];
+
+      for (unsigned i(0); i<b.sys_mur().size(); i++) {
+        b.out_sys_pu()[i]                      *= c.sys_pu()[i];
+        // b.out_sys_pdf()[i]                     *= c.sys_pdf()[i];
+
+        b.out_sys_bctag_loose_deep()[i]        *= c.sys_bctag_loose_deep()[i];
+        b.out_sys_udsgtag_loose_deep()[i]      *= c.sys_udsgtag_loose_deep()[i];
+        b.out_sys_bctag_tight_deep()[i]        *= c.sys_bctag_tight_deep()[i];
+        b.out_sys_udsgtag_tight_deep()[i]      *= c.sys_udsgtag_tight_deep()[i];
+      } // loop over 2 sys
+    } // if quick
+  }
+
+  vector<string> CacheColumns(){
+    vector<string> columns;
+    for(const auto &weight: scalar_weights) columns.push_back(weight.name);
+    for(const auto &weight: vector_weights){
+      for(size_t i = 0; i < weight.size; ++i) columns.push_back(weight.name+"["+to_string(i)+"]");
+    }
+    return columns;
+  }
+
+  void CheckCache(const WeightCache &cache, long nent){
+    if(cache.Columns() != CacheColumns()) ERROR("Weight cache was written with a different set of columns");
+    if(cache.GetEntries() != nent) ERROR("Weight cache has "+to_string(cache.GetEntries())+" entries, input has "+to_string(nent));
+  }
+
+  void WriteCache(baby_plus &b, WeightCacheWriter &cache, long entry){
+    size_t icol = 0;
+    for(const auto &weight: scalar_weights){
+      cache.Column(icol++)[entry] = (b.*weight.weight)();
+    }
+    for(const auto &weight: vector_weights){
+      const vector<float> &values = (b.*weight.weight)();
+      for(size_t i = 0; i < weight.size; ++i){
+        cache.Column(icol++)[entry] = i < values.size() ? values[i] : numeric_limits<float>::quiet_NaN();
+      }
+    }
+  }
+
+  void ReadCache(const WeightCache &cache, baby_plus &b, long entry){
+    size_t icol = 0;
+    for(const auto &weight: scalar_weights){
+      (b.*weight.set_weight)() = cache.Column(icol++)[entry];
+    }
+    for(const auto &weight: vector_weights){
+      vector<float> &values = (b.*weight.set_weight)();
+      values.clear();
+      for(size_t i = 0; i < weight.size; ++i){
+        float value = cache.Column(icol++)[entry];
+        if(!isnan(value)) values.push_back(value); // NaN marks entries missing from shorter vectors
+      }
+    }
+  }
+}
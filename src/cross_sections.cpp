@@ -1,980 +1,1158 @@
 // Lists the MC cross sections
+//
+// Samples are found by the patterns their file names contain, all matched
+// in one pass by a PatternMatcher built on first use. When several samples
+// match, the one of highest priority is used, and a tie between different
+// values is reported. Signal scans are tables sorted by mass.
 
+#include <algorithm>
+#include <cmath>
 #include <iostream>
+#include <string>
+#include <vector>
+
 #include "cross_sections.hpp"
+#include "pattern_matcher.hpp"
+#include "utilities.hpp"
 
 using namespace std;
 
-namespace xsec{
+namespace{
+  const float Htobb = 0.5824;
 
-  float crossSection(const TString &file){
-    float xsec(999999.), Htobb(0.5824);
-
-    if(file.Contains("SMS-T1qqqq_mGluino-1000_mLSP-800_Tune")) xsec = 0.325388;
-    if(file.Contains("SMS-T1qqqq_mGluino-1400_mLSP-100_Tune")) xsec = 0.0252977;
-    if(file.Contains("SMS-T1tttt_mGluino-1200_mLSP-800_Tune")) xsec = 0.0856418;
-    if(file.Contains("SMS-T1tttt_mGluino-1500_mLSP-100_Tune")) xsec = 0.0141903;
-    if(file.Contains("SMS-T1tttt_mGluino-2000_mLSP-100_Tune")) xsec = 0.000981077;
-    if(file.Contains("SMS-T2tt_mStop-225_mLSP-50_Tune")) xsec = 36.3818;
-    if(file.Contains("SMS-T2tt_mStop-425_mLSP-325_Tune")) xsec = 1.31169;
-    if(file.Contains("SMS-T2tt_mStop-850_mLSP-100_Tune")) xsec = 0.0189612;
-
-    if(file.Contains("RPV") && file.Contains("1000"))  xsec = 0.325388;
-    if(file.Contains("RPV") && file.Contains("1100"))  xsec = 0.163491;
-    if(file.Contains("RPV") && file.Contains("1200"))  xsec = 0.0856418;
-    if(file.Contains("RPV") && file.Contains("1300"))  xsec = 0.0460525;
-    if(file.Contains("RPV") && file.Contains("1400"))  xsec = 0.0252977;
-
-
-    //  Cross-section taken from https://twiki.cern.ch/twiki/bin/view/LHCPhysics/TtbarNNLO
-    // Alternative option: https://twiki.cern.ch/twiki/bin/view/Sandbox/FullNNLOcrossSections#Top_cross_section_for_13_TeV
-    if(file.Contains("TTJets_Tune") || file.Contains("TT_"))  xsec = 815.96;
-    if(file.Contains("TTJets_HT")){//LO cross sections with k-factor of 1.625 already applied
-      if(file.Contains("2500toInf")) xsec = 0.0023234211;
-      if(file.Contains("1200to2500")) xsec = 0.194972521;
-      if(file.Contains("800to1200")) xsec = 1.07722318;
-      if(file.Contains("600to800")) xsec = 2.61537118;
+  // Among the samples matching a file name, the highest priority wins
+  enum Priority{
+    kInclusive = 0, // Patterns contained in the names of other samples
+    kSample = 1,
+    kFiltered = 2   // Filtered subsets of a kSample sample, matching it too
+  };
+
+  // Samples whose file names contain all the patterns
+  struct SampleRule{
+    vector<string> patterns;
+    double value;
+    Priority priority;
+  };
+
+  string Describe(const SampleRule &rule){
+    string out;
+    for(const auto &pattern: rule.patterns) out += (out.empty() ? "\"" : " && \"")+pattern+"\"";
+    return out;
+  }
+
+  class SampleRegistry{
+  public:
+    SampleRegistry(const string &quantity, const vector<SampleRule> &rules);
+
+    // Matching rules, best first: highest priority, then last listed
+    vector<const SampleRule*> Matches(const string &name) const;
+    // Value of the best match, default_value if none
+    double Find(const string &name, double default_value) const;
+
+  private:
+    string quantity_;
+    vector<SampleRule> rules_;
+    PatternMatcher matcher_;
+    vector<vector<size_t> > rules_of_pattern_; // Rules by their first pattern
+    vector<vector<size_t> > patterns_of_rule_;
+  };
 
+  SampleRegistry::SampleRegistry(const string &quantity, const vector<SampleRule> &rules):
+    quantity_(quantity),
+    rules_(rules),
+    matcher_(),
+    rules_of_pattern_(),
+    patterns_of_rule_(rules.size()){
+    vector<string> patterns;
+    for(size_t irule = 0; irule < rules_.size(); ++irule){
+      if(rules_[irule].patterns.empty()) ERROR("No pattern for "+quantity_+" rule "+to_string(irule));
+      for(const auto &pattern: rules_[irule].patterns){
+        size_t ipattern = find(patterns.begin(), patterns.end(), pattern) - patterns.begin();
+        if(ipattern == patterns.size()){
+          patterns.push_back(pattern);
+          rules_of_pattern_.push_back(vector<size_t>());
+        }
+        patterns_of_rule_[irule].push_back(ipattern);
+      }
+      rules_of_pattern_[patterns_of_rule_[irule].front()].push_back(irule);
     }
-    // The efficiency of the mtt>1000 cut is taken from sigma(mtt>1000)/sigma(inclusive) from mcm
-    double mtt_1000_eff=(11.16/670.3);
-    if(file.Contains("TTJets_Mtt-1000toInf")) xsec = 815.96*mtt_1000_eff;
-
-    if(file.Contains("TTJets_DiLept") || file.Contains("TTTo2L2Nu")) xsec = 85.66; // (3*0.108)^2*815.96
-    if(file.Contains("TTJets_SingleLept")) xsec = 178.7; //(1- ((1-3*0.108)^2+(3*0.108)^2))*815.96*0.5 per half
-    if(file.Contains("TTToSemiLeptonic")) xsec = 357.4;
-    
-    if(file.Contains("TTJets_DiLept_genMET-150")) xsec = 0.06392*85.66; // filter_eff*(3*0.108)^2*815.96
-    if(file.Contains("TTJets_SingleLept") && file.Contains("genMET-150")) xsec = 0.05217*178.7; //filter_eff*(1- ((1-3*0.108)^2+(3*0.108)^2))*815.96*0.5 per half
-
-    // cross sections from mcm
-    if(file.Contains("TTG")) xsec = 3.697;                
-    if(file.Contains("TTTT_Tune")) xsec = 0.009103;
-    // mcm cross section times the same kfactors used for leptonic samples
-    if(file.Contains("WJetsToQQ_HT-600ToInf")) xsec = 95.14*1.21;
-    if(file.Contains("ZJetsToQQ_HT600toInf")) xsec = 5.67*1.23;
-    
-    // From https://cms-pdmv.cern.ch/mcm
-    // k-factors from https://mangano.web.cern.ch/mangano/public/MECCA/samples_50ns_miniaod.txt
-    // k-factors are ratio of https://twiki.cern.ch/twiki/bin/viewauth/CMS/StandardModelCrossSectionsat13TeV
-    // NLO/NNLO cross-sections to that of an inclusive sample in mcm at lower order (LO/NLO)
-
-    if(file.Contains("WJetsToLNu_Tune")) xsec=61526.7; //NNLO from Lesya's summary table 
-
-    //cross-section per slice changed due to change in genHT definition
-    if(file.Contains("WJetsToLNu_HT-70To100"))  xsec = 1372.*1.21; 
-    if(file.Contains("WJetsToLNu_HT-100To200"))  xsec = 1347.*1.21; 
-    if(file.Contains("WJetsToLNu_HT-200To400"))  xsec = 360.*1.21;
-    if(file.Contains("WJetsToLNu_HT-400To600"))  xsec = 48.98*1.21;
-    if(file.Contains("WJetsToLNu_HT-600ToInf"))  xsec = 18.77*1.21;
-    if(file.Contains("WJetsToLNu_HT-600To800"))  xsec = 12.05*1.21;
-    if(file.Contains("WJetsToLNu_HT-800To1200"))  xsec = 5.501*1.21;
-    if(file.Contains("WJetsToLNu_HT-1200To2500"))  xsec = 1.329*1.21;
-    if(file.Contains("WJetsToLNu_HT-2500ToInf"))  xsec = 0.03216*1.21;
-
-    if(file.Contains("QCD_HT50to100_Tune")) xsec = 1; // not in MCM, need to derive
-    if(file.Contains("QCD_HT100to200_Tune")) xsec = 27540000;
-    if(file.Contains("QCD_HT200to300_Tune"))   xsec = 1735000;
-    if(file.Contains("QCD_HT300to500_Tune"))   xsec = 366800;
-    if(file.Contains("QCD_HT500to700_Tune"))   xsec = 29370;
-    if(file.Contains("QCD_HT700to1000_Tune"))  xsec = 6524;
-    if(file.Contains("QCD_HT1000to1500_Tune")) xsec = 1064;
-    if(file.Contains("QCD_HT1500to2000_Tune")) xsec = 121.5;
-    if(file.Contains("QCD_HT2000toInf_Tune"))  xsec = 25.42;
-
-    // Cross sections from https://twiki.cern.ch/twiki/bin/view/LHCPhysics/SingleTopRefXsec
-    // multiplied by BF(W->mu,e,tau) = 0.324
-    if (file.Contains("ST_s-channel_4f_leptonDecays"))     xsec = 3.34;
-    if (file.Contains("ST_t-channel_antitop_4f_inclusiveDecays")) xsec = 80.95;
-    if (file.Contains("ST_t-channel_top_4f_inclusiveDecays")) xsec = 136.02;
-    if (file.Contains("ST_tW_antitop_5f_NoFullyHadronicDecays"))     xsec = 35.85*0.543;
-    if (file.Contains("ST_tW_top_5f_NoFullyHadronicDecays"))     xsec = 35.85*0.543; 
-
-    if(file.Contains("DYJetsToLL_M-10to50_TuneCUETP8M1_13TeV")) xsec = 18610*1.23;
-    if(file.Contains("DYJetsToLL_M-50_TuneCUETP8M1_13TeV"))     xsec = 4895*1.23;
-
-    if(file.Contains("DYJetsToLL_M-50_HT-70to100"))    xsec = 175.3*1.23;
-    if(file.Contains("DYJetsToLL_M-50_HT-100to200"))    xsec = 139.4*1.23;
-    if(file.Contains("DYJetsToLL_M-50_HT-200to400"))    xsec = 42.75*1.23;
-    if(file.Contains("DYJetsToLL_M-50_HT-400to600"))    xsec = 5.497*1.23;
-    if(file.Contains("DYJetsToLL_M-50_HT-600to800"))    xsec = 1.363*1.23;
-    if(file.Contains("DYJetsToLL_M-50_HT-800to1200"))    xsec = 0.6759*1.23;
-    if(file.Contains("DYJetsToLL_M-50_HT-1200to2500"))    xsec = 0.116*1.23;
-    if(file.Contains("DYJetsToLL_M-50_HT-2500toInf"))    xsec = 0.002592*1.23;
-    if(file.Contains("DYJetsToLL_M-50_HT-600toInf"))    xsec = 2.21*1.23;
-
-    if(file.Contains("ZJetsToNuNu_HT-100To200"))  xsec = 280.35*1.27;
-    if(file.Contains("ZJetsToNuNu_HT-200To400"))  xsec = 77.67*1.27;
-    if(file.Contains("ZJetsToNuNu_HT-400To600"))  xsec = 10.73*1.27;
-    if(file.Contains("ZJetsToNuNu_HT-600To800"))  xsec = 2.536*1.27;
-    if(file.Contains("ZJetsToNuNu_HT-800To1200"))  xsec = 1.161*1.27;
-    if(file.Contains("ZJetsToNuNu_HT-1200To2500"))  xsec = 0.2824*1.27;
-    if(file.Contains("ZJetsToNuNu_HT-2500ToInf"))  xsec = 0.006459*1.27;
-    if(file.Contains("ZJetsToNuNu_HT-600ToInf"))  xsec = 3.986*1.27;
-
-    if(file.Contains("TTZToQQ"))                xsec = 0.5297;
-    if(file.Contains("TTZToLLNuNu_M-10"))       xsec = 0.2529;
-    if(file.Contains("TTWJetsToQQ"))            xsec = 0.4062;
-    if(file.Contains("TTWJetsToLNu"))           xsec = 0.2043;
-   
-    //https://twiki.cern.ch/twiki/bin/viewauth/CMS/SummaryTable1G25ns#Diboson
-    if(file.Contains("WWTo2L2Nu"))   xsec = 12.178; //NNLO
-    if(file.Contains("WWToLNuQQ"))   xsec = 49.997; //NNLO
-    if(file.Contains("ttHTobb_M125"))   xsec = 0.2934;
-
-    if(file.Contains("WZTo1L3Nu"))   xsec = 3.05;
-    if(file.Contains("WZTo1L1Nu2Q"))   xsec = 10.96;
-    if(file.Contains("WZTo2L2Q"))   xsec = 5.595;
-    if(file.Contains("WZTo3LNu"))   xsec = 4.42965;
-    if(file.Contains("VVTo2L2Nu"))   xsec = 11.95;
-    if(file.Contains("ZZ_Tune"))   xsec = 16.523;
-
-    // Calculated at 13 TeV in
-    // https://twiki.cern.ch/twiki/bin/view/LHCPhysics/CERNYellowReportPageAt1314TeV
-    // Higgs branching ratios from
-    // https://twiki.cern.ch/twiki/bin/view/LHCPhysics/CERNYellowReportPageBR
-    if(file.Contains("ZH_HToBB_ZToLL_M-125"))      xsec = 0.883*Htobb*0.033658;
-    if(file.Contains("ZH_HToBB_ZToNuNu_M-125"))    xsec = 0.883*Htobb*0.2;
-    if(file.Contains("WH_HToBB_WToLNu_M-125"))     xsec = 1.373*Htobb*(0.1071+0.1063+0.1138);
-    if(file.Contains("ZH_HToBB_ZToNuNu_M125"))    xsec = 0.883*Htobb*0.2;
-    if(file.Contains("WH_HToBB_WToLNu_M125"))     xsec = 1.373*Htobb*(0.1071+0.1063+0.1138);
+    matcher_ = PatternMatcher(patterns);
+  }
 
-    if(xsec<=0) std::cout<<"BABYMAKER: Cross section not found for "<<file<<std::endl;
+  vector<const SampleRule*> SampleRegistry::Matches(const string &name) const{
+    vector<size_t> found = matcher_.Find(name);
+    vector<bool> is_found(matcher_.Size(), false);
+    for(size_t ipattern: found) is_found[ipattern] = true;
 
-    return xsec;
+    vector<size_t> matches;
+    for(size_t ipattern: found){
+      for(size_t irule: rules_of_pattern_[ipattern]){
+        bool all = true;
+        for(size_t other: patterns_of_rule_[irule]) all = all && is_found[other];
+        if(all) matches.push_back(irule);
+      }
+    }
+    sort(matches.begin(), matches.end(), [this](size_t a, size_t b){
+        return rules_[a].priority != rules_[b].priority ? rules_[a].priority > rules_[b].priority : a > b;
+      });
+
+    vector<const SampleRule*> rules;
+    for(size_t irule: matches) rules.push_back(&rules_[irule]);
+    return rules;
   }
 
-  float fractionNegWeights(const TString &file){
-    float fneg(0.);
+  double SampleRegistry::Find(const string &name, double default_value) const{
+    vector<const SampleRule*> matches = Matches(name);
+    if(matches.empty()) return default_value;
+    for(size_t i = 1; i < matches.size() && matches[i]->priority == matches.front()->priority; ++i){
+      if(matches[i]->value == matches.front()->value) continue;
+      cout << "BABYMAKER: Ambiguous " << quantity_ << " for " << name << ": "
+           << Describe(*matches.front()) << " (" << matches.front()->value << ") and "
+           << Describe(*matches[i]) << " (" << matches[i]->value << "); using the first" << endl;
+    }
+    return matches.front()->value;
+  }
 
-    // ttH, ttZ, ttW, ttGamma
-    if(file.Contains("ttHJetTobb_M125_13TeV_amcatnloFXFX"))     fneg = 0.3515;
-    if(file.Contains("TTZToQQ"))                                fneg = 0.2657;
-    if(file.Contains("TTZToLLNuNu_M-10"))                       fneg = 0.2676;
-    if(file.Contains("TTWJetsToQQ"))                            fneg = 0.2412;
-    if(file.Contains("TTWJetsToLNu"))                           fneg = 0.2433;
-    if(file.Contains("TTG"))                                    fneg = 0.342; // from MCM
+  struct MassPoint{
+    int mass;
+    double xsec, xsec_unc;
+  };
 
-    if(file.Contains("TTTT_TuneCUETP8M1_13TeV-amcatnlo"))       fneg = 0.41; // from MCM
-    if(file.Contains("VVTo2L2Nu_13TeV_amcatnloFXFX"))       fneg = 0.20; // from MCM
-    if(file.Contains("TTJets_Mtt-1000toInf"))                   fneg = 0.376996;
+  // Cross sections at increasing masses
+  class MassScan{
+  public:
+    MassScan(const string &name, const vector<MassPoint> &points);
 
-    // Single top
-    if (file.Contains("ST_s-channel_4f_leptonDecays_13TeV-amcatnlo-pythia8")) fneg = 0.1884;
+    // Off-grid masses give 0, or with interpolate the interpolation between
+    // the neighbouring points, exponential in the cross section
+    void Find(int mass, bool interpolate, double &xsec, double &xsec_unc) const;
 
-    return fneg;
+  private:
+    vector<MassPoint> points_;
+  };
+
+  MassScan::MassScan(const string &name, const vector<MassPoint> &points):
+    points_(points){
+    for(size_t i = 1; i < points_.size(); ++i){
+      if(points_[i].mass <= points_[i-1].mass) ERROR("Masses of the "+name+" scan not increasing at "+to_string(points_[i].mass));
+    }
+  }
+
+  void MassScan::Find(int mass, bool interpolate, double &xsec, double &xsec_unc) const{
+    xsec = 0.; xsec_unc = 0.;
+    auto above = lower_bound(points_.cbegin(), points_.cend(), mass,
+                             [](const MassPoint &point, int m){return point.mass < m;});
+    if(above == points_.cend()) return;
+    if(above->mass == mass){
+      xsec = above->xsec; xsec_unc = above->xsec_unc;
+      return;
+    }
+    if(!interpolate || above == points_.cbegin()) return;
+    const MassPoint &below = *(above-1);
+    double frac = static_cast<double>(mass-below.mass)/(above->mass-below.mass);
+    xsec = below.xsec*pow(above->xsec/below.xsec, frac);
+    xsec_unc = below.xsec_unc+frac*(above->xsec_unc-below.xsec_unc);
   }
 
+  const SampleRegistry & CrossSections(){
+    static const SampleRegistry registry("cross section", {
+        {{"SMS-T1qqqq_mGluino-1000_mLSP-800_Tune"}, 0.325388, kSample},
+        {{"SMS-T1qqqq_mGluino-1400_mLSP-100_Tune"}, 0.0252977, kSample},
+        {{"SMS-T1tttt_mGluino-1200_mLSP-800_Tune"}, 0.0856418, kSample},
+        {{"SMS-T1tttt_mGluino-1500_mLSP-100_Tune"}, 0.0141903, kSample},
+        {{"SMS-T1tttt_mGluino-2000_mLSP-100_Tune"}, 0.000981077, kSample},
+        {{"SMS-T2tt_mStop-225_mLSP-50_Tune"}, 36.3818, kSample},
+        {{"SMS-T2tt_mStop-425_mLSP-325_Tune"}, 1.31169, kSample},
+        {{"SMS-T2tt_mStop-850_mLSP-100_Tune"}, 0.0189612, kSample},
+
+        {{"RPV", "1000"}, 0.325388, kSample},
+        {{"RPV", "1100"}, 0.163491, kSample},
+        {{"RPV", "1200"}, 0.0856418, kSample},
+        {{"RPV", "1300"}, 0.0460525, kSample},
+        {{"RPV", "1400"}, 0.0252977, kSample},
+
+        //  Cross-section taken from https://twiki.cern.ch/twiki/bin/view/LHCPhysics/TtbarNNLO
+        // Alternative option: https://twiki.cern.ch/twiki/bin/view/Sandbox/FullNNLOcrossSections#Top_cross_section_for_13_TeV
+        {{"TTJets_Tune"}, 815.96, kInclusive},
+        {{"TT_"}, 815.96, kInclusive},
+        //LO cross sections with k-factor of 1.625 already applied
+        {{"TTJets_HT", "2500toInf"}, 0.0023234211, kSample},
+        {{"TTJets_HT", "1200to2500"}, 0.194972521, kSample},
+        {{"TTJets_HT", "800to1200"}, 1.07722318, kSample},
+        {{"TTJets_HT", "600to800"}, 2.61537118, kSample},
+        // The efficiency of the mtt>1000 cut is taken from sigma(mtt>1000)/sigma(inclusive) from mcm
+        {{"TTJets_Mtt-1000toInf"}, 815.96*(11.16/670.3), kSample},
+
+        {{"TTJets_DiLept"}, 85.66, kSample}, // (3*0.108)^2*815.96
+        {{"TTTo2L2Nu"}, 85.66, kSample},
+        {{"TTJets_SingleLept"}, 178.7, kSample}, //(1- ((1-3*0.108)^2+(3*0.108)^2))*815.96*0.5 per half
+        {{"TTToSemiLeptonic"}, 357.4, kSample},
+
+        {{"TTJets_DiLept_genMET-150"}, 0.06392*85.66, kFiltered}, // filter_eff*(3*0.108)^2*815.96
+        {{"TTJets_SingleLept", "genMET-150"}, 0.05217*178.7, kFiltered}, //filter_eff*(1- ((1-3*0.108)^2+(3*0.108)^2))*815.96*0.5 per half
+
+        // cross sections from mcm
+        {{"TTG"}, 3.697, kSample},
+        {{"TTTT_Tune"}, 0.009103, kSample},
+        // mcm cross section times the same kfactors used for leptonic samples
+        {{"WJetsToQQ_HT-600ToInf"}, 95.14*1.21, kSample},
+        {{"ZJetsToQQ_HT600toInf"}, 5.67*1.23, kSample},
+
+        // From https://cms-pdmv.cern.ch/mcm
+        // k-factors from https://mangano.web.cern.ch/mangano/public/MECCA/samples_50ns_miniaod.txt
+        // k-factors are ratio of https://twiki.cern.ch/twiki/bin/viewauth/CMS/StandardModelCrossSectionsat13TeV
+        // NLO/NNLO cross-sections to that of an inclusive sample in mcm at lower order (LO/NLO)
+
+        {{"WJetsToLNu_Tune"}, 61526.7, kInclusive}, //NNLO from Lesya's summary table; TTWJetsToLNu_Tune contains it
+
+        //cross-section per slice changed due to change in genHT definition
+        {{"WJetsToLNu_HT-70To100"}, 1372.*1.21, kSample},
+        {{"WJetsToLNu_HT-100To200"}, 1347.*1.21, kSample},
+        {{"WJetsToLNu_HT-200To400"}, 360.*1.21, kSample},
+        {{"WJetsToLNu_HT-400To600"}, 48.98*1.21, kSample},
+        {{"WJetsToLNu_HT-600ToInf"}, 18.77*1.21, kSample},
+        {{"WJetsToLNu_HT-600To800"}, 12.05*1.21, kSample},
+        {{"WJetsToLNu_HT-800To1200"}, 5.501*1.21, kSample},
+        {{"WJetsToLNu_HT-1200To2500"}, 1.329*1.21, kSample},
+        {{"WJetsToLNu_HT-2500ToInf"}, 0.03216*1.21, kSample},
+
+        {{"QCD_HT50to100_Tune"}, 1, kSample}, // not in MCM, need to derive
+        {{"QCD_HT100to200_Tune"}, 27540000, kSample},
+        {{"QCD_HT200to300_Tune"}, 1735000, kSample},
+        {{"QCD_HT300to500_Tune"}, 366800, kSample},
+        {{"QCD_HT500to700_Tune"}, 29370, kSample},
+        {{"QCD_HT700to1000_Tune"}, 6524, kSample},
+        {{"QCD_HT1000to1500_Tune"}, 1064, kSample},
+        {{"QCD_HT1500to2000_Tune"}, 121.5, kSample},
+        {{"QCD_HT2000toInf_Tune"}, 25.42, kSample},
+
+        // Cross sections from https://twiki.cern.ch/twiki/bin/view/LHCPhysics/SingleTopRefXsec
+        // multiplied by BF(W->mu,e,tau) = 0.324
+        {{"ST_s-channel_4f_leptonDecays"}, 3.34, kSample},
+        {{"ST_t-channel_antitop_4f_inclusiveDecays"}, 80.95, kSample},
+        {{"ST_t-channel_top_4f_inclusiveDecays"}, 136.02, kSample},
+        {{"ST_tW_antitop_5f_NoFullyHadronicDecays"}, 35.85*0.543, kSample},
+        {{"ST_tW_top_5f_NoFullyHadronicDecays"}, 35.85*0.543, kSample},
+
+        {{"DYJetsToLL_M-10to50_TuneCUETP8M1_13TeV"}, 18610*1.23, kSample},
+        {{"DYJetsToLL_M-50_TuneCUETP8M1_13TeV"}, 4895*1.23, kSample},
+
+        {{"DYJetsToLL_M-50_HT-70to100"}, 175.3*1.23, kSample},
+        {{"DYJetsToLL_M-50_HT-100to200"}, 139.4*1.23, kSample},
+        {{"DYJetsToLL_M-50_HT-200to400"}, 42.75*1.23, kSample},
+        {{"DYJetsToLL_M-50_HT-400to600"}, 5.497*1.23, kSample},
+        {{"DYJetsToLL_M-50_HT-600to800"}, 1.363*1.23, kSample},
+        {{"DYJetsToLL_M-50_HT-800to1200"}, 0.6759*1.23, kSample},
+        {{"DYJetsToLL_M-50_HT-1200to2500"}, 0.116*1.23, kSample},
+        {{"DYJetsToLL_M-50_HT-2500toInf"}, 0.002592*1.23, kSample},
+        {{"DYJetsToLL_M-50_HT-600toInf"}, 2.21*1.23, kSample},
+
+        {{"ZJetsToNuNu_HT-100To200"}, 280.35*1.27, kSample},
+        {{"ZJetsToNuNu_HT-200To400"}, 77.67*1.27, kSample},
+        {{"ZJetsToNuNu_HT-400To600"}, 10.73*1.27, kSample},
+        {{"ZJetsToNuNu_HT-600To800"}, 2.536*1.27, kSample},
+        {{"ZJetsToNuNu_HT-800To1200"}, 1.161*1.27, kSample},
+        {{"ZJetsToNuNu_HT-1200To2500"}, 0.2824*1.27, kSample},
+        {{"ZJetsToNuNu_HT-2500ToInf"}, 0.006459*1.27, kSample},
+        {{"ZJetsToNuNu_HT-600ToInf"}, 3.986*1.27, kSample},
+
+        {{"TTZToQQ"}, 0.5297, kSample},
+        {{"TTZToLLNuNu_M-10"}, 0.2529, kSample},
+        {{"TTWJetsToQQ"}, 0.4062, kSample},
+        {{"TTWJetsToLNu"}, 0.2043, kSample},
+
+        //https://twiki.cern.ch/twiki/bin/viewauth/CMS/SummaryTable1G25ns#Diboson
+        {{"WWTo2L2Nu"}, 12.178, kSample}, //NNLO
+        {{"WWToLNuQQ"}, 49.997, kSample}, //NNLO
+        {{"ttHTobb_M125"}, 0.2934, kSample},
+
+        {{"WZTo1L3Nu"}, 3.05, kSample},
+        {{"WZTo1L1Nu2Q"}, 10.96, kSample},
+        {{"WZTo2L2Q"}, 5.595, kSample},
+        {{"WZTo3LNu"}, 4.42965, kSample},
+        {{"VVTo2L2Nu"}, 11.95, kSample},
+        {{"ZZ_Tune"}, 16.523, kSample},
+
+        // Calculated at 13 TeV in
+        // https://twiki.cern.ch/twiki/bin/view/LHCPhysics/CERNYellowReportPageAt1314TeV
+        // Higgs branching ratios from
+        // https://twiki.cern.ch/twiki/bin/view/LHCPhysics/CERNYellowReportPageBR
+        {{"ZH_HToBB_ZToLL_M-125"}, 0.883*Htobb*0.033658, kSample},
+        {{"ZH_HToBB_ZToNuNu_M-125"}, 0.883*Htobb*0.2, kSample},
+        {{"WH_HToBB_WToLNu_M-125"}, 1.373*Htobb*(0.1071+0.1063+0.1138), kSample},
+        {{"ZH_HToBB_ZToNuNu_M125"}, 0.883*Htobb*0.2, kSample},
+        {{"WH_HToBB_WToLNu_M125"}, 1.373*Htobb*(0.1071+0.1063+0.1138), kSample}
+      });
+    return registry;
+  }
+
+  const SampleRegistry & NegWeightFractions(){
+    static const SampleRegistry registry("fraction of negative weights", {
+        // ttH, ttZ, ttW, ttGamma
+        {{"ttHJetTobb_M125_13TeV_amcatnloFXFX"}, 0.3515, kSample},
+        {{"TTZToQQ"}, 0.2657, kSample},
+        {{"TTZToLLNuNu_M-10"}, 0.2676, kSample},
+        {{"TTWJetsToQQ"}, 0.2412, kSample},
+        {{"TTWJetsToLNu"}, 0.2433, kSample},
+        {{"TTG"}, 0.342, kSample}, // from MCM
+
+        {{"TTTT_TuneCUETP8M1_13TeV-amcatnlo"}, 0.41, kSample}, // from MCM
+        {{"VVTo2L2Nu_13TeV_amcatnloFXFX"}, 0.20, kSample}, // from MCM
+        {{"TTJets_Mtt-1000toInf"}, 0.376996, kSample},
+
+        // Single top
+        {{"ST_s-channel_4f_leptonDecays_13TeV-amcatnlo-pythia8"}, 0.1884, kSample}
+      });
+    return registry;
+  }
+
+  const MassScan & GluinoScan(){
+    // No 595 GeV point: we shouldn't have these points
+    static const MassScan scan("gluino", {
+      {600, 9.20353, 0.137185},
+      {605, 8.74315, 0.137502},
+      {610, 8.30988, 0.136818},
+      {615, 7.9012, 0.137122},
+      {620, 7.51811, 0.136123},
+      {625, 7.15194, 0.136874},
+      {630, 6.80558, 0.136655},
+      {635, 6.47541, 0.136459},
+      {640, 6.17196, 0.136449},
+      {645, 5.87366, 0.136392},
+      {650, 5.60048, 0.136262},
+      {655, 5.33799, 0.137031},
+      {660, 5.09822, 0.137329},
+      {665, 4.86409, 0.137702},
+      {670, 4.64349, 0.138022},
+      {675, 4.43132, 0.138749},
+      {680, 4.23046, 0.139166},
+      {685, 4.03841, 0.139934},
+      {690, 3.85666, 0.139917},
+      {695, 3.68567, 0.140759},
+      {700, 3.5251, 0.141034},
+      {705, 3.3737, 0.141609},
+      {710, 3.22336, 0.141972},
+      {715, 3.0811, 0.142311},
+      {720, 2.9509, 0.142518},
+      {725, 2.81957, 0.143333},
+      {730, 2.7, 0.143772},
+      {735, 2.57737, 0.144452},
+      {740, 2.47729, 0.144485},
+      {745, 2.3661, 0.145381},
+      {750, 2.26585, 0.145653},
+      {755, 2.17436, 0.145861},
+      {760, 2.08446, 0.146279},
+      {765, 1.99341, 0.147278},
+      {770, 1.91352, 0.147424},
+      {775, 1.83188, 0.147835},
+      {780, 1.76145, 0.148078},
+      {785, 1.68078, 0.148956},
+      {790, 1.62071, 0.149017},
+      {795, 1.54896, 0.149976},
+      {800, 1.4891, 0.150167},
+      {805, 1.42888, 0.150599},
+      {810, 1.36759, 0.151122},
+      {815, 1.31749, 0.151184},
+      {820, 1.26659, 0.151928},
+      {825, 1.2167, 0.152141},
+      {830, 1.16617, 0.152437},
+      {835, 1.12555, 0.153009},
+      {840, 1.07523, 0.15367},
+      {845, 1.03426, 0.154018},
+      {850, 0.996137, 0.154252},
+      {855, 0.957975, 0.154597},
+      {860, 0.921447, 0.155362},
+      {865, 0.885917, 0.155643},
+      {870, 0.852433, 0.156368},
+      {875, 0.820259, 0.156742},
+      {880, 0.788789, 0.156746},
+      {885, 0.759346, 0.157507},
+      {890, 0.731213, 0.157879},
+      {895, 0.703532, 0.158276},
+      {900, 0.677478, 0.158762},
+      {905, 0.652317, 0.15914},
+      {910, 0.627695, 0.159569},
+      {915, 0.605596, 0.159838},
+      {920, 0.58302, 0.16029},
+      {925, 0.561889, 0.160626},
+      {930, 0.540533, 0.161499},
+      {935, 0.521159, 0.161607},
+      {940, 0.501865, 0.16245},
+      {945, 0.483546, 0.162492},
+      {950, 0.466352, 0.163378},
+      {955, 0.45012, 0.163303},
+      {960, 0.433842, 0.164161},
+      {965, 0.418744, 0.164473},
+      {970, 0.403514, 0.164538},
+      {975, 0.389266, 0.165308},
+      {980, 0.375053, 0.165398},
+      {985, 0.36182, 0.16619},
+      {990, 0.349764, 0.166462},
+      {995, 0.337454, 0.166888},
+      {1000, 0.325388, 0.16758},
+      {1005, 0.314329, 0.167865},
+      {1010, 0.30314, 0.168766},
+      {1015, 0.292987, 0.168793},
+      {1020, 0.282927, 0.169098},
+      {1025, 0.272778, 0.169917},
+      {1030, 0.263724, 0.170244},
+      {1035, 0.254721, 0.170758},
+      {1040, 0.245426, 0.171325},
+      {1045, 0.237403, 0.171542},
+      {1050, 0.229367, 0.171975},
+      {1055, 0.221273, 0.172482},
+      {1060, 0.214167, 0.173167},
+      {1065, 0.207025, 0.173211},
+      {1070, 0.199967, 0.173603},
+      {1075, 0.193881, 0.174329},
+      {1080, 0.186836, 0.174816},
+      {1085, 0.180783, 0.175245},
+      {1090, 0.174652, 0.175336},
+      {1095, 0.168526, 0.176231},
+      {1100, 0.163491, 0.176402},
+      {1105, 0.158451, 0.176564},
+      {1110, 0.153298, 0.177266},
+      {1115, 0.148246, 0.177755},
+      {1120, 0.143169, 0.17813},
+      {1125, 0.139009, 0.178569},
+      {1130, 0.133972, 0.179205},
+      {1135, 0.129938, 0.17938},
+      {1140, 0.125799, 0.179658},
+      {1145, 0.121755, 0.180222},
+      {1150, 0.117687, 0.180655},
+      {1155, 0.11358, 0.181327},
+      {1160, 0.110557, 0.181465},
+      {1165, 0.107532, 0.181655},
+      {1170, 0.10339, 0.182421},
+      {1175, 0.10036, 0.182686},
+      {1180, 0.0971485, 0.183142},
+      {1185, 0.0942072, 0.183623},
+      {1190, 0.0912756, 0.183957},
+      {1195, 0.0883712, 0.184467},
+      {1200, 0.0856418, 0.184814},
+      {1205, 0.0830236, 0.185276},
+      {1210, 0.0804313, 0.185714},
+      {1215, 0.0779039, 0.186096},
+      {1220, 0.0755801, 0.186429},
+      {1225, 0.0732255, 0.187227},
+      {1230, 0.0709683, 0.187266},
+      {1235, 0.0688462, 0.187544},
+      {1240, 0.0666928, 0.188404},
+      {1245, 0.0646423, 0.188414},
+      {1250, 0.0627027, 0.189328},
+      {1255, 0.0607803, 0.189693},
+      {1260, 0.0589319, 0.189695},
+      {1265, 0.0571859, 0.190561},
+      {1270, 0.0554225, 0.191806},
+      {1275, 0.0536906, 0.192452},
+      {1280, 0.052051, 0.192396},
+      {1285, 0.0504982, 0.193577},
+      {1290, 0.0489404, 0.194903},
+      {1295, 0.047474, 0.195871},
+      {1300, 0.0460525, 0.1964},
+      {1305, 0.0447038, 0.197627},
+      {1310, 0.0433373, 0.198601},
+      {1315, 0.0420362, 0.198634},
+      {1320, 0.0407723, 0.199586},
+      {1325, 0.0395728, 0.19951},
+      {1330, 0.0383587, 0.19993},
+      {1335, 0.0372043, 0.201012},
+      {1340, 0.0361694, 0.202191},
+      {1345, 0.0350586, 0.201714},
+      {1350, 0.0340187, 0.203088},
+      {1355, 0.0330251, 0.202807},
+      {1360, 0.0320787, 0.203682},
+      {1365, 0.0311325, 0.205466},
+      {1370, 0.0302294, 0.204724},
+      {1375, 0.0292919, 0.206217},
+      {1380, 0.0284627, 0.207773},
+      {1385, 0.0276679, 0.206729},
+      {1390, 0.0268339, 0.208251},
+      {1395, 0.0260313, 0.207488},
+      {1400, 0.0252977, 0.209163},
+      {1405, 0.0245679, 0.210704},
+      {1410, 0.0238741, 0.209586},
+      {1415, 0.0231433, 0.211204},
+      {1420, 0.0225194, 0.212481},
+      {1425, 0.0218959, 0.214183},
+      {1430, 0.0211928, 0.21365},
+      {1435, 0.0206244, 0.217574},
+      {1440, 0.0200458, 0.216629},
+      {1445, 0.0194648, 0.215531},
+      {1450, 0.0188887, 0.219548},
+      {1455, 0.018364, 0.221266},
+      {1460, 0.0178858, 0.220054},
+      {1465, 0.0173622, 0.221916},
+      {1470, 0.0168403, 0.223972},
+      {1475, 0.0163556, 0.222173},
+      {1480, 0.0159386, 0.223581},
+      {1485, 0.0154568, 0.222281},
+      {1490, 0.0150345, 0.224111},
+      {1495, 0.0146102, 0.225293},
+      {1500, 0.0141903, 0.227296},
+      {1505, 0.01377, 0.229402},
+      {1510, 0.0133923, 0.226528},
+      {1515, 0.0130286, 0.232697},
+      {1520, 0.012649, 0.230194},
+      {1525, 0.0123374, 0.231801},
+      {1530, 0.0119628, 0.229449},
+      {1535, 0.0116378, 0.231293},
+      {1540, 0.0113183, 0.233535},
+      {1545, 0.0110039, 0.23456},
+      {1550, 0.0107027, 0.234971},
+      {1555, 0.0103967, 0.23505},
+      {1560, 0.0101149, 0.236723},
+      {1565, 0.00984079, 0.237486},
+      {1570, 0.00956216, 0.238011},
+      {1575, 0.00930893, 0.238712},
+      {1580, 0.00905112, 0.239145},
+      {1585, 0.00880102, 0.24088},
+      {1590, 0.00856388, 0.241033},
+      {1595, 0.00832287, 0.242052},
+      {1600, 0.00810078, 0.242679},
+      {1605, 0.0078785, 0.243322},
+      {1610, 0.00767087, 0.244839},
+      {1615, 0.00745579, 0.245137},
+      {1620, 0.00725443, 0.24569},
+      {1625, 0.00705942, 0.246853},
+      {1630, 0.00687457, 0.24804},
+      {1635, 0.00668418, 0.248672},
+      {1640, 0.00651001, 0.249776},
+      {1645, 0.00633268, 0.250679},
+      {1650, 0.00616072, 0.25138},
+      {1655, 0.00599673, 0.252591},
+      {1660, 0.00583243, 0.253829},
+      {1665, 0.00567868, 0.255006},
+      {1670, 0.00553066, 0.255203},
+      {1675, 0.00538094, 0.255439},
+      {1680, 0.00523764, 0.256602},
+      {1685, 0.00509647, 0.258745},
+      {1690, 0.0049577, 0.258847},
+      {1695, 0.00483094, 0.260944},
+      {1700, 0.00470323, 0.261021},
+      {1705, 0.0045807, 0.262095},
+      {1710, 0.00445824, 0.263238},
+      {1715, 0.0043369, 0.263092},
+      {1720, 0.00422488, 0.264093},
+      {1725, 0.00411276, 0.26513},
+      {1730, 0.00400698, 0.267386},
+      {1735, 0.00389655, 0.267109},
+      {1740, 0.00379497, 0.268072},
+      {1745, 0.00370003, 0.2704},
+      {1750, 0.00359842, 0.271502},
+      {1755, 0.00350486, 0.27229},
+      {1760, 0.00341375, 0.273209},
+      {1765, 0.00332255, 0.27416},
+      {1770, 0.00323809, 0.276458},
+      {1775, 0.00314866, 0.275834},
+      {1780, 0.00306841, 0.276481},
+      {1785, 0.00298808, 0.277145},
+      {1790, 0.00291365, 0.279548},
+      {1795, 0.0028312, 0.280642},
+      {1800, 0.00276133, 0.28108},
+      {1805, 0.00269156, 0.281566},
+      {1810, 0.00262156, 0.282017},
+      {1815, 0.00254938, 0.282755},
+      {1820, 0.00248581, 0.285102},
+      {1825, 0.00241549, 0.285869},
+      {1830, 0.00235625, 0.286103},
+      {1835, 0.00229576, 0.28596},
+      {1840, 0.00223603, 0.286654},
+      {1845, 0.00218302, 0.288949},
+      {1850, 0.00212345, 0.289167},
+      {1855, 0.00207, 0.291835},
+      {1860, 0.00200972, 0.291901},
+      {1865, 0.00196025, 0.292103},
+      {1870, 0.00191132, 0.291893},
+      {1875, 0.00185789, 0.294928},
+      {1880, 0.00181527, 0.29723},
+      {1885, 0.00176658, 0.297236},
+      {1890, 0.00172274, 0.299813},
+      {1895, 0.00167806, 0.296455},
+      {1900, 0.00163547, 0.299045},
+      {1905, 0.0015925, 0.302039},
+      {1910, 0.00155445, 0.301015},
+      {1915, 0.00151503, 0.300356},
+      {1920, 0.00147199, 0.303575},
+      {1925, 0.0014401, 0.305951},
+      {1930, 0.0014016, 0.305171},
+      {1935, 0.00136297, 0.304873},
+      {1940, 0.001331, 0.307414},
+      {1945, 0.001299, 0.310066},
+      {1950, 0.0012642, 0.304581},
+      {1955, 0.00123087, 0.308644},
+      {1960, 0.00120048, 0.309669},
+      {1965, 0.00117053, 0.310216},
+      {1970, 0.00114051, 0.310814},
+      {1975, 0.00111722, 0.315357},
+      {1980, 0.00108758, 0.315568},
+      {1985, 0.00105813, 0.315103},
+      {1990, 0.00102936, 0.314167},
+      {1995, 0.00100614, 0.317628},
+      {2000, 0.000981077, 0.318422},
+      {2005, 0.000956613, 0.319751},
+      {2010, 0.000932325, 0.320882},
+      {2015, 0.000909408, 0.321466},
+      {2020, 0.000886417, 0.322175},
+      {2025, 0.000863806, 0.323142},
+      {2030, 0.00084231, 0.324635},
+      {2035, 0.000821016, 0.325832},
+      {2040, 0.00080083, 0.326879},
+      {2045, 0.000781098, 0.327197},
+      {2050, 0.000761286, 0.329341},
+      {2055, 0.000742602, 0.329529},
+      {2060, 0.000724162, 0.331309},
+      {2065, 0.000706078, 0.332221},
+      {2070, 0.000688773, 0.332606},
+      {2075, 0.000671106, 0.3347},
+      {2080, 0.000654555, 0.334624},
+      {2085, 0.000638154, 0.336239},
+      {2090, 0.000622299, 0.336944},
+      {2095, 0.000606772, 0.338846},
+      {2100, 0.000591918, 0.339326},
+      {2105, 0.000577016, 0.339891},
+      {2110, 0.000562775, 0.34126},
+      {2115, 0.000548803, 0.341942},
+      {2120, 0.000535625, 0.343143},
+      {2125, 0.000522481, 0.344322},
+      {2130, 0.000509317, 0.345795},
+      {2135, 0.000496197, 0.346013},
+      {2140, 0.000484078, 0.34712},
+      {2145, 0.000472404, 0.346967},
+      {2150, 0.000460941, 0.349082},
+      {2155, 0.00044976, 0.350413},
+      {2160, 0.000438717, 0.351403},
+      {2165, 0.000427663, 0.352429},
+      {2170, 0.000417087, 0.352067},
+      {2175, 0.000406541, 0.354714},
+      {2180, 0.000396549, 0.355491},
+      {2185, 0.000387227, 0.357425},
+      {2190, 0.000377685, 0.356672},
+      {2195, 0.00036824, 0.359098},
+      {2200, 0.000359318, 0.359623},
+      {2205, 0.000350402, 0.360185},
+      {2210, 0.000342071, 0.36245},
+      {2215, 0.000333108, 0.363203},
+      {2220, 0.000325306, 0.363282},
+      {2225, 0.000316997, 0.365413},
+      {2230, 0.000309731, 0.367432},
+      {2235, 0.000301864, 0.367687},
+      {2240, 0.000294675, 0.369412},
+      {2245, 0.000287398, 0.371824},
+      {2250, 0.00028065, 0.371485},
+      {2255, 0.000273425, 0.373577},
+      {2260, 0.000266633, 0.373399},
+      {2265, 0.000260448, 0.375246},
+      {2270, 0.000254453, 0.377047},
+      {2275, 0.000248358, 0.378684},
+      {2280, 0.00024216, 0.38071},
+      {2285, 0.000235996, 0.3826},
+      {2290, 0.000230291, 0.381896},
+      {2295, 0.000224084, 0.384083},
+      {2300, 0.000219049, 0.385249},
+      {2305, 0.000214032, 0.386523},
+      {2310, 0.000208248, 0.386168},
+      {2315, 0.000203199, 0.38742},
+      {2320, 0.00019809, 0.389115},
+      {2325, 0.000193715, 0.392614},
+      {2330, 0.000189162, 0.391278},
+      {2335, 0.000184075, 0.393222},
+      {2340, 0.000180106, 0.393788},
+      {2345, 0.000175678, 0.398124},
+      {2350, 0.000171031, 0.396435},
+      {2355, 0.000167051, 0.39707},
+      {2360, 0.000163052, 0.398228},
+      {2365, 0.000159079, 0.398948},
+      {2370, 0.000155058, 0.400085},
+      {2375, 0.000151091, 0.400903},
+      {2380, 0.000147865, 0.404762},
+      {2385, 0.000143836, 0.406052},
+      {2390, 0.00014101, 0.40553},
+      {2395, 0.000137035, 0.406244},
+      {2400, 0.000133965, 0.407945},
+      {2405, 0.000130879, 0.409847},
+      {2410, 0.000127783, 0.411703},
+      {2415, 0.0001241, 0.409566},
+      {2420, 0.000121089, 0.410638},
+      {2425, 0.000118777, 0.41508},
+      {2430, 0.000115804, 0.415799},
+      {2435, 0.00011285, 0.416479},
+      {2440, 0.000109965, 0.416973},
+      {2445, 0.000107077, 0.416702},
+      {2450, 0.000104886, 0.419997},
+      {2455, 0.000102035, 0.419184},
+      {2460, 9.97969e-05, 0.421891},
+      {2465, 9.73046e-05, 0.422923},
+      {2470, 9.50093e-05, 0.423683},
+      {2475, 9.26878e-05, 0.425345},
+      {2480, 9.04143e-05, 0.425981},
+      {2485, 8.82972e-05, 0.42816},
+      {2490, 8.61566e-05, 0.428228},
+      {2495, 8.40135e-05, 0.429963},
+      {2500, 8.20068e-05, 0.431071}
+      });
+    return scan;
+  }
+
+  const MassScan & StopScan(){
+    static const MassScan scan("stop", {
+      {100, 1521.11, 0.154038},
+      {105, 1233.18, 0.154059},
+      {110, 1013.76, 0.154088},
+      {115, 832.656, 0.151503},
+      {120, 689.799, 0.15044},
+      {125, 574.981, 0.149895},
+      {130, 481.397, 0.148906},
+      {135, 405.159, 0.148952},
+      {140, 342.865, 0.149119},
+      {145, 291.752, 0.148022},
+      {150, 249.409, 0.147477},
+      {155, 214.221, 0.145928},
+      {160, 184.623, 0.145821},
+      {165, 159.614, 0.147859},
+      {170, 139.252, 0.14547},
+      {175, 121.416, 0.146341},
+      {180, 106.194, 0.142033},
+      {185, 93.3347, 0.144893},
+      {190, 82.2541, 0.144677},
+      {195, 72.7397, 0.144452},
+      {200, 64.5085, 0.144098},
+      {205, 57.2279, 0.144191},
+      {210, 50.9226, 0.142457},
+      {215, 45.3761, 0.14344},
+      {220, 40.5941, 0.142634},
+      {225, 36.3818, 0.142189},
+      {230, 32.6679, 0.141592},
+      {235, 29.3155, 0.142233},
+      {240, 26.4761, 0.141723},
+      {245, 23.8853, 0.139482},
+      {250, 21.5949, 0.140595},
+      {255, 19.5614, 0.138755},
+      {260, 17.6836, 0.139505},
+      {265, 16.112, 0.139531},
+      {270, 14.6459, 0.139278},
+      {275, 13.3231, 0.142549},
+      {280, 12.1575, 0.141584},
+      {285, 11.0925, 0.140904},
+      {290, 10.1363, 0.138967},
+      {295, 9.29002, 0.139107},
+      {300, 8.51615, 0.139223},
+      {305, 7.81428, 0.138996},
+      {310, 7.17876, 0.139357},
+      {315, 6.60266, 0.139256},
+      {320, 6.08444, 0.137957},
+      {325, 5.60471, 0.138144},
+      {330, 5.17188, 0.136954},
+      {335, 4.77871, 0.137554},
+      {340, 4.41629, 0.137945},
+      {345, 4.08881, 0.137075},
+      {350, 3.78661, 0.136877},
+      {355, 3.50911, 0.138089},
+      {360, 3.25619, 0.138002},
+      {365, 3.02472, 0.137093},
+      {370, 2.8077, 0.138064},
+      {375, 2.61162, 0.138477},
+      {380, 2.43031, 0.136999},
+      {385, 2.26365, 0.13728},
+      {390, 2.10786, 0.13732},
+      {395, 1.9665, 0.134737},
+      {400, 1.83537, 0.136985},
+      {405, 1.70927, 0.137114},
+      {410, 1.60378, 0.135468},
+      {415, 1.49798, 0.134453},
+      {420, 1.39688, 0.136719},
+      {425, 1.31169, 0.135013},
+      {430, 1.22589, 0.133237},
+      {435, 1.14553, 0.135478},
+      {440, 1.07484, 0.137238},
+      {445, 1.01019, 0.134187},
+      {450, 0.948333, 0.134559},
+      {455, 0.890847, 0.134587},
+      {460, 0.836762, 0.134468},
+      {465, 0.787221, 0.134149},
+      {470, 0.740549, 0.134127},
+      {475, 0.697075, 0.133926},
+      {480, 0.655954, 0.134392},
+      {485, 0.618562, 0.133705},
+      {490, 0.582467, 0.133914},
+      {495, 0.549524, 0.133691},
+      {500, 0.51848, 0.133797},
+      {505, 0.489324, 0.133608},
+      {510, 0.462439, 0.133046},
+      {515, 0.436832, 0.133703},
+      {520, 0.412828, 0.13272},
+      {525, 0.390303, 0.133443},
+      {530, 0.368755, 0.133769},
+      {535, 0.348705, 0.132706},
+      {540, 0.330157, 0.132981},
+      {545, 0.312672, 0.13277},
+      {550, 0.296128, 0.132687},
+      {555, 0.280734, 0.132363},
+      {560, 0.266138, 0.13193},
+      {565, 0.251557, 0.131731},
+      {570, 0.238537, 0.133409},
+      {575, 0.226118, 0.132741},
+      {580, 0.214557, 0.131697},
+      {585, 0.203566, 0.133257},
+      {590, 0.193079, 0.132037},
+      {595, 0.183604, 0.130973},
+      {600, 0.174599, 0.132074},
+      {605, 0.166131, 0.130154},
+      {610, 0.158242, 0.13142},
+      {615, 0.150275, 0.13285},
+      {620, 0.142787, 0.130642},
+      {625, 0.136372, 0.127962},
+      {630, 0.129886, 0.132957},
+      {635, 0.123402, 0.13016},
+      {640, 0.11795, 0.127132},
+      {645, 0.112008, 0.12808},
+      {650, 0.107045, 0.129232},
+      {655, 0.102081, 0.130012},
+      {660, 0.09725, 0.129038},
+      {665, 0.0927515, 0.129548},
+      {670, 0.0885084, 0.130218},
+      {675, 0.0844877, 0.130703},
+      {680, 0.0806192, 0.131131},
+      {685, 0.0769099, 0.131517},
+      {690, 0.0734901, 0.132344},
+      {695, 0.0701805, 0.132716},
+      {700, 0.0670476, 0.133429},
+      {705, 0.0641426, 0.13363},
+      {710, 0.0612942, 0.133941},
+      {715, 0.0585678, 0.134663},
+      {720, 0.0560753, 0.134984},
+      {725, 0.0536438, 0.135804},
+      {730, 0.0513219, 0.135682},
+      {735, 0.0491001, 0.136268},
+      {740, 0.0470801, 0.136895},
+      {745, 0.045061, 0.136816},
+      {750, 0.0431418, 0.137455},
+      {755, 0.0413447, 0.137833},
+      {760, 0.0396264, 0.138518},
+      {765, 0.0379036, 0.138537},
+      {770, 0.0363856, 0.139334},
+      {775, 0.0348796, 0.139597},
+      {780, 0.0334669, 0.140267},
+      {785, 0.0320548, 0.140406},
+      {790, 0.0307373, 0.14115},
+      {795, 0.0295348, 0.141397},
+      {800, 0.0283338, 0.14171},
+      {805, 0.0272206, 0.14241},
+      {810, 0.0261233, 0.142891},
+      {815, 0.0251107, 0.143632},
+      {820, 0.0241099, 0.143805},
+      {825, 0.0230866, 0.144428},
+      {830, 0.0221834, 0.144791},
+      {835, 0.0213766, 0.145511},
+      {840, 0.0204715, 0.146131},
+      {845, 0.0197653, 0.146602},
+      {850, 0.0189612, 0.14702},
+      {855, 0.0182516, 0.147648},
+      {860, 0.0175509, 0.147944},
+      {865, 0.0168336, 0.148528},
+      {870, 0.0162314, 0.148772},
+      {875, 0.015625, 0.149567},
+      {880, 0.0150143, 0.150389},
+      {885, 0.0144112, 0.150614},
+      {890, 0.0138979, 0.151},
+      {895, 0.0133962, 0.151325},
+      {900, 0.0128895, 0.152026},
+      {905, 0.0123843, 0.152968},
+      {910, 0.0119837, 0.153089},
+      {915, 0.0114713, 0.153678},
+      {920, 0.0110688, 0.154082},
+      {925, 0.0106631, 0.154806},
+      {930, 0.0102629, 0.155313},
+      {935, 0.0098874, 0.156066},
+      {940, 0.00952142, 0.156055},
+      {945, 0.00916636, 0.156849},
+      {950, 0.00883465, 0.157177},
+      {955, 0.00851073, 0.158094},
+      {960, 0.00820884, 0.15844},
+      {965, 0.00791403, 0.159216},
+      {970, 0.00763112, 0.159742},
+      {975, 0.00735655, 0.160548},
+      {980, 0.00710317, 0.160626},
+      {985, 0.00684867, 0.16144},
+      {990, 0.00660695, 0.161813},
+      {995, 0.00637546, 0.162158},
+      {1000, 0.00615134, 0.162953},
+      {1005, 0.00593765, 0.163716},
+      {1010, 0.00572452, 0.163857},
+      {1015, 0.00553094, 0.164628},
+      {1020, 0.00533968, 0.164963},
+      {1025, 0.00514619, 0.165762},
+      {1030, 0.00497235, 0.165838},
+      {1035, 0.00479906, 0.166646},
+      {1040, 0.00463806, 0.166947},
+      {1045, 0.00447537, 0.167071},
+      {1050, 0.00432261, 0.167859},
+      {1055, 0.00417983, 0.168637},
+      {1060, 0.00403886, 0.168981},
+      {1065, 0.0038962, 0.169794},
+      {1070, 0.00376343, 0.169764},
+      {1075, 0.00364174, 0.170634},
+      {1080, 0.00352093, 0.170908},
+      {1085, 0.00339813, 0.171929},
+      {1090, 0.00328695, 0.172274},
+      {1095, 0.00317628, 0.172617},
+      {1100, 0.00307413, 0.173377},
+      {1105, 0.00297377, 0.173822},
+      {1110, 0.00287148, 0.174725},
+      {1115, 0.00278078, 0.175091},
+      {1120, 0.00268873, 0.175883},
+      {1125, 0.00260821, 0.176126},
+      {1130, 0.00251529, 0.176836},
+      {1135, 0.00243484, 0.177128},
+      {1140, 0.00236295, 0.177977},
+      {1145, 0.00228192, 0.178507},
+      {1150, 0.00221047, 0.179259},
+      {1155, 0.00213907, 0.180255},
+      {1160, 0.00206845, 0.180518},
+      {1165, 0.0020063, 0.180954},
+      {1170, 0.00194569, 0.181194},
+      {1175, 0.0018741, 0.182145},
+      {1180, 0.00182266, 0.183074},
+      {1185, 0.00176211, 0.183375},
+      {1190, 0.00170006, 0.184075},
+      {1195, 0.00164968, 0.184438},
+      {1200, 0.00159844, 0.185209},
+      {1205, 0.0015472, 0.185977},
+      {1210, 0.00149657, 0.186485},
+      {1215, 0.00145544, 0.187347},
+      {1220, 0.00140288, 0.188774},
+      {1225, 0.00136155, 0.18989},
+      {1230, 0.00131271, 0.188763},
+      {1235, 0.0012717, 0.189588},
+      {1240, 0.00123066, 0.19049},
+      {1245, 0.00119994, 0.191442},
+      {1250, 0.0011583, 0.193006},
+      {1255, 0.00112694, 0.194441},
+      {1260, 0.00108716, 0.194141},
+      {1265, 0.00105517, 0.196361},
+      {1270, 0.00102241, 0.196297},
+      {1275, 0.000991293, 0.19762},
+      {1280, 0.000961012, 0.197926},
+      {1285, 0.000932394, 0.198682},
+      {1290, 0.000903404, 0.199924},
+      {1295, 0.000876957, 0.200777},
+      {1300, 0.000850345, 0.201604},
+      {1305, 0.00082443, 0.202883},
+      {1310, 0.00079983, 0.20373},
+      {1315, 0.000775222, 0.204622},
+      {1320, 0.000751372, 0.205919},
+      {1325, 0.000728912, 0.206884},
+      {1330, 0.000706867, 0.207763},
+      {1335, 0.000685372, 0.208587},
+      {1340, 0.000664649, 0.209879},
+      {1345, 0.000644804, 0.211487},
+      {1350, 0.000625155, 0.212761},
+      {1355, 0.000606802, 0.213529},
+      {1360, 0.000588512, 0.214428},
+      {1365, 0.000570506, 0.216584},
+      {1370, 0.000553379, 0.216036},
+      {1375, 0.000536646, 0.21775},
+      {1380, 0.000521404, 0.218383},
+      {1385, 0.000505008, 0.219675},
+      {1390, 0.000490353, 0.221444},
+      {1395, 0.000476164, 0.222016},
+      {1400, 0.000461944, 0.222704},
+      {1405, 0.000448172, 0.224911},
+      {1410, 0.000435082, 0.225606},
+      {1415, 0.000422967, 0.226095},
+      {1420, 0.000410381, 0.22797},
+      {1425, 0.000398106, 0.228949},
+      {1430, 0.000386792, 0.231319},
+      {1435, 0.000375724, 0.231724},
+      {1440, 0.000364616, 0.232234},
+      {1445, 0.000353965, 0.234637},
+      {1450, 0.000343923, 0.234948},
+      {1455, 0.000333885, 0.235468},
+      {1460, 0.000324344, 0.23771},
+      {1465, 0.0003153, 0.238004},
+      {1470, 0.00030583, 0.240064},
+      {1475, 0.000296811, 0.240314},
+      {1480, 0.000288149, 0.239248},
+      {1485, 0.000279711, 0.241257},
+      {1490, 0.000271724, 0.241274},
+      {1495, 0.000264275, 0.243545},
+      {1500, 0.000256248, 0.24372},
+      {1505, 0.000248853, 0.245827},
+      {1510, 0.000241844, 0.246187},
+      {1515, 0.000234438, 0.248442},
+      {1520, 0.000227374, 0.248909},
+      {1525, 0.000221045, 0.250895},
+      {1530, 0.000214431, 0.248728},
+      {1535, 0.000208092, 0.251043},
+      {1540, 0.000201748, 0.253207},
+      {1545, 0.000196399, 0.255641},
+      {1550, 0.000190474, 0.255213},
+      {1555, 0.000185188, 0.257329},
+      {1560, 0.000179263, 0.256931},
+      {1565, 0.000174021, 0.259111},
+      {1570, 0.000169176, 0.258106},
+      {1575, 0.000163861, 0.260597},
+      {1580, 0.000159583, 0.262958},
+      {1585, 0.000154719, 0.26195},
+      {1590, 0.000150506, 0.264111},
+      {1595, 0.000145626, 0.263077},
+      {1600, 0.000141382, 0.265291},
+      {1605, 0.000137131, 0.267424},
+      {1610, 0.000132187, 0.26668},
+      {1615, 0.000127929, 0.269117},
+      {1620, 0.000124086, 0.267738},
+      {1625, 0.00011982, 0.270483},
+      {1630, 0.000116042, 0.268071},
+      {1635, 0.000112767, 0.27127},
+      {1640, 0.000108936, 0.269351},
+      {1645, 0.000105746, 0.271783},
+      {1650, 0.000102693, 0.27292},
+      {1655, 0.000100112, 0.274445},
+      {1660, 9.75763e-05, 0.275431},
+      {1665, 9.52062e-05, 0.276946},
+      {1670, 9.29857e-05, 0.277869},
+      {1675, 9.08285e-05, 0.279347},
+      {1680, 8.87433e-05, 0.281539},
+      {1685, 8.66618e-05, 0.283509},
+      {1690, 8.46535e-05, 0.284432},
+      {1695, 8.27102e-05, 0.28591},
+      {1700, 8.07774e-05, 0.287497},
+      {1705, 7.8666e-05, 0.288194},
+      {1710, 7.6572e-05, 0.290265},
+      {1715, 7.45994e-05, 0.291193},
+      {1720, 7.25199e-05, 0.293013},
+      {1725, 7.05189e-05, 0.293697},
+      {1730, 6.85712e-05, 0.294972},
+      {1735, 6.67296e-05, 0.296167},
+      {1740, 6.49184e-05, 0.297686},
+      {1745, 6.30949e-05, 0.298524},
+      {1750, 6.13637e-05, 0.299789},
+      {1755, 5.97301e-05, 0.300928},
+      {1760, 5.80751e-05, 0.302585},
+      {1765, 5.65479e-05, 0.30366},
+      {1770, 5.49998e-05, 0.305241},
+      {1775, 5.35686e-05, 0.306718},
+      {1780, 5.20828e-05, 0.306799},
+      {1785, 5.07079e-05, 0.309201},
+      {1790, 4.93948e-05, 0.310043},
+      {1795, 4.80635e-05, 0.31138},
+      {1800, 4.67492e-05, 0.312291},
+      {1805, 4.55055e-05, 0.314321},
+      {1810, 4.42835e-05, 0.315499},
+      {1815, 4.30744e-05, 0.316302},
+      {1820, 4.19954e-05, 0.317151},
+      {1825, 4.08527e-05, 0.319048},
+      {1830, 3.97561e-05, 0.319718},
+      {1835, 3.87041e-05, 0.322028},
+      {1840, 3.76008e-05, 0.32268},
+      {1845, 3.66914e-05, 0.324529},
+      {1850, 3.56995e-05, 0.325039},
+      {1855, 3.47689e-05, 0.326767},
+      {1860, 3.38528e-05, 0.328878},
+      {1865, 3.29644e-05, 0.328975},
+      {1870, 3.20679e-05, 0.329608},
+      {1875, 3.12583e-05, 0.331541},
+      {1880, 3.04342e-05, 0.333117},
+      {1885, 2.96516e-05, 0.332866},
+      {1890, 2.88952e-05, 0.336279},
+      {1895, 2.81145e-05, 0.336845},
+      {1900, 2.73974e-05, 0.338247},
+      {1905, 2.66796e-05, 0.339708},
+      {1910, 2.59941e-05, 0.339526},
+      {1915, 2.52784e-05, 0.341137},
+      {1920, 2.46598e-05, 0.342714},
+      {1925, 2.39932e-05, 0.342328},
+      {1930, 2.33737e-05, 0.34394},
+      {1935, 2.27623e-05, 0.345138},
+      {1940, 2.21454e-05, 0.346933},
+      {1945, 2.15924e-05, 0.350815},
+      {1950, 2.10232e-05, 0.349444},
+      {1955, 2.05211e-05, 0.350155},
+      {1960, 1.98996e-05, 0.352135},
+      {1965, 1.9408e-05, 0.353328},
+      {1970, 1.88974e-05, 0.354643},
+      {1975, 1.84612e-05, 0.357904},
+      {1980, 1.79562e-05, 0.358898},
+      {1985, 1.75673e-05, 0.35989},
+      {1990, 1.70612e-05, 0.360953},
+      {1995, 1.66228e-05, 0.364709},
+      {2000, 1.62355e-05, 0.365277}
+      });
+    return scan;
+  }
+
+  const MassScan & HiggsinoScan(){
+    static const MassScan scan("higgsino", {
+      {127, .5824*.5824*7602.2/1000, 0.0393921},
+      {150, .5824*.5824*3832.31/1000, 0.0413612},
+      {175, .5824*.5824*2267.94/1000, 0.044299},
+      {200, .5824*.5824*1335.62/1000, 0.0474362},
+      {225, .5824*.5824*860.597/1000, 0.0504217},
+      {250, .5824*.5824*577.314/1000, 0.0532731},
+      {275, .5824*.5824*400.107/1000, 0.0560232},
+      {300, .5824*.5824*284.855/1000, 0.0586867},
+      {325, .5824*.5824*207.36/1000, 0.0613554},
+      {350, .5824*.5824*153.841/1000, 0.0640598},
+      {375, .5824*.5824*116.006/1000, 0.066892},
+      {400, .5824*.5824*88.7325/1000, 0.0697517},
+      {425, .5824*.5824*68.6963/1000, 0.0723531},
+      {450, .5824*.5824*53.7702/1000, 0.0748325},
+      {475, .5824*.5824*42.4699/1000, 0.0775146},
+      {500, .5824*.5824*33.8387/1000, 0.0802572},
+      {525, .5824*.5824*27.1867/1000, 0.0825803},
+      {550, .5824*.5824*21.9868/1000, 0.0849278},
+      {575, .5824*.5824*17.9062/1000, 0.087561},
+      {600, .5824*.5824*14.6677/1000, 0.0900693},
+      {625, .5824*.5824*12.062/1000, 0.091959},
+      {650, .5824*.5824*9.96406/1000, 0.094065},
+      {675, .5824*.5824*8.28246/1000, 0.0957436},
+      {700, .5824*.5824*6.89981/1000, 0.0982894},
+      {725, .5824*.5824*5.78355/1000, 0.0999915},
+      {750, .5824*.5824*4.8731/1000, 0.101211},
+      {775, .5824*.5824*4.09781/1000, 0.104646},
+      {800, .5824*.5824*3.46143/1000, 0.107618},
+      {825, .5824*.5824*2.9337/1000, 0.108353},
+      {850, .5824*.5824*2.4923/1000, 0.110016},
+      {875, .5824*.5824*2.13679/1000, 0.112636},
+      {900, .5824*.5824*1.80616/1000, 0.1134},
+      {925, .5824*.5824*1.55453/1000, 0.116949},
+      {950, .5824*.5824*1.32692/1000, 0.117027},
+      {975, .5824*.5824*1.12975/1000, 0.121244},
+      {1000, .5824*.5824*0.968853/1000, 0.126209}
+      });
+    return scan;
+  }
+}
+
+namespace xsec{
+
+  float crossSection(const TString &file){
+    float xsec = CrossSections().Find(file.Data(), 999999.);
+
+    if(xsec<=0) std::cout<<"BABYMAKER: Cross section not found for "<<file<<std::endl;
+
+    return xsec;
+  }
+
+  vector<string> crossSectionMatches(const TString &file){
+    vector<string> matches;
+    for(const SampleRule *rule: CrossSections().Matches(file.Data())) matches.push_back(Describe(*rule));
+    return matches;
+  }
+
+  float fractionNegWeights(const TString &file){
+    return NegWeightFractions().Find(file.Data(), 0.);
+  }
 
-  void signalCrossSection(int glu_mass, double &xsec, double &xsec_unc){
-    if (glu_mass == 595) { xsec = 0.; xsec_unc = 0.; return; } // we shouldn't have these points
-    else if (glu_mass == 600) { xsec = 9.20353; xsec_unc = 0.137185; return; }
-    else if (glu_mass == 605) { xsec = 8.74315; xsec_unc = 0.137502; return; }
-    else if (glu_mass == 610) { xsec = 8.30988; xsec_unc = 0.136818; return; }
-    else if (glu_mass == 615) { xsec = 7.9012; xsec_unc = 0.137122; return; }
-    else if (glu_mass == 620) { xsec = 7.51811; xsec_unc = 0.136123; return; }
-    else if (glu_mass == 625) { xsec = 7.15194; xsec_unc = 0.136874; return; }
-    else if (glu_mass == 630) { xsec = 6.80558; xsec_unc = 0.136655; return; }
-    else if (glu_mass == 635) { xsec = 6.47541; xsec_unc = 0.136459; return; }
-    else if (glu_mass == 640) { xsec = 6.17196; xsec_unc = 0.136449; return; }
-    else if (glu_mass == 645) { xsec = 5.87366; xsec_unc = 0.136392; return; }
-    else if (glu_mass == 650) { xsec = 5.60048; xsec_unc = 0.136262; return; }
-    else if (glu_mass == 655) { xsec = 5.33799; xsec_unc = 0.137031; return; }
-    else if (glu_mass == 660) { xsec = 5.09822; xsec_unc = 0.137329; return; }
-    else if (glu_mass == 665) { xsec = 4.86409; xsec_unc = 0.137702; return; }
-    else if (glu_mass == 670) { xsec = 4.64349; xsec_unc = 0.138022; return; }
-    else if (glu_mass == 675) { xsec = 4.43132; xsec_unc = 0.138749; return; }
-    else if (glu_mass == 680) { xsec = 4.23046; xsec_unc = 0.139166; return; }
-    else if (glu_mass == 685) { xsec = 4.03841; xsec_unc = 0.139934; return; }
-    else if (glu_mass == 690) { xsec = 3.85666; xsec_unc = 0.139917; return; }
-    else if (glu_mass == 695) { xsec = 3.68567; xsec_unc = 0.140759; return; }
-    else if (glu_mass == 700) { xsec = 3.5251; xsec_unc = 0.141034; return; }
-    else if (glu_mass == 705) { xsec = 3.3737; xsec_unc = 0.141609; return; }
-    else if (glu_mass == 710) { xsec = 3.22336; xsec_unc = 0.141972; return; }
-    else if (glu_mass == 715) { xsec = 3.0811; xsec_unc = 0.142311; return; }
-    else if (glu_mass == 720) { xsec = 2.9509; xsec_unc = 0.142518; return; }
-    else if (glu_mass == 725) { xsec = 2.81957; xsec_unc = 0.143333; return; }
-    else if (glu_mass == 730) { xsec = 2.7; xsec_unc = 0.143772; return; }
-    else if (glu_mass == 735) { xsec = 2.57737; xsec_unc = 0.144452; return; }
-    else if (glu_mass == 740) { xsec = 2.47729; xsec_unc = 0.144485; return; }
-    else if (glu_mass == 745) { xsec = 2.3661; xsec_unc = 0.145381; return; }
-    else if (glu_mass == 750) { xsec = 2.26585; xsec_unc = 0.145653; return; }
-    else if (glu_mass == 755) { xsec = 2.17436; xsec_unc = 0.145861; return; }
-    else if (glu_mass == 760) { xsec = 2.08446; xsec_unc = 0.146279; return; }
-    else if (glu_mass == 765) { xsec = 1.99341; xsec_unc = 0.147278; return; }
-    else if (glu_mass == 770) { xsec = 1.91352; xsec_unc = 0.147424; return; }
-    else if (glu_mass == 775) { xsec = 1.83188; xsec_unc = 0.147835; return; }
-    else if (glu_mass == 780) { xsec = 1.76145; xsec_unc = 0.148078; return; }
-    else if (glu_mass == 785) { xsec = 1.68078; xsec_unc = 0.148956; return; }
-    else if (glu_mass == 790) { xsec = 1.62071; xsec_unc = 0.149017; return; }
-    else if (glu_mass == 795) { xsec = 1.54896; xsec_unc = 0.149976; return; }
-    else if (glu_mass == 800) { xsec = 1.4891; xsec_unc = 0.150167; return; }
-    else if (glu_mass == 805) { xsec = 1.42888; xsec_unc = 0.150599; return; }
-    else if (glu_mass == 810) { xsec = 1.36759; xsec_unc = 0.151122; return; }
-    else if (glu_mass == 815) { xsec = 1.31749; xsec_unc = 0.151184; return; }
-    else if (glu_mass == 820) { xsec = 1.26659; xsec_unc = 0.151928; return; }
-    else if (glu_mass == 825) { xsec = 1.2167; xsec_unc = 0.152141; return; }
-    else if (glu_mass == 830) { xsec = 1.16617; xsec_unc = 0.152437; return; }
-    else if (glu_mass == 835) { xsec = 1.12555; xsec_unc = 0.153009; return; }
-    else if (glu_mass == 840) { xsec = 1.07523; xsec_unc = 0.15367; return; }
-    else if (glu_mass == 845) { xsec = 1.03426; xsec_unc = 0.154018; return; }
-    else if (glu_mass == 850) { xsec = 0.996137; xsec_unc = 0.154252; return; }
-    else if (glu_mass == 855) { xsec = 0.957975; xsec_unc = 0.154597; return; }
-    else if (glu_mass == 860) { xsec = 0.921447; xsec_unc = 0.155362; return; }
-    else if (glu_mass == 865) { xsec = 0.885917; xsec_unc = 0.155643; return; }
-    else if (glu_mass == 870) { xsec = 0.852433; xsec_unc = 0.156368; return; }
-    else if (glu_mass == 875) { xsec = 0.820259; xsec_unc = 0.156742; return; }
-    else if (glu_mass == 880) { xsec = 0.788789; xsec_unc = 0.156746; return; }
-    else if (glu_mass == 885) { xsec = 0.759346; xsec_unc = 0.157507; return; }
-    else if (glu_mass == 890) { xsec = 0.731213; xsec_unc = 0.157879; return; }
-    else if (glu_mass == 895) { xsec = 0.703532; xsec_unc = 0.158276; return; }
-    else if (glu_mass == 900) { xsec = 0.677478; xsec_unc = 0.158762; return; }
-    else if (glu_mass == 905) { xsec = 0.652317; xsec_unc = 0.15914; return; }
-    else if (glu_mass == 910) { xsec = 0.627695; xsec_unc = 0.159569; return; }
-    else if (glu_mass == 915) { xsec = 0.605596; xsec_unc = 0.159838; return; }
-    else if (glu_mass == 920) { xsec = 0.58302; xsec_unc = 0.16029; return; }
-    else if (glu_mass == 925) { xsec = 0.561889; xsec_unc = 0.160626; return; }
-    else if (glu_mass == 930) { xsec = 0.540533; xsec_unc = 0.161499; return; }
-    else if (glu_mass == 935) { xsec = 0.521159; xsec_unc = 0.161607; return; }
-    else if (glu_mass == 940) { xsec = 0.501865; xsec_unc = 0.16245; return; }
-    else if (glu_mass == 945) { xsec = 0.483546; xsec_unc = 0.162492; return; }
-    else if (glu_mass == 950) { xsec = 0.466352; xsec_unc = 0.163378; return; }
-    else if (glu_mass == 955) { xsec = 0.45012; xsec_unc = 0.163303; return; }
-    else if (glu_mass == 960) { xsec = 0.433842; xsec_unc = 0.164161; return; }
-    else if (glu_mass == 965) { xsec = 0.418744; xsec_unc = 0.164473; return; }
-    else if (glu_mass == 970) { xsec = 0.403514; xsec_unc = 0.164538; return; }
-    else if (glu_mass == 975) { xsec = 0.389266; xsec_unc = 0.165308; return; }
-    else if (glu_mass == 980) { xsec = 0.375053; xsec_unc = 0.165398; return; }
-    else if (glu_mass == 985) { xsec = 0.36182; xsec_unc = 0.16619; return; }
-    else if (glu_mass == 990) { xsec = 0.349764; xsec_unc = 0.166462; return; }
-    else if (glu_mass == 995) { xsec = 0.337454; xsec_unc = 0.166888; return; }
-    else if (glu_mass == 1000) { xsec = 0.325388; xsec_unc = 0.16758; return; }
-    else if (glu_mass == 1005) { xsec = 0.314329; xsec_unc = 0.167865; return; }
-    else if (glu_mass == 1010) { xsec = 0.30314; xsec_unc = 0.168766; return; }
-    else if (glu_mass == 1015) { xsec = 0.292987; xsec_unc = 0.168793; return; }
-    else if (glu_mass == 1020) { xsec = 0.282927; xsec_unc = 0.169098; return; }
-    else if (glu_mass == 1025) { xsec = 0.272778; xsec_unc = 0.169917; return; }
-    else if (glu_mass == 1030) { xsec = 0.263724; xsec_unc = 0.170244; return; }
-    else if (glu_mass == 1035) { xsec = 0.254721; xsec_unc = 0.170758; return; }
-    else if (glu_mass == 1040) { xsec = 0.245426; xsec_unc = 0.171325; return; }
-    else if (glu_mass == 1045) { xsec = 0.237403; xsec_unc = 0.171542; return; }
-    else if (glu_mass == 1050) { xsec = 0.229367; xsec_unc = 0.171975; return; }
-    else if (glu_mass == 1055) { xsec = 0.221273; xsec_unc = 0.172482; return; }
-    else if (glu_mass == 1060) { xsec = 0.214167; xsec_unc = 0.173167; return; }
-    else if (glu_mass == 1065) { xsec = 0.207025; xsec_unc = 0.173211; return; }
-    else if (glu_mass == 1070) { xsec = 0.199967; xsec_unc = 0.173603; return; }
-    else if (glu_mass == 1075) { xsec = 0.193881; xsec_unc = 0.174329; return; }
-    else if (glu_mass == 1080) { xsec = 0.186836; xsec_unc = 0.174816; return; }
-    else if (glu_mass == 1085) { xsec = 0.180783; xsec_unc = 0.175245; return; }
-    else if (glu_mass == 1090) { xsec = 0.174652; xsec_unc = 0.175336; return; }
-    else if (glu_mass == 1095) { xsec = 0.168526; xsec_unc = 0.176231; return; }
-    else if (glu_mass == 1100) { xsec = 0.163491; xsec_unc = 0.176402; return; }
-    else if (glu_mass == 1105) { xsec = 0.158451; xsec_unc = 0.176564; return; }
-    else if (glu_mass == 1110) { xsec = 0.153298; xsec_unc = 0.177266; return; }
-    else if (glu_mass == 1115) { xsec = 0.148246; xsec_unc = 0.177755; return; }
-    else if (glu_mass == 1120) { xsec = 0.143169; xsec_unc = 0.17813; return; }
-    else if (glu_mass == 1125) { xsec = 0.139009; xsec_unc = 0.178569; return; }
-    else if (glu_mass == 1130) { xsec = 0.133972; xsec_unc = 0.179205; return; }
-    else if (glu_mass == 1135) { xsec = 0.129938; xsec_unc = 0.17938; return; }
-    else if (glu_mass == 1140) { xsec = 0.125799; xsec_unc = 0.179658; return; }
-    else if (glu_mass == 1145) { xsec = 0.121755; xsec_unc = 0.180222; return; }
-    else if (glu_mass == 1150) { xsec = 0.117687; xsec_unc = 0.180655; return; }
-    else if (glu_mass == 1155) { xsec = 0.11358; xsec_unc = 0.181327; return; }
-    else if (glu_mass == 1160) { xsec = 0.110557; xsec_unc = 0.181465; return; }
-    else if (glu_mass == 1165) { xsec = 0.107532; xsec_unc = 0.181655; return; }
-    else if (glu_mass == 1170) { xsec = 0.10339; xsec_unc = 0.182421; return; }
-    else if (glu_mass == 1175) { xsec = 0.10036; xsec_unc = 0.182686; return; }
-    else if (glu_mass == 1180) { xsec = 0.0971485; xsec_unc = 0.183142; return; }
-    else if (glu_mass == 1185) { xsec = 0.0942072; xsec_unc = 0.183623; return; }
-    else if (glu_mass == 1190) { xsec = 0.0912756; xsec_unc = 0.183957; return; }
-    else if (glu_mass == 1195) { xsec = 0.0883712; xsec_unc = 0.184467; return; }
-    else if (glu_mass == 1200) { xsec = 0.0856418; xsec_unc = 0.184814; return; }
-    else if (glu_mass == 1205) { xsec = 0.0830236; xsec_unc = 0.185276; return; }
-    else if (glu_mass == 1210) { xsec = 0.0804313; xsec_unc = 0.185714; return; }
-    else if (glu_mass == 1215) { xsec = 0.0779039; xsec_unc = 0.186096; return; }
-    else if (glu_mass == 1220) { xsec = 0.0755801; xsec_unc = 0.186429; return; }
-    else if (glu_mass == 1225) { xsec = 0.0732255; xsec_unc = 0.187227; return; }
-    else if (glu_mass == 1230) { xsec = 0.0709683; xsec_unc = 0.187266; return; }
-    else if (glu_mass == 1235) { xsec = 0.0688462; xsec_unc = 0.187544; return; }
-    else if (glu_mass == 1240) { xsec = 0.0666928; xsec_unc = 0.188404; return; }
-    else if (glu_mass == 1245) { xsec = 0.0646423; xsec_unc = 0.188414; return; }
-    else if (glu_mass == 1250) { xsec = 0.0627027; xsec_unc = 0.189328; return; }
-    else if (glu_mass == 1255) { xsec = 0.0607803; xsec_unc = 0.189693; return; }
-    else if (glu_mass == 1260) { xsec = 0.0589319; xsec_unc = 0.189695; return; }
-    else if (glu_mass == 1265) { xsec = 0.0571859; xsec_unc = 0.190561; return; }
-    else if (glu_mass == 1270) { xsec = 0.0554225; xsec_unc = 0.191806; return; }
-    else if (glu_mass == 1275) { xsec = 0.0536906; xsec_unc = 0.192452; return; }
-    else if (glu_mass == 1280) { xsec = 0.052051; xsec_unc = 0.192396; return; }
-    else if (glu_mass == 1285) { xsec = 0.0504982; xsec_unc = 0.193577; return; }
-    else if (glu_mass == 1290) { xsec = 0.0489404; xsec_unc = 0.194903; return; }
-    else if (glu_mass == 1295) { xsec = 0.047474; xsec_unc = 0.195871; return; }
-    else if (glu_mass == 1300) { xsec = 0.0460525; xsec_unc = 0.1964; return; }
-    else if (glu_mass == 1305) { xsec = 0.0447038; xsec_unc = 0.197627; return; }
-    else if (glu_mass == 1310) { xsec = 0.0433373; xsec_unc = 0.198601; return; }
-    else if (glu_mass == 1315) { xsec = 0.0420362; xsec_unc = 0.198634; return; }
-    else if (glu_mass == 1320) { xsec = 0.0407723; xsec_unc = 0.199586; return; }
-    else if (glu_mass == 1325) { xsec = 0.0395728; xsec_unc = 0.19951; return; }
-    else if (glu_mass == 1330) { xsec = 0.0383587; xsec_unc = 0.19993; return; }
-    else if (glu_mass == 1335) { xsec = 0.0372043; xsec_unc = 0.201012; return; }
-    else if (glu_mass == 1340) { xsec = 0.0361694; xsec_unc = 0.202191; return; }
-    else if (glu_mass == 1345) { xsec = 0.0350586; xsec_unc = 0.201714; return; }
-    else if (glu_mass == 1350) { xsec = 0.0340187; xsec_unc = 0.203088; return; }
-    else if (glu_mass == 1355) { xsec = 0.0330251; xsec_unc = 0.202807; return; }
-    else if (glu_mass == 1360) { xsec = 0.0320787; xsec_unc = 0.203682; return; }
-    else if (glu_mass == 1365) { xsec = 0.0311325; xsec_unc = 0.205466; return; }
-    else if (glu_mass == 1370) { xsec = 0.0302294; xsec_unc = 0.204724; return; }
-    else if (glu_mass == 1375) { xsec = 0.0292919; xsec_unc = 0.206217; return; }
-    else if (glu_mass == 1380) { xsec = 0.0284627; xsec_unc = 0.207773; return; }
-    else if (glu_mass == 1385) { xsec = 0.0276679; xsec_unc = 0.206729; return; }
-    else if (glu_mass == 1390) { xsec = 0.0268339; xsec_unc = 0.208251; return; }
-    else if (glu_mass == 1395) { xsec = 0.0260313; xsec_unc = 0.207488; return; }
-    else if (glu_mass == 1400) { xsec = 0.0252977; xsec_unc = 0.209163; return; }
-    else if (glu_mass == 1405) { xsec = 0.0245679; xsec_unc = 0.210704; return; }
-    else if (glu_mass == 1410) { xsec = 0.0238741; xsec_unc = 0.209586; return; }
-    else if (glu_mass == 1415) { xsec = 0.0231433; xsec_unc = 0.211204; return; }
-    else if (glu_mass == 1420) { xsec = 0.0225194; xsec_unc = 0.212481; return; }
-    else if (glu_mass == 1425) { xsec = 0.0218959; xsec_unc = 0.214183; return; }
-    else if (glu_mass == 1430) { xsec = 0.0211928; xsec_unc = 0.21365; return; }
-    else if (glu_mass == 1435) { xsec = 0.0206244; xsec_unc = 0.217574; return; }
-    else if (glu_mass == 1440) { xsec = 0.0200458; xsec_unc = 0.216629; return; }
-    else if (glu_mass == 1445) { xsec = 0.0194648; xsec_unc = 0.215531; return; }
-    else if (glu_mass == 1450) { xsec = 0.0188887; xsec_unc = 0.219548; return; }
-    else if (glu_mass == 1455) { xsec = 0.018364; xsec_unc = 0.221266; return; }
-    else if (glu_mass == 1460) { xsec = 0.0178858; xsec_unc = 0.220054; return; }
-    else if (glu_mass == 1465) { xsec = 0.0173622; xsec_unc = 0.221916; return; }
-    else if (glu_mass == 1470) { xsec = 0.0168403; xsec_unc = 0.223972; return; }
-    else if (glu_mass == 1475) { xsec = 0.0163556; xsec_unc = 0.222173; return; }
-    else if (glu_mass == 1480) { xsec = 0.0159386; xsec_unc = 0.223581; return; }
-    else if (glu_mass == 1485) { xsec = 0.0154568; xsec_unc = 0.222281; return; }
-    else if (glu_mass == 1490) { xsec = 0.0150345; xsec_unc = 0.224111; return; }
-    else if (glu_mass == 1495) { xsec = 0.0146102; xsec_unc = 0.225293; return; }
-    else if (glu_mass == 1500) { xsec = 0.0141903; xsec_unc = 0.227296; return; }
-    else if (glu_mass == 1505) { xsec = 0.01377; xsec_unc = 0.229402; return; }
-    else if (glu_mass == 1510) { xsec = 0.0133923; xsec_unc = 0.226528; return; }
-    else if (glu_mass == 1515) { xsec = 0.0130286; xsec_unc = 0.232697; return; }
-    else if (glu_mass == 1520) { xsec = 0.012649; xsec_unc = 0.230194; return; }
-    else if (glu_mass == 1525) { xsec = 0.0123374; xsec_unc = 0.231801; return; }
-    else if (glu_mass == 1530) { xsec = 0.0119628; xsec_unc = 0.229449; return; }
-    else if (glu_mass == 1535) { xsec = 0.0116378; xsec_unc = 0.231293; return; }
-    else if (glu_mass == 1540) { xsec = 0.0113183; xsec_unc = 0.233535; return; }
-    else if (glu_mass == 1545) { xsec = 0.0110039; xsec_unc = 0.23456; return; }
-    else if (glu_mass == 1550) { xsec = 0.0107027; xsec_unc = 0.234971; return; }
-    else if (glu_mass == 1555) { xsec = 0.0103967; xsec_unc = 0.23505; return; }
-    else if (glu_mass == 1560) { xsec = 0.0101149; xsec_unc = 0.236723; return; }
-    else if (glu_mass == 1565) { xsec = 0.00984079; xsec_unc = 0.237486; return; }
-    else if (glu_mass == 1570) { xsec = 0.00956216; xsec_unc = 0.238011; return; }
-    else if (glu_mass == 1575) { xsec = 0.00930893; xsec_unc = 0.238712; return; }
-    else if (glu_mass == 1580) { xsec = 0.00905112; xsec_unc = 0.239145; return; }
-    else if (glu_mass == 1585) { xsec = 0.00880102; xsec_unc = 0.24088; return; }
-    else if (glu_mass == 1590) { xsec = 0.00856388; xsec_unc = 0.241033; return; }
-    else if (glu_mass == 1595) { xsec = 0.00832287; xsec_unc = 0.242052; return; }
-    else if (glu_mass == 1600) { xsec = 0.00810078; xsec_unc = 0.242679; return; }
-    else if (glu_mass == 1605) { xsec = 0.0078785; xsec_unc = 0.243322; return; }
-    else if (glu_mass == 1610) { xsec = 0.00767087; xsec_unc = 0.244839; return; }
-    else if (glu_mass == 1615) { xsec = 0.00745579; xsec_unc = 0.245137; return; }
-    else if (glu_mass == 1620) { xsec = 0.00725443; xsec_unc = 0.24569; return; }
-    else if (glu_mass == 1625) { xsec = 0.00705942; xsec_unc = 0.246853; return; }
-    else if (glu_mass == 1630) { xsec = 0.00687457; xsec_unc = 0.24804; return; }
-    else if (glu_mass == 1635) { xsec = 0.00668418; xsec_unc = 0.248672; return; }
-    else if (glu_mass == 1640) { xsec = 0.00651001; xsec_unc = 0.249776; return; }
-    else if (glu_mass == 1645) { xsec = 0.00633268; xsec_unc = 0.250679; return; }
-    else if (glu_mass == 1650) { xsec = 0.00616072; xsec_unc = 0.25138; return; }
-    else if (glu_mass == 1655) { xsec = 0.00599673; xsec_unc = 0.252591; return; }
-    else if (glu_mass == 1660) { xsec = 0.00583243; xsec_unc = 0.253829; return; }
-    else if (glu_mass == 1665) { xsec = 0.00567868; xsec_unc = 0.255006; return; }
-    else if (glu_mass == 1670) { xsec = 0.00553066; xsec_unc = 0.255203; return; }
-    else if (glu_mass == 1675) { xsec = 0.00538094; xsec_unc = 0.255439; return; }
-    else if (glu_mass == 1680) { xsec = 0.00523764; xsec_unc = 0.256602; return; }
-    else if (glu_mass == 1685) { xsec = 0.00509647; xsec_unc = 0.258745; return; }
-    else if (glu_mass == 1690) { xsec = 0.0049577; xsec_unc = 0.258847; return; }
-    else if (glu_mass == 1695) { xsec = 0.00483094; xsec_unc = 0.260944; return; }
-    else if (glu_mass == 1700) { xsec = 0.00470323; xsec_unc = 0.261021; return; }
-    else if (glu_mass == 1705) { xsec = 0.0045807; xsec_unc = 0.262095; return; }
-    else if (glu_mass == 1710) { xsec = 0.00445824; xsec_unc = 0.263238; return; }
-    else if (glu_mass == 1715) { xsec = 0.0043369; xsec_unc = 0.263092; return; }
-    else if (glu_mass == 1720) { xsec = 0.00422488; xsec_unc = 0.264093; return; }
-    else if (glu_mass == 1725) { xsec = 0.00411276; xsec_unc = 0.26513; return; }
-    else if (glu_mass == 1730) { xsec = 0.00400698; xsec_unc = 0.267386; return; }
-    else if (glu_mass == 1735) { xsec = 0.00389655; xsec_unc = 0.267109; return; }
-    else if (glu_mass == 1740) { xsec = 0.00379497; xsec_unc = 0.268072; return; }
-    else if (glu_mass == 1745) { xsec = 0.00370003; xsec_unc = 0.2704; return; }
-    else if (glu_mass == 1750) { xsec = 0.00359842; xsec_unc = 0.271502; return; }
-    else if (glu_mass == 1755) { xsec = 0.00350486; xsec_unc = 0.27229; return; }
-    else if (glu_mass == 1760) { xsec = 0.00341375; xsec_unc = 0.273209; return; }
-    else if (glu_mass == 1765) { xsec = 0.00332255; xsec_unc = 0.27416; return; }
-    else if (glu_mass == 1770) { xsec = 0.00323809; xsec_unc = 0.276458; return; }
-    else if (glu_mass == 1775) { xsec = 0.00314866; xsec_unc = 0.275834; return; }
-    else if (glu_mass == 1780) { xsec = 0.00306841; xsec_unc = 0.276481; return; }
-    else if (glu_mass == 1785) { xsec = 0.00298808; xsec_unc = 0.277145; return; }
-    else if (glu_mass == 1790) { xsec = 0.00291365; xsec_unc = 0.279548; return; }
-    else if (glu_mass == 1795) { xsec = 0.0028312; xsec_unc = 0.280642; return; }
-    else if (glu_mass == 1800) { xsec = 0.00276133; xsec_unc = 0.28108; return; }
-    else if (glu_mass == 1805) { xsec = 0.00269156; xsec_unc = 0.281566; return; }
-    else if (glu_mass == 1810) { xsec = 0.00262156; xsec_unc = 0.282017; return; }
-    else if (glu_mass == 1815) { xsec = 0.00254938; xsec_unc = 0.282755; return; }
-    else if (glu_mass == 1820) { xsec = 0.00248581; xsec_unc = 0.285102; return; }
-    else if (glu_mass == 1825) { xsec = 0.00241549; xsec_unc = 0.285869; return; }
-    else if (glu_mass == 1830) { xsec = 0.00235625; xsec_unc = 0.286103; return; }
-    else if (glu_mass == 1835) { xsec = 0.00229576; xsec_unc = 0.28596; return; }
-    else if (glu_mass == 1840) { xsec = 0.00223603; xsec_unc = 0.286654; return; }
-    else if (glu_mass == 1845) { xsec = 0.00218302; xsec_unc = 0.288949; return; }
-    else if (glu_mass == 1850) { xsec = 0.00212345; xsec_unc = 0.289167; return; }
-    else if (glu_mass == 1855) { xsec = 0.00207; xsec_unc = 0.291835; return; }
-    else if (glu_mass == 1860) { xsec = 0.00200972; xsec_unc = 0.291901; return; }
-    else if (glu_mass == 1865) { xsec = 0.00196025; xsec_unc = 0.292103; return; }
-    else if (glu_mass == 1870) { xsec = 0.00191132; xsec_unc = 0.291893; return; }
-    else if (glu_mass == 1875) { xsec = 0.00185789; xsec_unc = 0.294928; return; }
-    else if (glu_mass == 1880) { xsec = 0.00181527; xsec_unc = 0.29723; return; }
-    else if (glu_mass == 1885) { xsec = 0.00176658; xsec_unc = 0.297236; return; }
-    else if (glu_mass == 1890) { xsec = 0.00172274; xsec_unc = 0.299813; return; }
-    else if (glu_mass == 1895) { xsec = 0.00167806; xsec_unc = 0.296455; return; }
-    else if (glu_mass == 1900) { xsec = 0.00163547; xsec_unc = 0.299045; return; }
-    else if (glu_mass == 1905) { xsec = 0.0015925; xsec_unc = 0.302039; return; }
-    else if (glu_mass == 1910) { xsec = 0.00155445; xsec_unc = 0.301015; return; }
-    else if (glu_mass == 1915) { xsec = 0.00151503; xsec_unc = 0.300356; return; }
-    else if (glu_mass == 1920) { xsec = 0.00147199; xsec_unc = 0.303575; return; }
-    else if (glu_mass == 1925) { xsec = 0.0014401; xsec_unc = 0.305951; return; }
-    else if (glu_mass == 1930) { xsec = 0.0014016; xsec_unc = 0.305171; return; }
-    else if (glu_mass == 1935) { xsec = 0.00136297; xsec_unc = 0.304873; return; }
-    else if (glu_mass == 1940) { xsec = 0.001331; xsec_unc = 0.307414; return; }
-    else if (glu_mass == 1945) { xsec = 0.001299; xsec_unc = 0.310066; return; }
-    else if (glu_mass == 1950) { xsec = 0.0012642; xsec_unc = 0.304581; return; }
-    else if (glu_mass == 1955) { xsec = 0.00123087; xsec_unc = 0.308644; return; }
-    else if (glu_mass == 1960) { xsec = 0.00120048; xsec_unc = 0.309669; return; }
-    else if (glu_mass == 1965) { xsec = 0.00117053; xsec_unc = 0.310216; return; }
-    else if (glu_mass == 1970) { xsec = 0.00114051; xsec_unc = 0.310814; return; }
-    else if (glu_mass == 1975) { xsec = 0.00111722; xsec_unc = 0.315357; return; }
-    else if (glu_mass == 1980) { xsec = 0.00108758; xsec_unc = 0.315568; return; }
-    else if (glu_mass == 1985) { xsec = 0.00105813; xsec_unc = 0.315103; return; }
-    else if (glu_mass == 1990) { xsec = 0.00102936; xsec_unc = 0.314167; return; }
-    else if (glu_mass == 1995) { xsec = 0.00100614; xsec_unc = 0.317628; return; }
-    else if (glu_mass == 2000) { xsec = 0.000981077; xsec_unc = 0.318422; return; }
-    else if (glu_mass == 2005) { xsec = 0.000956613; xsec_unc = 0.319751; return; }
-    else if (glu_mass == 2010) { xsec = 0.000932325; xsec_unc = 0.320882; return; }
-    else if (glu_mass == 2015) { xsec = 0.000909408; xsec_unc = 0.321466; return; }
-    else if (glu_mass == 2020) { xsec = 0.000886417; xsec_unc = 0.322175; return; }
-    else if (glu_mass == 2025) { xsec = 0.000863806; xsec_unc = 0.323142; return; }
-    else if (glu_mass == 2030) { xsec = 0.00084231;  xsec_unc = 0.324635; return; }
-    else if (glu_mass == 2035) { xsec = 0.000821016; xsec_unc = 0.325832; return; }
-    else if (glu_mass == 2040) { xsec = 0.00080083;  xsec_unc = 0.326879; return; }
-    else if (glu_mass == 2045) { xsec = 0.000781098; xsec_unc = 0.327197; return; }
-    else if (glu_mass == 2050) { xsec = 0.000761286; xsec_unc = 0.329341; return; }
-    else if (glu_mass == 2055) { xsec = 0.000742602; xsec_unc = 0.329529; return; }
-    else if (glu_mass == 2060) { xsec = 0.000724162; xsec_unc = 0.331309; return; }
-    else if (glu_mass == 2065) { xsec = 0.000706078; xsec_unc = 0.332221; return; }
-    else if (glu_mass == 2070) { xsec = 0.000688773; xsec_unc = 0.332606; return; }
-    else if (glu_mass == 2075) { xsec = 0.000671106; xsec_unc = 0.3347; return; }
-    else if (glu_mass == 2080) { xsec = 0.000654555; xsec_unc = 0.334624; return; }
-    else if (glu_mass == 2085) { xsec = 0.000638154; xsec_unc = 0.336239; return; }
-    else if (glu_mass == 2090) { xsec = 0.000622299; xsec_unc = 0.336944; return; }
-    else if (glu_mass == 2095) { xsec = 0.000606772; xsec_unc = 0.338846; return; }
-    else if (glu_mass == 2100) { xsec = 0.000591918; xsec_unc = 0.339326; return; }
-    else if (glu_mass == 2105) { xsec = 0.000577016; xsec_unc = 0.339891; return; }
-    else if (glu_mass == 2110) { xsec = 0.000562775; xsec_unc = 0.34126; return; }
-    else if (glu_mass == 2115) { xsec = 0.000548803; xsec_unc = 0.341942; return; }
-    else if (glu_mass == 2120) { xsec = 0.000535625; xsec_unc = 0.343143; return; }
-    else if (glu_mass == 2125) { xsec = 0.000522481; xsec_unc = 0.344322; return; }
-    else if (glu_mass == 2130) { xsec = 0.000509317; xsec_unc = 0.345795; return; }
-    else if (glu_mass == 2135) { xsec = 0.000496197; xsec_unc = 0.346013; return; }
-    else if (glu_mass == 2140) { xsec = 0.000484078; xsec_unc = 0.34712; return; }
-    else if (glu_mass == 2145) { xsec = 0.000472404; xsec_unc = 0.346967; return; }
-    else if (glu_mass == 2150) { xsec = 0.000460941; xsec_unc = 0.349082; return; }
-    else if (glu_mass == 2155) { xsec = 0.00044976;  xsec_unc = 0.350413; return; }
-    else if (glu_mass == 2160) { xsec = 0.000438717; xsec_unc = 0.351403; return; }
-    else if (glu_mass == 2165) { xsec = 0.000427663; xsec_unc = 0.352429; return; }
-    else if (glu_mass == 2170) { xsec = 0.000417087; xsec_unc = 0.352067; return; }
-    else if (glu_mass == 2175) { xsec = 0.000406541; xsec_unc = 0.354714; return; }
-    else if (glu_mass == 2180) { xsec = 0.000396549; xsec_unc = 0.355491; return; }
-    else if (glu_mass == 2185) { xsec = 0.000387227; xsec_unc = 0.357425; return; }
-    else if (glu_mass == 2190) { xsec = 0.000377685; xsec_unc = 0.356672; return; }
-    else if (glu_mass == 2195) { xsec = 0.00036824;  xsec_unc = 0.359098; return; }
-    else if (glu_mass == 2200) { xsec = 0.000359318; xsec_unc = 0.359623; return; }
-    else if (glu_mass == 2205) { xsec = 0.000350402; xsec_unc = 0.360185; return; }
-    else if (glu_mass == 2210) { xsec = 0.000342071; xsec_unc = 0.36245; return; }
-    else if (glu_mass == 2215) { xsec = 0.000333108; xsec_unc = 0.363203; return; }
-    else if (glu_mass == 2220) { xsec = 0.000325306; xsec_unc = 0.363282; return; }
-    else if (glu_mass == 2225) { xsec = 0.000316997; xsec_unc = 0.365413; return; }
-    else if (glu_mass == 2230) { xsec = 0.000309731; xsec_unc = 0.367432; return; }
-    else if (glu_mass == 2235) { xsec = 0.000301864; xsec_unc = 0.367687; return; }
-    else if (glu_mass == 2240) { xsec = 0.000294675; xsec_unc = 0.369412; return; }
-    else if (glu_mass == 2245) { xsec = 0.000287398; xsec_unc = 0.371824; return; }
-    else if (glu_mass == 2250) { xsec = 0.00028065;  xsec_unc = 0.371485; return; }
-    else if (glu_mass == 2255) { xsec = 0.000273425; xsec_unc = 0.373577; return; }
-    else if (glu_mass == 2260) { xsec = 0.000266633; xsec_unc = 0.373399; return; }
-    else if (glu_mass == 2265) { xsec = 0.000260448; xsec_unc = 0.375246; return; }
-    else if (glu_mass == 2270) { xsec = 0.000254453; xsec_unc = 0.377047; return; }
-    else if (glu_mass == 2275) { xsec = 0.000248358; xsec_unc = 0.378684; return; }
-    else if (glu_mass == 2280) { xsec = 0.00024216;  xsec_unc = 0.38071; return; }
-    else if (glu_mass == 2285) { xsec = 0.000235996; xsec_unc = 0.3826; return; }
-    else if (glu_mass == 2290) { xsec = 0.000230291; xsec_unc = 0.381896; return; }
-    else if (glu_mass == 2295) { xsec = 0.000224084; xsec_unc = 0.384083; return; }
-    else if (glu_mass == 2300) { xsec = 0.000219049; xsec_unc = 0.385249; return; }
-    else if (glu_mass == 2305) { xsec = 0.000214032; xsec_unc = 0.386523; return; }
-    else if (glu_mass == 2310) { xsec = 0.000208248; xsec_unc = 0.386168; return; }
-    else if (glu_mass == 2315) { xsec = 0.000203199; xsec_unc = 0.38742; return; }
-    else if (glu_mass == 2320) { xsec = 0.00019809;  xsec_unc = 0.389115; return; }
-    else if (glu_mass == 2325) { xsec = 0.000193715; xsec_unc = 0.392614; return; }
-    else if (glu_mass == 2330) { xsec = 0.000189162; xsec_unc = 0.391278; return; }
-    else if (glu_mass == 2335) { xsec = 0.000184075; xsec_unc = 0.393222; return; }
-    else if (glu_mass == 2340) { xsec = 0.000180106; xsec_unc = 0.393788; return; }
-    else if (glu_mass == 2345) { xsec = 0.000175678; xsec_unc = 0.398124; return; }
-    else if (glu_mass == 2350) { xsec = 0.000171031; xsec_unc = 0.396435; return; }
-    else if (glu_mass == 2355) { xsec = 0.000167051; xsec_unc = 0.39707; return; }
-    else if (glu_mass == 2360) { xsec = 0.000163052; xsec_unc = 0.398228; return; }
-    else if (glu_mass == 2365) { xsec = 0.000159079; xsec_unc = 0.398948; return; }
-    else if (glu_mass == 2370) { xsec = 0.000155058; xsec_unc = 0.400085; return; }
-    else if (glu_mass == 2375) { xsec = 0.000151091; xsec_unc = 0.400903; return; }
-    else if (glu_mass == 2380) { xsec = 0.000147865; xsec_unc = 0.404762; return; }
-    else if (glu_mass == 2385) { xsec = 0.000143836; xsec_unc = 0.406052; return; }
-    else if (glu_mass == 2390) { xsec = 0.00014101;  xsec_unc = 0.40553; return; }
-    else if (glu_mass == 2395) { xsec = 0.000137035; xsec_unc = 0.406244; return; }
-    else if (glu_mass == 2400) { xsec = 0.000133965; xsec_unc = 0.407945; return; }
-    else if (glu_mass == 2405) { xsec = 0.000130879; xsec_unc = 0.409847; return; }
-    else if (glu_mass == 2410) { xsec = 0.000127783; xsec_unc = 0.411703; return; }
-    else if (glu_mass == 2415) { xsec = 0.0001241;   xsec_unc = 0.409566; return; }
-    else if (glu_mass == 2420) { xsec = 0.000121089; xsec_unc = 0.410638; return; }
-    else if (glu_mass == 2425) { xsec = 0.000118777; xsec_unc = 0.41508; return; }
-    else if (glu_mass == 2430) { xsec = 0.000115804; xsec_unc = 0.415799; return; }
-    else if (glu_mass == 2435) { xsec = 0.00011285;  xsec_unc = 0.416479; return; }
-    else if (glu_mass == 2440) { xsec = 0.000109965; xsec_unc = 0.416973; return; }
-    else if (glu_mass == 2445) { xsec = 0.000107077; xsec_unc = 0.416702; return; }
-    else if (glu_mass == 2450) { xsec = 0.000104886; xsec_unc = 0.419997; return; }
-    else if (glu_mass == 2455) { xsec = 0.000102035; xsec_unc = 0.419184; return; }
-    else if (glu_mass == 2460) { xsec = 9.97969e-05; xsec_unc = 0.421891; return; }
-    else if (glu_mass == 2465) { xsec = 9.73046e-05; xsec_unc = 0.422923; return; }
-    else if (glu_mass == 2470) { xsec = 9.50093e-05; xsec_unc = 0.423683; return; }
-    else if (glu_mass == 2475) { xsec = 9.26878e-05; xsec_unc = 0.425345; return; }
-    else if (glu_mass == 2480) { xsec = 9.04143e-05; xsec_unc = 0.425981; return; }
-    else if (glu_mass == 2485) { xsec = 8.82972e-05; xsec_unc = 0.42816; return; }
-    else if (glu_mass == 2490) { xsec = 8.61566e-05; xsec_unc = 0.428228; return; }
-    else if (glu_mass == 2495) { xsec = 8.40135e-05; xsec_unc = 0.429963; return; }
-    else if (glu_mass == 2500) { xsec = 8.20068e-05; xsec_unc = 0.431071; return; }
-    else {xsec = 0.; xsec_unc = 0.;} 
+  void signalCrossSection(int glu_mass, double &xsec, double &xsec_unc, bool interpolate){
+    GluinoScan().Find(glu_mass, interpolate, xsec, xsec_unc);
   }
 
-  void higgsinoCrossSection(int hig_mass, double &xsec, double &xsec_unc) {
-        if(hig_mass == 127) { xsec = .5824*.5824*7602.2/1000; xsec_unc = 0.0393921; return;}
-        else if(hig_mass == 150) { xsec = .5824*.5824*3832.31/1000; xsec_unc = 0.0413612; return;}
-        else if(hig_mass == 175) { xsec = .5824*.5824*2267.94/1000; xsec_unc = 0.044299;  return;}
-        else if(hig_mass == 200) { xsec = .5824*.5824*1335.62/1000; xsec_unc = 0.0474362; return;}
-        else if(hig_mass == 225) { xsec = .5824*.5824*860.597/1000; xsec_unc = 0.0504217; return;}
-        else if(hig_mass == 250) { xsec = .5824*.5824*577.314/1000; xsec_unc = 0.0532731; return;}
-        else if(hig_mass == 275) { xsec = .5824*.5824*400.107/1000; xsec_unc = 0.0560232; return;}
-        else if(hig_mass == 300) { xsec = .5824*.5824*284.855/1000; xsec_unc = 0.0586867; return;}
-        else if(hig_mass == 325) { xsec = .5824*.5824* 207.36/1000; xsec_unc = 0.0613554; return;}
-        else if(hig_mass == 350) { xsec = .5824*.5824*153.841/1000; xsec_unc = 0.0640598; return;}
-        else if(hig_mass == 375) { xsec = .5824*.5824*116.006/1000; xsec_unc = 0.066892;  return;}
-        else if(hig_mass == 400) { xsec = .5824*.5824*88.7325/1000; xsec_unc = 0.0697517; return;}
-        else if(hig_mass == 425) { xsec = .5824*.5824*68.6963/1000; xsec_unc = 0.0723531; return;}
-        else if(hig_mass == 450) { xsec = .5824*.5824*53.7702/1000; xsec_unc = 0.0748325; return;}
-        else if(hig_mass == 475) { xsec = .5824*.5824*42.4699/1000; xsec_unc = 0.0775146; return;}
-        else if(hig_mass == 500) { xsec = .5824*.5824*33.8387/1000; xsec_unc = 0.0802572; return;}
-        else if(hig_mass == 525) { xsec = .5824*.5824*27.1867/1000; xsec_unc = 0.0825803; return;}
-        else if(hig_mass == 550) { xsec = .5824*.5824*21.9868/1000; xsec_unc = 0.0849278; return;}
-        else if(hig_mass == 575) { xsec = .5824*.5824*17.9062/1000; xsec_unc = 0.087561;  return;}
-        else if(hig_mass == 600) { xsec = .5824*.5824*14.6677/1000; xsec_unc = 0.0900693; return;}
-        else if(hig_mass == 625) { xsec = .5824*.5824* 12.062/1000; xsec_unc = 0.091959;  return;}
-        else if(hig_mass == 650) { xsec = .5824*.5824*9.96406/1000; xsec_unc = 0.094065;  return;}
-        else if(hig_mass == 675) { xsec = .5824*.5824*8.28246/1000; xsec_unc = 0.0957436; return;}
-        else if(hig_mass == 700) { xsec = .5824*.5824*6.89981/1000; xsec_unc = 0.0982894; return;}
-        else if(hig_mass == 725) { xsec = .5824*.5824*5.78355/1000; xsec_unc = 0.0999915; return;}
-        else if(hig_mass == 750) { xsec = .5824*.5824* 4.8731/1000; xsec_unc = 0.101211;  return;}
-        else if(hig_mass == 775) { xsec = .5824*.5824*4.09781/1000; xsec_unc = 0.104646;  return;}
-        else if(hig_mass == 800) { xsec = .5824*.5824*3.46143/1000; xsec_unc = 0.107618;  return;}
-        else if(hig_mass == 825) { xsec = .5824*.5824* 2.9337/1000; xsec_unc = 0.108353;  return;}
-        else if(hig_mass == 850) { xsec = .5824*.5824* 2.4923/1000; xsec_unc = 0.110016;  return;}
-        else if(hig_mass == 875) { xsec = .5824*.5824*2.13679/1000; xsec_unc = 0.112636;  return;}
-        else if(hig_mass == 900) { xsec = .5824*.5824*1.80616/1000; xsec_unc = 0.1134;    return;}
-        else if(hig_mass == 925) { xsec = .5824*.5824*1.55453/1000; xsec_unc = 0.116949;  return;}
-        else if(hig_mass == 950) { xsec = .5824*.5824*1.32692/1000; xsec_unc = 0.117027;  return;}
-        else if(hig_mass == 975) { xsec = .5824*.5824*1.12975/1000; xsec_unc = 0.121244;  return;}
-        else if(hig_mass ==1000) { xsec = .5824*.5824*0.968853/1000; xsec_unc = 0.126209; return;}
-        else{ xsec = 0; xsec_unc = 0;}
+  void stopCrossSection(int stop_mass, double &xsec, double &xsec_unc, bool interpolate){
+    StopScan().Find(stop_mass, interpolate, xsec, xsec_unc);
   }
 
-  void stopCrossSection(int stop_mass, double &xsec, double &xsec_unc){
-    
-    if(stop_mass == 100) { xsec = 1521.11; xsec_unc = 0.154038; return; }
-    else if(stop_mass == 105) { xsec = 1233.18; xsec_unc = 0.154059; return; }
-    else if(stop_mass == 110) { xsec = 1013.76; xsec_unc = 0.154088; return; }
-    else if(stop_mass == 115) { xsec = 832.656; xsec_unc = 0.151503; return; }
-    else if(stop_mass == 120) { xsec = 689.799; xsec_unc = 0.15044; return; }
-    else if(stop_mass == 125) { xsec = 574.981; xsec_unc = 0.149895; return; }
-    else if(stop_mass == 130) { xsec = 481.397; xsec_unc = 0.148906; return; }
-    else if(stop_mass == 135) { xsec = 405.159; xsec_unc = 0.148952; return; }
-    else if(stop_mass == 140) { xsec = 342.865; xsec_unc = 0.149119; return; }
-    else if(stop_mass == 145) { xsec = 291.752; xsec_unc = 0.148022; return; }
-    else if(stop_mass == 150) { xsec = 249.409; xsec_unc = 0.147477; return; }
-    else if(stop_mass == 155) { xsec = 214.221; xsec_unc = 0.145928; return; }
-    else if(stop_mass == 160) { xsec = 184.623; xsec_unc = 0.145821; return; }
-    else if(stop_mass == 165) { xsec = 159.614; xsec_unc = 0.147859; return; }
-    else if(stop_mass == 170) { xsec = 139.252; xsec_unc = 0.14547; return; }
-    else if(stop_mass == 175) { xsec = 121.416; xsec_unc = 0.146341; return; }
-    else if(stop_mass == 180) { xsec = 106.194; xsec_unc = 0.142033; return; }
-    else if(stop_mass == 185) { xsec = 93.3347; xsec_unc = 0.144893; return; }
-    else if(stop_mass == 190) { xsec = 82.2541; xsec_unc = 0.144677; return; }
-    else if(stop_mass == 195) { xsec = 72.7397; xsec_unc = 0.144452; return; }
-    else if(stop_mass == 200) { xsec = 64.5085; xsec_unc = 0.144098; return; }
-    else if(stop_mass == 205) { xsec = 57.2279; xsec_unc = 0.144191; return; }
-    else if(stop_mass == 210) { xsec = 50.9226; xsec_unc = 0.142457; return; }
-    else if(stop_mass == 215) { xsec = 45.3761; xsec_unc = 0.14344; return; }
-    else if(stop_mass == 220) { xsec = 40.5941; xsec_unc = 0.142634; return; }
-    else if(stop_mass == 225) { xsec = 36.3818; xsec_unc = 0.142189; return; }
-    else if(stop_mass == 230) { xsec = 32.6679; xsec_unc = 0.141592; return; }
-    else if(stop_mass == 235) { xsec = 29.3155; xsec_unc = 0.142233; return; }
-    else if(stop_mass == 240) { xsec = 26.4761; xsec_unc = 0.141723; return; }
-    else if(stop_mass == 245) { xsec = 23.8853; xsec_unc = 0.139482; return; }
-    else if(stop_mass == 250) { xsec = 21.5949; xsec_unc = 0.140595; return; }
-    else if(stop_mass == 255) { xsec = 19.5614; xsec_unc = 0.138755; return; }
-    else if(stop_mass == 260) { xsec = 17.6836; xsec_unc = 0.139505; return; }
-    else if(stop_mass == 265) { xsec = 16.112; xsec_unc = 0.139531; return; }
-    else if(stop_mass == 270) { xsec = 14.6459; xsec_unc = 0.139278; return; }
-    else if(stop_mass == 275) { xsec = 13.3231; xsec_unc = 0.142549; return; }
-    else if(stop_mass == 280) { xsec = 12.1575; xsec_unc = 0.141584; return; }
-    else if(stop_mass == 285) { xsec = 11.0925; xsec_unc = 0.140904; return; }
-    else if(stop_mass == 290) { xsec = 10.1363; xsec_unc = 0.138967; return; }
-    else if(stop_mass == 295) { xsec = 9.29002; xsec_unc = 0.139107; return; }
-    else if(stop_mass == 300) { xsec = 8.51615; xsec_unc = 0.139223; return; }
-    else if(stop_mass == 305) { xsec = 7.81428; xsec_unc = 0.138996; return; }
-    else if(stop_mass == 310) { xsec = 7.17876; xsec_unc = 0.139357; return; }
-    else if(stop_mass == 315) { xsec = 6.60266; xsec_unc = 0.139256; return; }
-    else if(stop_mass == 320) { xsec = 6.08444; xsec_unc = 0.137957; return; }
-    else if(stop_mass == 325) { xsec = 5.60471; xsec_unc = 0.138144; return; }
-    else if(stop_mass == 330) { xsec = 5.17188; xsec_unc = 0.136954; return; }
-    else if(stop_mass == 335) { xsec = 4.77871; xsec_unc = 0.137554; return; }
-    else if(stop_mass == 340) { xsec = 4.41629; xsec_unc = 0.137945; return; }
-    else if(stop_mass == 345) { xsec = 4.08881; xsec_unc = 0.137075; return; }
-    else if(stop_mass == 350) { xsec = 3.78661; xsec_unc = 0.136877; return; }
-    else if(stop_mass == 355) { xsec = 3.50911; xsec_unc = 0.138089; return; }
-    else if(stop_mass == 360) { xsec = 3.25619; xsec_unc = 0.138002; return; }
-    else if(stop_mass == 365) { xsec = 3.02472; xsec_unc = 0.137093; return; }
-    else if(stop_mass == 370) { xsec = 2.8077; xsec_unc = 0.138064; return; }
-    else if(stop_mass == 375) { xsec = 2.61162; xsec_unc = 0.138477; return; }
-    else if(stop_mass == 380) { xsec = 2.43031; xsec_unc = 0.136999; return; }
-    else if(stop_mass == 385) { xsec = 2.26365; xsec_unc = 0.13728; return; }
-    else if(stop_mass == 390) { xsec = 2.10786; xsec_unc = 0.13732; return; }
-    else if(stop_mass == 395) { xsec = 1.9665; xsec_unc = 0.134737; return; }
-    else if(stop_mass == 400) { xsec = 1.83537; xsec_unc = 0.136985; return; }
-    else if(stop_mass == 405) { xsec = 1.70927; xsec_unc = 0.137114; return; }
-    else if(stop_mass == 410) { xsec = 1.60378; xsec_unc = 0.135468; return; }
-    else if(stop_mass == 415) { xsec = 1.49798; xsec_unc = 0.134453; return; }
-    else if(stop_mass == 420) { xsec = 1.39688; xsec_unc = 0.136719; return; }
-    else if(stop_mass == 425) { xsec = 1.31169; xsec_unc = 0.135013; return; }
-    else if(stop_mass == 430) { xsec = 1.22589; xsec_unc = 0.133237; return; }
-    else if(stop_mass == 435) { xsec = 1.14553; xsec_unc = 0.135478; return; }
-    else if(stop_mass == 440) { xsec = 1.07484; xsec_unc = 0.137238; return; }
-    else if(stop_mass == 445) { xsec = 1.01019; xsec_unc = 0.134187; return; }
-    else if(stop_mass == 450) { xsec = 0.948333; xsec_unc = 0.134559; return; }
-    else if(stop_mass == 455) { xsec = 0.890847; xsec_unc = 0.134587; return; }
-    else if(stop_mass == 460) { xsec = 0.836762; xsec_unc = 0.134468; return; }
-    else if(stop_mass == 465) { xsec = 0.787221; xsec_unc = 0.134149; return; }
-    else if(stop_mass == 470) { xsec = 0.740549; xsec_unc = 0.134127; return; }
-    else if(stop_mass == 475) { xsec = 0.697075; xsec_unc = 0.133926; return; }
-    else if(stop_mass == 480) { xsec = 0.655954; xsec_unc = 0.134392; return; }
-    else if(stop_mass == 485) { xsec = 0.618562; xsec_unc = 0.133705; return; }
-    else if(stop_mass == 490) { xsec = 0.582467; xsec_unc = 0.133914; return; }
-    else if(stop_mass == 495) { xsec = 0.549524; xsec_unc = 0.133691; return; }
-    else if(stop_mass == 500) { xsec = 0.51848; xsec_unc = 0.133797; return; }
-    else if(stop_mass == 505) { xsec = 0.489324; xsec_unc = 0.133608; return; }
-    else if(stop_mass == 510) { xsec = 0.462439; xsec_unc = 0.133046; return; }
-    else if(stop_mass == 515) { xsec = 0.436832; xsec_unc = 0.133703; return; }
-    else if(stop_mass == 520) { xsec = 0.412828; xsec_unc = 0.13272; return; }
-    else if(stop_mass == 525) { xsec = 0.390303; xsec_unc = 0.133443; return; }
-    else if(stop_mass == 530) { xsec = 0.368755; xsec_unc = 0.133769; return; }
-    else if(stop_mass == 535) { xsec = 0.348705; xsec_unc = 0.132706; return; }
-    else if(stop_mass == 540) { xsec = 0.330157; xsec_unc = 0.132981; return; }
-    else if(stop_mass == 545) { xsec = 0.312672; xsec_unc = 0.13277; return; }
-    else if(stop_mass == 550) { xsec = 0.296128; xsec_unc = 0.132687; return; }
-    else if(stop_mass == 555) { xsec = 0.280734; xsec_unc = 0.132363; return; }
-    else if(stop_mass == 560) { xsec = 0.266138; xsec_unc = 0.13193; return; }
-    else if(stop_mass == 565) { xsec = 0.251557; xsec_unc = 0.131731; return; }
-    else if(stop_mass == 570) { xsec = 0.238537; xsec_unc = 0.133409; return; }
-    else if(stop_mass == 575) { xsec = 0.226118; xsec_unc = 0.132741; return; }
-    else if(stop_mass == 580) { xsec = 0.214557; xsec_unc = 0.131697; return; }
-    else if(stop_mass == 585) { xsec = 0.203566; xsec_unc = 0.133257; return; }
-    else if(stop_mass == 590) { xsec = 0.193079; xsec_unc = 0.132037; return; }
-    else if(stop_mass == 595) { xsec = 0.183604; xsec_unc = 0.130973; return; }
-    else if(stop_mass == 600) { xsec = 0.174599; xsec_unc = 0.132074; return; }
-    else if(stop_mass == 605) { xsec = 0.166131; xsec_unc = 0.130154; return; }
-    else if(stop_mass == 610) { xsec = 0.158242; xsec_unc = 0.13142; return; }
-    else if(stop_mass == 615) { xsec = 0.150275; xsec_unc = 0.13285; return; }
-    else if(stop_mass == 620) { xsec = 0.142787; xsec_unc = 0.130642; return; }
-    else if(stop_mass == 625) { xsec = 0.136372; xsec_unc = 0.127962; return; }
-    else if(stop_mass == 630) { xsec = 0.129886; xsec_unc = 0.132957; return; }
-    else if(stop_mass == 635) { xsec = 0.123402; xsec_unc = 0.13016; return; }
-    else if(stop_mass == 640) { xsec = 0.11795; xsec_unc = 0.127132; return; }
-    else if(stop_mass == 645) { xsec = 0.112008; xsec_unc = 0.12808; return; }
-    else if(stop_mass == 650) { xsec = 0.107045; xsec_unc = 0.129232; return; }
-    else if(stop_mass == 655) { xsec = 0.102081; xsec_unc = 0.130012; return; }
-    else if(stop_mass == 660) { xsec = 0.09725; xsec_unc = 0.129038; return; }
-    else if(stop_mass == 665) { xsec = 0.0927515; xsec_unc = 0.129548; return; }
-    else if(stop_mass == 670) { xsec = 0.0885084; xsec_unc = 0.130218; return; }
-    else if(stop_mass == 675) { xsec = 0.0844877; xsec_unc = 0.130703; return; }
-    else if(stop_mass == 680) { xsec = 0.0806192; xsec_unc = 0.131131; return; }
-    else if(stop_mass == 685) { xsec = 0.0769099; xsec_unc = 0.131517; return; }
-    else if(stop_mass == 690) { xsec = 0.0734901; xsec_unc = 0.132344; return; }
-    else if(stop_mass == 695) { xsec = 0.0701805; xsec_unc = 0.132716; return; }
-    else if(stop_mass == 700) { xsec = 0.0670476; xsec_unc = 0.133429; return; }
-    else if(stop_mass == 705) { xsec = 0.0641426; xsec_unc = 0.13363; return; }
-    else if(stop_mass == 710) { xsec = 0.0612942; xsec_unc = 0.133941; return; }
-    else if(stop_mass == 715) { xsec = 0.0585678; xsec_unc = 0.134663; return; }
-    else if(stop_mass == 720) { xsec = 0.0560753; xsec_unc = 0.134984; return; }
-    else if(stop_mass == 725) { xsec = 0.0536438; xsec_unc = 0.135804; return; }
-    else if(stop_mass == 730) { xsec = 0.0513219; xsec_unc = 0.135682; return; }
-    else if(stop_mass == 735) { xsec = 0.0491001; xsec_unc = 0.136268; return; }
-    else if(stop_mass == 740) { xsec = 0.0470801; xsec_unc = 0.136895; return; }
-    else if(stop_mass == 745) { xsec = 0.045061; xsec_unc = 0.136816; return; }
-    else if(stop_mass == 750) { xsec = 0.0431418; xsec_unc = 0.137455; return; }
-    else if(stop_mass == 755) { xsec = 0.0413447; xsec_unc = 0.137833; return; }
-    else if(stop_mass == 760) { xsec = 0.0396264; xsec_unc = 0.138518; return; }
-    else if(stop_mass == 765) { xsec = 0.0379036; xsec_unc = 0.138537; return; }
-    else if(stop_mass == 770) { xsec = 0.0363856; xsec_unc = 0.139334; return; }
-    else if(stop_mass == 775) { xsec = 0.0348796; xsec_unc = 0.139597; return; }
-    else if(stop_mass == 780) { xsec = 0.0334669; xsec_unc = 0.140267; return; }
-    else if(stop_mass == 785) { xsec = 0.0320548; xsec_unc = 0.140406; return; }
-    else if(stop_mass == 790) { xsec = 0.0307373; xsec_unc = 0.14115; return; }
-    else if(stop_mass == 795) { xsec = 0.0295348; xsec_unc = 0.141397; return; }
-    else if(stop_mass == 800) { xsec = 0.0283338; xsec_unc = 0.14171; return; }
-    else if(stop_mass == 805) { xsec = 0.0272206; xsec_unc = 0.14241; return; }
-    else if(stop_mass == 810) { xsec = 0.0261233; xsec_unc = 0.142891; return; }
-    else if(stop_mass == 815) { xsec = 0.0251107; xsec_unc = 0.143632; return; }
-    else if(stop_mass == 820) { xsec = 0.0241099; xsec_unc = 0.143805; return; }
-    else if(stop_mass == 825) { xsec = 0.0230866; xsec_unc = 0.144428; return; }
-    else if(stop_mass == 830) { xsec = 0.0221834; xsec_unc = 0.144791; return; }
-    else if(stop_mass == 835) { xsec = 0.0213766; xsec_unc = 0.145511; return; }
-    else if(stop_mass == 840) { xsec = 0.0204715; xsec_unc = 0.146131; return; }
-    else if(stop_mass == 845) { xsec = 0.0197653; xsec_unc = 0.146602; return; }
-    else if(stop_mass == 850) { xsec = 0.0189612; xsec_unc = 0.14702; return; }
-    else if(stop_mass == 855) { xsec = 0.0182516; xsec_unc = 0.147648; return; }
-    else if(stop_mass == 860) { xsec = 0.0175509; xsec_unc = 0.147944; return; }
-    else if(stop_mass == 865) { xsec = 0.0168336; xsec_unc = 0.148528; return; }
-    else if(stop_mass == 870) { xsec = 0.0162314; xsec_unc = 0.148772; return; }
-    else if(stop_mass == 875) { xsec = 0.015625; xsec_unc = 0.149567; return; }
-    else if(stop_mass == 880) { xsec = 0.0150143; xsec_unc = 0.150389; return; }
-    else if(stop_mass == 885) { xsec = 0.0144112; xsec_unc = 0.150614; return; }
-    else if(stop_mass == 890) { xsec = 0.0138979; xsec_unc = 0.151; return; }
-    else if(stop_mass == 895) { xsec = 0.0133962; xsec_unc = 0.151325; return; }
-    else if(stop_mass == 900) { xsec = 0.0128895; xsec_unc = 0.152026; return; }
-    else if(stop_mass == 905) { xsec = 0.0123843; xsec_unc = 0.152968; return; }
-    else if(stop_mass == 910) { xsec = 0.0119837; xsec_unc = 0.153089; return; }
-    else if(stop_mass == 915) { xsec = 0.0114713; xsec_unc = 0.153678; return; }
-    else if(stop_mass == 920) { xsec = 0.0110688; xsec_unc = 0.154082; return; }
-    else if(stop_mass == 925) { xsec = 0.0106631; xsec_unc = 0.154806; return; }
-    else if(stop_mass == 930) { xsec = 0.0102629; xsec_unc = 0.155313; return; }
-    else if(stop_mass == 935) { xsec = 0.0098874; xsec_unc = 0.156066; return; }
-    else if(stop_mass == 940) { xsec = 0.00952142; xsec_unc = 0.156055; return; }
-    else if(stop_mass == 945) { xsec = 0.00916636; xsec_unc = 0.156849; return; }
-    else if(stop_mass == 950) { xsec = 0.00883465; xsec_unc = 0.157177; return; }
-    else if(stop_mass == 955) { xsec = 0.00851073; xsec_unc = 0.158094; return; }
-    else if(stop_mass == 960) { xsec = 0.00820884; xsec_unc = 0.15844; return; }
-    else if(stop_mass == 965) { xsec = 0.00791403; xsec_unc = 0.159216; return; }
-    else if(stop_mass == 970) { xsec = 0.00763112; xsec_unc = 0.159742; return; }
-    else if(stop_mass == 975) { xsec = 0.00735655; xsec_unc = 0.160548; return; }
-    else if(stop_mass == 980) { xsec = 0.00710317; xsec_unc = 0.160626; return; }
-    else if(stop_mass == 985) { xsec = 0.00684867; xsec_unc = 0.16144; return; }
-    else if(stop_mass == 990) { xsec = 0.00660695; xsec_unc = 0.161813; return; }
-    else if(stop_mass == 995) { xsec = 0.00637546; xsec_unc = 0.162158; return; }
-    else if(stop_mass == 1000) { xsec = 0.00615134; xsec_unc = 0.162953; return; }
-    else if(stop_mass == 1005) { xsec = 0.00593765; xsec_unc = 0.163716; return; }
-    else if(stop_mass == 1010) { xsec = 0.00572452; xsec_unc = 0.163857; return; }
-    else if(stop_mass == 1015) { xsec = 0.00553094; xsec_unc = 0.164628; return; }
-    else if(stop_mass == 1020) { xsec = 0.00533968; xsec_unc = 0.164963; return; }
-    else if(stop_mass == 1025) { xsec = 0.00514619; xsec_unc = 0.165762; return; }
-    else if(stop_mass == 1030) { xsec = 0.00497235; xsec_unc = 0.165838; return; }
-    else if(stop_mass == 1035) { xsec = 0.00479906; xsec_unc = 0.166646; return; }
-    else if(stop_mass == 1040) { xsec = 0.00463806; xsec_unc = 0.166947; return; }
-    else if(stop_mass == 1045) { xsec = 0.00447537; xsec_unc = 0.167071; return; }
-    else if(stop_mass == 1050) { xsec = 0.00432261; xsec_unc = 0.167859; return; }
-    else if(stop_mass == 1055) { xsec = 0.00417983; xsec_unc = 0.168637; return; }
-    else if(stop_mass == 1060) { xsec = 0.00403886; xsec_unc = 0.168981; return; }
-    else if(stop_mass == 1065) { xsec = 0.0038962; xsec_unc = 0.169794; return; }
-    else if(stop_mass == 1070) { xsec = 0.00376343; xsec_unc = 0.169764; return; }
-    else if(stop_mass == 1075) { xsec = 0.00364174; xsec_unc = 0.170634; return; }
-    else if(stop_mass == 1080) { xsec = 0.00352093; xsec_unc = 0.170908; return; }
-    else if(stop_mass == 1085) { xsec = 0.00339813; xsec_unc = 0.171929; return; }
-    else if(stop_mass == 1090) { xsec = 0.00328695; xsec_unc = 0.172274; return; }
-    else if(stop_mass == 1095) { xsec = 0.00317628; xsec_unc = 0.172617; return; }
-    else if(stop_mass == 1100) { xsec = 0.00307413; xsec_unc = 0.173377; return; }
-    else if(stop_mass == 1105) { xsec = 0.00297377; xsec_unc = 0.173822; return; }
-    else if(stop_mass == 1110) { xsec = 0.00287148; xsec_unc = 0.174725; return; }
-    else if(stop_mass == 1115) { xsec = 0.00278078; xsec_unc = 0.175091; return; }
-    else if(stop_mass == 1120) { xsec = 0.00268873; xsec_unc = 0.175883; return; }
-    else if(stop_mass == 1125) { xsec = 0.00260821; xsec_unc = 0.176126; return; }
-    else if(stop_mass == 1130) { xsec = 0.00251529; xsec_unc = 0.176836; return; }
-    else if(stop_mass == 1135) { xsec = 0.00243484; xsec_unc = 0.177128; return; }
-    else if(stop_mass == 1140) { xsec = 0.00236295; xsec_unc = 0.177977; return; }
-    else if(stop_mass == 1145) { xsec = 0.00228192; xsec_unc = 0.178507; return; }
-    else if(stop_mass == 1150) { xsec = 0.00221047; xsec_unc = 0.179259; return; }
-    else if(stop_mass == 1155) { xsec = 0.00213907; xsec_unc = 0.180255; return; }
-    else if(stop_mass == 1160) { xsec = 0.00206845; xsec_unc = 0.180518; return; }
-    else if(stop_mass == 1165) { xsec = 0.0020063; xsec_unc = 0.180954; return; }
-    else if(stop_mass == 1170) { xsec = 0.00194569; xsec_unc = 0.181194; return; }
-    else if(stop_mass == 1175) { xsec = 0.0018741; xsec_unc = 0.182145; return; }
-    else if(stop_mass == 1180) { xsec = 0.00182266; xsec_unc = 0.183074; return; }
-    else if(stop_mass == 1185) { xsec = 0.00176211; xsec_unc = 0.183375; return; }
-    else if(stop_mass == 1190) { xsec = 0.00170006; xsec_unc = 0.184075; return; }
-    else if(stop_mass == 1195) { xsec = 0.00164968; xsec_unc = 0.184438; return; }
-    else if(stop_mass == 1200) { xsec = 0.00159844; xsec_unc = 0.185209; return; }
-    else if(stop_mass == 1205) { xsec = 0.0015472; xsec_unc = 0.185977; return; }
-    else if(stop_mass == 1210) { xsec = 0.00149657; xsec_unc = 0.186485; return; }
-    else if(stop_mass == 1215) { xsec = 0.00145544; xsec_unc = 0.187347; return; }
-    else if(stop_mass == 1220) { xsec = 0.00140288; xsec_unc = 0.188774; return; }
-    else if(stop_mass == 1225) { xsec = 0.00136155; xsec_unc = 0.18989; return; }
-    else if(stop_mass == 1230) { xsec = 0.00131271; xsec_unc = 0.188763; return; }
-    else if(stop_mass == 1235) { xsec = 0.0012717; xsec_unc = 0.189588; return; }
-    else if(stop_mass == 1240) { xsec = 0.00123066; xsec_unc = 0.19049; return; }
-    else if(stop_mass == 1245) { xsec = 0.00119994; xsec_unc = 0.191442; return; }
-    else if(stop_mass == 1250) { xsec = 0.0011583; xsec_unc = 0.193006; return; }
-    else if(stop_mass == 1255) { xsec = 0.00112694; xsec_unc = 0.194441; return; }
-    else if(stop_mass == 1260) { xsec = 0.00108716; xsec_unc = 0.194141; return; }
-    else if(stop_mass == 1265) { xsec = 0.00105517; xsec_unc = 0.196361; return; }
-    else if(stop_mass == 1270) { xsec = 0.00102241; xsec_unc = 0.196297; return; }
-    else if(stop_mass == 1275) { xsec = 0.000991293; xsec_unc = 0.19762; return; }
-    else if(stop_mass == 1280) { xsec = 0.000961012; xsec_unc = 0.197926; return; }
-    else if(stop_mass == 1285) { xsec = 0.000932394; xsec_unc = 0.198682; return; }
-    else if(stop_mass == 1290) { xsec = 0.000903404; xsec_unc = 0.199924; return; }
-    else if(stop_mass == 1295) { xsec = 0.000876957; xsec_unc = 0.200777; return; }
-    else if(stop_mass == 1300) { xsec = 0.000850345; xsec_unc = 0.201604; return; }
-    else if(stop_mass == 1305) { xsec = 0.00082443; xsec_unc = 0.202883; return; }
-    else if(stop_mass == 1310) { xsec = 0.00079983; xsec_unc = 0.20373; return; }
-    else if(stop_mass == 1315) { xsec = 0.000775222; xsec_unc = 0.204622; return; }
-    else if(stop_mass == 1320) { xsec = 0.000751372; xsec_unc = 0.205919; return; }
-    else if(stop_mass == 1325) { xsec = 0.000728912; xsec_unc = 0.206884; return; }
-    else if(stop_mass == 1330) { xsec = 0.000706867; xsec_unc = 0.207763; return; }
-    else if(stop_mass == 1335) { xsec = 0.000685372; xsec_unc = 0.208587; return; }
-    else if(stop_mass == 1340) { xsec = 0.000664649; xsec_unc = 0.209879; return; }
-    else if(stop_mass == 1345) { xsec = 0.000644804; xsec_unc = 0.211487; return; }
-    else if(stop_mass == 1350) { xsec = 0.000625155; xsec_unc = 0.212761; return; }
-    else if(stop_mass == 1355) { xsec = 0.000606802; xsec_unc = 0.213529; return; }
-    else if(stop_mass == 1360) { xsec = 0.000588512; xsec_unc = 0.214428; return; }
-    else if(stop_mass == 1365) { xsec = 0.000570506; xsec_unc = 0.216584; return; }
-    else if(stop_mass == 1370) { xsec = 0.000553379; xsec_unc = 0.216036; return; }
-    else if(stop_mass == 1375) { xsec = 0.000536646; xsec_unc = 0.21775; return; }
-    else if(stop_mass == 1380) { xsec = 0.000521404; xsec_unc = 0.218383; return; }
-    else if(stop_mass == 1385) { xsec = 0.000505008; xsec_unc = 0.219675; return; }
-    else if(stop_mass == 1390) { xsec = 0.000490353; xsec_unc = 0.221444; return; }
-    else if(stop_mass == 1395) { xsec = 0.000476164; xsec_unc = 0.222016; return; }
-    else if(stop_mass == 1400) { xsec = 0.000461944; xsec_unc = 0.222704; return; }
-    else if(stop_mass == 1405) { xsec = 0.000448172; xsec_unc = 0.224911; return; }
-    else if(stop_mass == 1410) { xsec = 0.000435082; xsec_unc = 0.225606; return; }
-    else if(stop_mass == 1415) { xsec = 0.000422967; xsec_unc = 0.226095; return; }
-    else if(stop_mass == 1420) { xsec = 0.000410381; xsec_unc = 0.22797; return; }
-    else if(stop_mass == 1425) { xsec = 0.000398106; xsec_unc = 0.228949; return; }
-    else if(stop_mass == 1430) { xsec = 0.000386792; xsec_unc = 0.231319; return; }
-    else if(stop_mass == 1435) { xsec = 0.000375724; xsec_unc = 0.231724; return; }
-    else if(stop_mass == 1440) { xsec = 0.000364616; xsec_unc = 0.232234; return; }
-    else if(stop_mass == 1445) { xsec = 0.000353965; xsec_unc = 0.234637; return; }
-    else if(stop_mass == 1450) { xsec = 0.000343923; xsec_unc = 0.234948; return; }
-    else if(stop_mass == 1455) { xsec = 0.000333885; xsec_unc = 0.235468; return; }
-    else if(stop_mass == 1460) { xsec = 0.000324344; xsec_unc = 0.23771; return; }
-    else if(stop_mass == 1465) { xsec = 0.0003153; xsec_unc = 0.238004; return; }
-    else if(stop_mass == 1470) { xsec = 0.00030583; xsec_unc = 0.240064; return; }
-    else if(stop_mass == 1475) { xsec = 0.000296811; xsec_unc = 0.240314; return; }
-    else if(stop_mass == 1480) { xsec = 0.000288149; xsec_unc = 0.239248; return; }
-    else if(stop_mass == 1485) { xsec = 0.000279711; xsec_unc = 0.241257; return; }
-    else if(stop_mass == 1490) { xsec = 0.000271724; xsec_unc = 0.241274; return; }
-    else if(stop_mass == 1495) { xsec = 0.000264275; xsec_unc = 0.243545; return; }
-    else if(stop_mass == 1500) { xsec = 0.000256248; xsec_unc = 0.24372; return; }
-    else if(stop_mass == 1505) { xsec = 0.000248853; xsec_unc = 0.245827; return; }
-    else if(stop_mass == 1510) { xsec = 0.000241844; xsec_unc = 0.246187; return; }
-    else if(stop_mass == 1515) { xsec = 0.000234438; xsec_unc = 0.248442; return; }
-    else if(stop_mass == 1520) { xsec = 0.000227374; xsec_unc = 0.248909; return; }
-    else if(stop_mass == 1525) { xsec = 0.000221045; xsec_unc = 0.250895; return; }
-    else if(stop_mass == 1530) { xsec = 0.000214431; xsec_unc = 0.248728; return; }
-    else if(stop_mass == 1535) { xsec = 0.000208092; xsec_unc = 0.251043; return; }
-    else if(stop_mass == 1540) { xsec = 0.000201748; xsec_unc = 0.253207; return; }
-    else if(stop_mass == 1545) { xsec = 0.000196399; xsec_unc = 0.255641; return; }
-    else if(stop_mass == 1550) { xsec = 0.000190474; xsec_unc = 0.255213; return; }
-    else if(stop_mass == 1555) { xsec = 0.000185188; xsec_unc = 0.257329; return; }
-    else if(stop_mass == 1560) { xsec = 0.000179263; xsec_unc = 0.256931; return; }
-    else if(stop_mass == 1565) { xsec = 0.000174021; xsec_unc = 0.259111; return; }
-    else if(stop_mass == 1570) { xsec = 0.000169176; xsec_unc = 0.258106; return; }
-    else if(stop_mass == 1575) { xsec = 0.000163861; xsec_unc = 0.260597; return; }
-    else if(stop_mass == 1580) { xsec = 0.000159583; xsec_unc = 0.262958; return; }
-    else if(stop_mass == 1585) { xsec = 0.000154719; xsec_unc = 0.26195; return; }
-    else if(stop_mass == 1590) { xsec = 0.000150506; xsec_unc = 0.264111; return; }
-    else if(stop_mass == 1595) { xsec = 0.000145626; xsec_unc = 0.263077; return; }
-    else if(stop_mass == 1600) { xsec = 0.000141382; xsec_unc = 0.265291; return; }
-    else if(stop_mass == 1605) { xsec = 0.000137131; xsec_unc = 0.267424; return; }
-    else if(stop_mass == 1610) { xsec = 0.000132187; xsec_unc = 0.26668; return; }
-    else if(stop_mass == 1615) { xsec = 0.000127929; xsec_unc = 0.269117; return; }
-    else if(stop_mass == 1620) { xsec = 0.000124086; xsec_unc = 0.267738; return; }
-    else if(stop_mass == 1625) { xsec = 0.00011982; xsec_unc = 0.270483; return; }
-    else if(stop_mass == 1630) { xsec = 0.000116042; xsec_unc = 0.268071; return; }
-    else if(stop_mass == 1635) { xsec = 0.000112767; xsec_unc = 0.27127; return; }
-    else if(stop_mass == 1640) { xsec = 0.000108936; xsec_unc = 0.269351; return; }
-    else if(stop_mass == 1645) { xsec = 0.000105746; xsec_unc = 0.271783; return; }
-    else if(stop_mass == 1650) { xsec = 0.000102693; xsec_unc = 0.27292; return; }
-    else if(stop_mass == 1655) { xsec = 0.000100112; xsec_unc = 0.274445; return; }
-    else if(stop_mass == 1660) { xsec = 9.75763e-05; xsec_unc = 0.275431; return; }
-    else if(stop_mass == 1665) { xsec = 9.52062e-05; xsec_unc = 0.276946; return; }
-    else if(stop_mass == 1670) { xsec = 9.29857e-05; xsec_unc = 0.277869; return; }
-    else if(stop_mass == 1675) { xsec = 9.08285e-05; xsec_unc = 0.279347; return; }
-    else if(stop_mass == 1680) { xsec = 8.87433e-05; xsec_unc = 0.281539; return; }
-    else if(stop_mass == 1685) { xsec = 8.66618e-05; xsec_unc = 0.283509; return; }
-    else if(stop_mass == 1690) { xsec = 8.46535e-05; xsec_unc = 0.284432; return; }
-    else if(stop_mass == 1695) { xsec = 8.27102e-05; xsec_unc = 0.28591; return; }
-    else if(stop_mass == 1700) { xsec = 8.07774e-05; xsec_unc = 0.287497; return; }
-    else if(stop_mass == 1705) { xsec = 7.8666e-05; xsec_unc = 0.288194; return; }
-    else if(stop_mass == 1710) { xsec = 7.6572e-05; xsec_unc = 0.290265; return; }
-    else if(stop_mass == 1715) { xsec = 7.45994e-05; xsec_unc = 0.291193; return; }
-    else if(stop_mass == 1720) { xsec = 7.25199e-05; xsec_unc = 0.293013; return; }
-    else if(stop_mass == 1725) { xsec = 7.05189e-05; xsec_unc = 0.293697; return; }
-    else if(stop_mass == 1730) { xsec = 6.85712e-05; xsec_unc = 0.294972; return; }
-    else if(stop_mass == 1735) { xsec = 6.67296e-05; xsec_unc = 0.296167; return; }
-    else if(stop_mass == 1740) { xsec = 6.49184e-05; xsec_unc = 0.297686; return; }
-    else if(stop_mass == 1745) { xsec = 6.30949e-05; xsec_unc = 0.298524; return; }
-    else if(stop_mass == 1750) { xsec = 6.13637e-05; xsec_unc = 0.299789; return; }
-    else if(stop_mass == 1755) { xsec = 5.97301e-05; xsec_unc = 0.300928; return; }
-    else if(stop_mass == 1760) { xsec = 5.80751e-05; xsec_unc = 0.302585; return; }
-    else if(stop_mass == 1765) { xsec = 5.65479e-05; xsec_unc = 0.30366; return; }
-    else if(stop_mass == 1770) { xsec = 5.49998e-05; xsec_unc = 0.305241; return; }
-    else if(stop_mass == 1775) { xsec = 5.35686e-05; xsec_unc = 0.306718; return; }
-    else if(stop_mass == 1780) { xsec = 5.20828e-05; xsec_unc = 0.306799; return; }
-    else if(stop_mass == 1785) { xsec = 5.07079e-05; xsec_unc = 0.309201; return; }
-    else if(stop_mass == 1790) { xsec = 4.93948e-05; xsec_unc = 0.310043; return; }
-    else if(stop_mass == 1795) { xsec = 4.80635e-05; xsec_unc = 0.31138; return; }
-    else if(stop_mass == 1800) { xsec = 4.67492e-05; xsec_unc = 0.312291; return; }
-    else if(stop_mass == 1805) { xsec = 4.55055e-05; xsec_unc = 0.314321; return; }
-    else if(stop_mass == 1810) { xsec = 4.42835e-05; xsec_unc = 0.315499; return; }
-    else if(stop_mass == 1815) { xsec = 4.30744e-05; xsec_unc = 0.316302; return; }
-    else if(stop_mass == 1820) { xsec = 4.19954e-05; xsec_unc = 0.317151; return; }
-    else if(stop_mass == 1825) { xsec = 4.08527e-05; xsec_unc = 0.319048; return; }
-    else if(stop_mass == 1830) { xsec = 3.97561e-05; xsec_unc = 0.319718; return; }
-    else if(stop_mass == 1835) { xsec = 3.87041e-05; xsec_unc = 0.322028; return; }
-    else if(stop_mass == 1840) { xsec = 3.76008e-05; xsec_unc = 0.32268; return; }
-    else if(stop_mass == 1845) { xsec = 3.66914e-05; xsec_unc = 0.324529; return; }
-    else if(stop_mass == 1850) { xsec = 3.56995e-05; xsec_unc = 0.325039; return; }
-    else if(stop_mass == 1855) { xsec = 3.47689e-05; xsec_unc = 0.326767; return; }
-    else if(stop_mass == 1860) { xsec = 3.38528e-05; xsec_unc = 0.328878; return; }
-    else if(stop_mass == 1865) { xsec = 3.29644e-05; xsec_unc = 0.328975; return; }
-    else if(stop_mass == 1870) { xsec = 3.20679e-05; xsec_unc = 0.329608; return; }
-    else if(stop_mass == 1875) { xsec = 3.12583e-05; xsec_unc = 0.331541; return; }
-    else if(stop_mass == 1880) { xsec = 3.04342e-05; xsec_unc = 0.333117; return; }
-    else if(stop_mass == 1885) { xsec = 2.96516e-05; xsec_unc = 0.332866; return; }
-    else if(stop_mass == 1890) { xsec = 2.88952e-05; xsec_unc = 0.336279; return; }
-    else if(stop_mass == 1895) { xsec = 2.81145e-05; xsec_unc = 0.336845; return; }
-    else if(stop_mass == 1900) { xsec = 2.73974e-05; xsec_unc = 0.338247; return; }
-    else if(stop_mass == 1905) { xsec = 2.66796e-05; xsec_unc = 0.339708; return; }
-    else if(stop_mass == 1910) { xsec = 2.59941e-05; xsec_unc = 0.339526; return; }
-    else if(stop_mass == 1915) { xsec = 2.52784e-05; xsec_unc = 0.341137; return; }
-    else if(stop_mass == 1920) { xsec = 2.46598e-05; xsec_unc = 0.342714; return; }
-    else if(stop_mass == 1925) { xsec = 2.39932e-05; xsec_unc = 0.342328; return; }
-    else if(stop_mass == 1930) { xsec = 2.33737e-05; xsec_unc = 0.34394; return; }
-    else if(stop_mass == 1935) { xsec = 2.27623e-05; xsec_unc = 0.345138; return; }
-    else if(stop_mass == 1940) { xsec = 2.21454e-05; xsec_unc = 0.346933; return; }
-    else if(stop_mass == 1945) { xsec = 2.15924e-05; xsec_unc = 0.350815; return; }
-    else if(stop_mass == 1950) { xsec = 2.10232e-05; xsec_unc = 0.349444; return; }
-    else if(stop_mass == 1955) { xsec = 2.05211e-05; xsec_unc = 0.350155; return; }
-    else if(stop_mass == 1960) { xsec = 1.98996e-05; xsec_unc = 0.352135; return; }
-    else if(stop_mass == 1965) { xsec = 1.9408e-05; xsec_unc = 0.353328; return; }
-    else if(stop_mass == 1970) { xsec = 1.88974e-05; xsec_unc = 0.354643; return; }
-    else if(stop_mass == 1975) { xsec = 1.84612e-05; xsec_unc = 0.357904; return; }
-    else if(stop_mass == 1980) { xsec = 1.79562e-05; xsec_unc = 0.358898; return; }
-    else if(stop_mass == 1985) { xsec = 1.75673e-05; xsec_unc = 0.35989; return; }
-    else if(stop_mass == 1990) { xsec = 1.70612e-05; xsec_unc = 0.360953; return; }
-    else if(stop_mass == 1995) { xsec = 1.66228e-05; xsec_unc = 0.364709; return; }
-    else if(stop_mass == 2000) { xsec = 1.62355e-05; xsec_unc = 0.365277; return; }
-    else { xsec = 0.; xsec_unc = 0.; }
+  void higgsinoCrossSection(int hig_mass, double &xsec, double &xsec_unc, bool interpolate){
+    HiggsinoScan().Find(hig_mass, interpolate, xsec, xsec_unc);
   }
 }
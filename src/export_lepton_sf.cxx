@@ -0,0 +1,66 @@
+// export_lepton_sf: writes the lepton SF tables of an SF set as a correction
+// set file, one correction per table named as in the SF set files, so
+// "table file.json table" lines select them back in LeptonWeighter
+
+#include <iostream>
+#include <string>
+
+#include <getopt.h>
+
+#include "TError.h"
+
+#include "correction_set.hpp"
+#include "lepton_weighter.hpp"
+#include "utilities.hpp"
+
+using namespace std;
+
+namespace {
+  string sf_set_file = "";
+  string out_file = "data/lepton_sf.json";
+}
+
+void GetOptions(int argc, char *argv[]);
+
+int main(int argc, char *argv[]){
+  gErrorIgnoreLevel = 6000;
+  GetOptions(argc, argv);
+
+  LeptonWeighter::SFSet sf_set = sf_set_file == "" ? LeptonWeighter::DefaultSFSet() : LeptonWeighter::ReadSFSet(sf_set_file);
+  CorrectionSet corrections;
+  for(const auto &table: LeptonWeighter::SFSetTables()){
+    const LeptonWeighter::Source &source = sf_set.*(table.second);
+    corrections.Add(table.first, LeptonWeighter::LoadGrid(source).GetCorrection());
+    cout << "Exported " << table.first << " from " << source.item_name << " in " << source.file_name << endl;
+  }
+
+  corrections.Write(out_file);
+  cout << "Wrote " << out_file << endl;
+}
+
+void GetOptions(int argc, char *argv[]){
+  while(true){
+    static struct option long_options[] = {
+      {"sf_set", required_argument, 0, 's'},   // SF set file as given to --lep_sf_set; default SFs if not given
+      {"out_file", required_argument, 0, 'o'}, // Correction set to write
+      {0, 0, 0, 0}
+    };
+
+    char opt = -1;
+    int option_index;
+    opt = getopt_long(argc, argv, "s:o:", long_options, &option_index);
+    if(opt == -1) break;
+
+    switch(opt){
+    case 's':
+      sf_set_file = optarg;
+      break;
+    case 'o':
+      out_file = optarg;
+      break;
+    default:
+      printf("Bad option! getopt_long returned character code 0%o\n", opt);
+      break;
+    }
+  }
+}
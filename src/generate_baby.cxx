@@ -117,6 +117,8 @@ int main(){
 
   WritePlusHeader(full_vars, new_full_vars);
   WritePlusSource(full_vars, new_full_vars);
+  WritePlusBlockHeader(full_vars);
+  WritePlusBlockSource(full_vars);
   WriteCorrHeader(corr_vars, new_corr_vars);
   WriteCorrSource(corr_vars, new_corr_vars);
 
@@ -126,6 +128,17 @@ bool Contains(const string &text, const string &pattern){
   return text.find(pattern) != string::npos;
 }
 
+string ElementType(const string &type){
+  //Type of the elements in a vector branch, or the type itself for scalars
+  size_t begin = type.find('<');
+  size_t end = type.rfind('>');
+  if(begin == string::npos || end == string::npos || end < begin) return type;
+  string elem = type.substr(begin+1, end-begin-1);
+  size_t first = elem.find_first_not_of(' ');
+  size_t last = elem.find_last_not_of(' ');
+  return elem.substr(first, last-first+1);
+}
+
 void WritePlusHeader(const set<Variable> &full_vars, const set<Variable> &new_vars){
 
 
@@ -151,22 +164,32 @@ void WritePlusHeader(const set<Variable> &full_vars, const set<Variable> &new_va
 
   file << "class baby_plus{\n";
   file << "public:\n";
-  file << "  baby_plus(TString inputs, TString outname = \"\"); // Constructor to read tree\n\n";
+  file << "  enum OutputMode{\n";
+  file << "    kFullCopy,  // Every branch is read and written through Fill\n";
+  file << "    kFastClone, // Baskets of branches not listed as rewritten are copied verbatim\n";
+  file << "    kDelta      // Only rewritten and new branches are written, to be used as a friend of the input\n";
+  file << "  };\n\n";
+  file << "  baby_plus(TString inputs, TString outname = \"\", // Constructor to read tree\n";
+  file << "            OutputMode mode = kFullCopy,\n";
+  file << "            const std::vector<std::string> &rewritten = std::vector<std::string>());\n\n";
 
   file << "  long GetEntries() const;\n";
   file << "  void GetEntry(const long entry);\n";
 
+  file << "  void AddDelta(TString inputs); // Read branches present in these files instead of the input\n";
+  file << "  bool HasBranch(const std::string &name) const; // In the input or the delta files\n";
   file << "  void Fill();\n";
   file << "  void Write();\n\n";
 
-  file << "  bool readOnly_;\n\n";
+  file << "  bool readOnly_;\n";
+  file << "  OutputMode mode_;\n\n";
   file << "  double bad_val_;\n\n";
 
   file << "  ~baby_plus();\n\n";
 
   for(set<Variable>::const_iterator var = full_vars.begin(); var != full_vars.end(); ++var){
     if(Contains(var->type_, "vector")){
-      file << "  " << var->type_ << " " << var->name_ << "();\n";
+      file << "  const " << var->type_ << " & " << var->name_ << "();\n";
     } else {
       file << "  " << var->type_ << " " << var->name_ << "();\n";
     }
@@ -182,8 +205,15 @@ void WritePlusHeader(const set<Variable> &full_vars, const set<Variable> &new_va
   }
   file << '\n';
 
+  file << "  // Output value to be overwritten whole: as out_, but without reading the input branch first\n";
+  for(set<Variable>::const_iterator var = all_vars.begin(); var != all_vars.end(); ++var){
+    file << "  " << var->type_ << " & set_out_" << var->name_ << "();\n";
+  }
+  file << '\n';
+
   file << "  TFile* outfile_;\n";
   file << "  TChain* intree_;\n";
+  file << "  TChain* deltatree_;\n";
   file << "  TTree* outtree_;\n";
   file << '\n';
 
@@ -207,6 +237,7 @@ void WritePlusHeader(const set<Variable> &full_vars, const set<Variable> &new_va
     }
     file << "  TBranch *b_" << var->name_ << "_;\n";
     file << "  mutable bool c_" << var->name_ << "_;\n";
+    file << "  TBranch *db_" << var->name_ << "_;\n";
   }
 
   for(set<Variable>::const_iterator var = all_vars.begin(); var != all_vars.end(); ++var){
@@ -217,9 +248,11 @@ void WritePlusHeader(const set<Variable> &full_vars, const set<Variable> &new_va
       file << "  " << var->type_ << " out_" << var->name_ << "_;\n";
     }
     file << "  mutable bool c_out_" << var->name_ << "_;\n";
+    file << "  TBranch *ob_" << var->name_ << "_;\n";
   }
 
   file << "  long entry_;\n";
+  file << "  long dentry_;\n";
 
   file << "};\n\n";
 
@@ -244,12 +277,14 @@ void WritePlusSource(const set<Variable> &full_vars,
   file << "#include <stdexcept>\n";
   file << "#include <string>\n";
   file << "#include <iostream>\n";
-  file << "#include <vector>\n\n";
+  file << "#include <vector>\n";
+  file << "#include <set>\n\n";
 
   file << "#include \"TROOT.h\"\n";
   file << "#include \"TTree.h\"\n";
   file << "#include \"TBranch.h\"\n";
   file << "#include \"TChain.h\"\n";
+  file << "#include \"TList.h\"\n";
   file << "#include \"TString.h\"\n";
   //  file << "#include \"TTreeFormula.h\"\n\n";
 
@@ -269,9 +304,11 @@ void WritePlusSource(const set<Variable> &full_vars,
   file << "  }\n";
   file << "}\n\n";
 
-  file << "baby_plus::baby_plus(TString inputs, TString outname):\n";
+  file << "baby_plus::baby_plus(TString inputs, TString outname, OutputMode mode, const vector<string> &rewritten):\n";
   file << "  readOnly_(outname==\"\"),\n";
+  file << "  mode_(mode),\n";
   file << "  bad_val_(-999.),\n";
+  file << "  deltatree_(NULL),\n";
 
   for(set<Variable>::const_iterator var = full_vars.begin(); var != full_vars.end(); ++var){
     if(Contains(var->type_, "vector")){
@@ -286,6 +323,7 @@ void WritePlusSource(const set<Variable> &full_vars,
     }
     file << "  b_" << var->name_ << "_(NULL),\n";
     file << "  c_" << var->name_ << "_(false),\n";
+    file << "  db_" << var->name_ << "_(NULL),\n";
   }
 
   for(set<Variable>::const_iterator var = all_vars.begin(); var != all_vars.end(); ++var){
@@ -300,18 +338,34 @@ void WritePlusSource(const set<Variable> &full_vars,
       file << "  p_out_" << var->name_ << "_(&out_" << var->name_ << "_),\n";
     }
     file << "  c_out_" << var->name_ << "_(false),\n";
+    file << "  ob_" << var->name_ << "_(NULL),\n";
   }
-  file << "  entry_(0){\n";
+  file << "  entry_(0),\n";
+  file << "  dentry_(0){\n";
 
   file << "  if (inputs!=\"\") {\n";
   file << "    intree_ = new TChain(\"tree\");\n";
   file << "    intree_->Add(inputs);\n\n";
   file << "  }\n\n";
+  file << "  set<string> rewrite(rewritten.cbegin(), rewritten.cend());\n";
   file << "  if (!readOnly_) {\n";
   file << "    outfile_ = new TFile(outname, \"recreate\");\n";
   file << "    if(!outfile_->IsOpen()) ERROR(\"Could not open output file \"+outname.Data());\n";
   file << "    outfile_->cd();\n";
-  file << "    outtree_ = intree_->CloneTree(0);\n";
+  file << "    if (mode_ == kFastClone) {\n";
+  file << "      // Copy the compressed baskets of every branch that is not rewritten\n";
+  for(set<Variable>::const_iterator var = full_vars.begin(); var != full_vars.end(); ++var){
+    file << "      if (rewrite.count(\"" << var->name_ << "\")) intree_->SetBranchStatus(\"" << var->name_ << "\", 0);\n";
+  }
+  file << "      outtree_ = intree_->CloneTree(-1, \"fast\");\n";
+  file << "      intree_->SetBranchStatus(\"*\", 1);\n";
+  file << "      // Keep the chain from redirecting the output branches to its own buffers\n";
+  file << "      if (intree_->GetListOfClones()) intree_->GetListOfClones()->Remove(outtree_);\n";
+  file << "    } else if (mode_ == kDelta) {\n";
+  file << "      outtree_ = new TTree(\"tree\", \"tree\");\n";
+  file << "    } else {\n";
+  file << "      outtree_ = intree_->CloneTree(0);\n";
+  file << "    }\n";
   file << "  }\n\n";
 
   for(set<Variable>::const_iterator var = full_vars.begin(); var != full_vars.end(); ++var){
@@ -321,31 +375,80 @@ void WritePlusSource(const set<Variable> &full_vars,
       file << "  intree_->SetBranchAddress(\"" << var->name_ << "\", &" << var->name_ << "_, &b_" << var->name_ << "_);\n";
     }
   }
-  file << "  if (!readOnly_) {\n";
+  file << "  if (!readOnly_ && mode_ == kFullCopy) {\n";
+  file << "  //Rewritten branches missing from the input are added to the copy\n";
+  for(set<Variable>::const_iterator var = full_vars.begin(); var != full_vars.end(); ++var){
+    if(Contains(var->type_, "vector")){
+      file << "    if (outtree_->GetBranch(\"" << var->name_ << "\")) outtree_->SetBranchAddress(\"" << var->name_ << "\", &p_out_" << var->name_ << "_);\n";
+      file << "    else if (rewrite.count(\"" << var->name_ << "\")) outtree_->Branch(\"" << var->name_ << "\", &p_out_" << var->name_ << "_);\n";
+    }else{
+      file << "    if (outtree_->GetBranch(\"" << var->name_ << "\")) outtree_->SetBranchAddress(\"" << var->name_ << "\", &out_" << var->name_ << "_);\n";
+      file << "    else if (rewrite.count(\"" << var->name_ << "\")) outtree_->Branch(\"" << var->name_ << "\", &out_" << var->name_ << "_);\n";
+    }
+  }
+  file << "  } else if (!readOnly_) {\n";
+  file << "  //Rewritten branches are recreated and filled one branch at a time\n";
   for(set<Variable>::const_iterator var = full_vars.begin(); var != full_vars.end(); ++var){
     if(Contains(var->type_, "vector")){
-      file << "    outtree_->SetBranchAddress(\"" << var->name_ << "\", &p_out_" << var->name_ << "_);\n";
+      file << "    if (rewrite.erase(\"" << var->name_ << "\")) ob_" << var->name_ << "_ = outtree_->Branch(\"" << var->name_ << "\", &p_out_" << var->name_ << "_);\n";
     }else{
-      file << "    outtree_->SetBranchAddress(\"" << var->name_ << "\", &out_" << var->name_ << "_);\n";
+      file << "    if (rewrite.erase(\"" << var->name_ << "\")) ob_" << var->name_ << "_ = outtree_->Branch(\"" << var->name_ << "\", &out_" << var->name_ << "_);\n";
     }
   }
+  file << "  }\n";
+  file << "  if (!readOnly_) {\n";
   file << "  //New branches from \"extra\" list\n";
   for(set<Variable>::const_iterator var = new_vars.begin(); var != new_vars.end(); ++var){
+    file << "    rewrite.erase(\"" << var->name_ << "\");\n";
     if(Contains(var->type_, "vector")){
-      file << "    outtree_->Branch(\"" << var->name_ << "\", &p_out_" << var->name_ << "_);\n";
+      file << "    ob_" << var->name_ << "_ = outtree_->Branch(\"" << var->name_ << "\", &p_out_" << var->name_ << "_);\n";
     }else{
-      file << "    outtree_->Branch(\"" << var->name_ << "\", &out_" << var->name_ << "_);\n";
+      file << "    ob_" << var->name_ << "_ = outtree_->Branch(\"" << var->name_ << "\", &out_" << var->name_ << "_);\n";
     }
   }
+  file << "    if (mode_ != kFullCopy && !rewrite.empty()) ERROR(\"Cannot rewrite unknown branch \"+*rewrite.cbegin());\n";
   file << "  }\n\n";
   file << "}\n\n";
 
+  file << "void baby_plus::AddDelta(TString inputs){\n";
+  file << "  if (deltatree_) ERROR(\"Only one set of delta files can be added\");\n";
+  file << "  deltatree_ = new TChain(\"tree\");\n";
+  file << "  deltatree_->Add(inputs);\n";
+  file << "  if (deltatree_->GetEntries() != intree_->GetEntries())\n";
+  file << "    ERROR(\"Delta files \"+inputs.Data()+\" have \"+to_string(deltatree_->GetEntries())+\" entries, input has \"+to_string(intree_->GetEntries()));\n";
+  for(set<Variable>::const_iterator var = full_vars.begin(); var != full_vars.end(); ++var){
+    file << "  if (deltatree_->GetBranch(\"" << var->name_ << "\")) {\n";
+    file << "    if (!readOnly_ && mode_ != kFullCopy && !ob_" << var->name_ << "_) ERROR(\"Branch " << var->name_ << " is read from a delta but is not in the rewritten list\");\n";
+    if(Contains(var->type_, "vector")){
+      file << "    deltatree_->SetBranchAddress(\"" << var->name_ << "\", &p_" << var->name_ << "_, &db_" << var->name_ << "_);\n";
+    }else{
+      file << "    deltatree_->SetBranchAddress(\"" << var->name_ << "\", &" << var->name_ << "_, &db_" << var->name_ << "_);\n";
+    }
+    file << "  }\n";
+  }
+  file << "}\n\n";
+
   file << "void baby_plus::Fill(){\n";
+  file << "  if (!readOnly_ && mode_ != kFullCopy) {\n";
+  file << "  //Only rewritten branches are filled, the rest were copied by CloneTree or stay in the input\n";
+  for(set<Variable>::const_iterator var = all_vars.begin(); var != all_vars.end(); ++var){
+    file << "    if (ob_" << var->name_ << "_) {\n";
+    if(full_vars.count(*var)){
+      file << "      if (!c_" << var->name_ << "_ && !c_out_" << var->name_ << "_) " << var->name_ << "();\n";
+    }
+    file << "      if (mode_ == kFastClone) ob_" << var->name_ << "_->Fill();\n";
+    file << "    } else if (c_out_" << var->name_ << "_) {\n";
+    file << "      ERROR(\"Branch " << var->name_ << " was modified but is not in the rewritten list\");\n";
+    file << "    }\n";
+  }
+  file << "    if (mode_ == kDelta) outtree_->Fill();\n";
+  file << "  } else {\n";
   file << "  //Loading unused branches so their values are copied to the new tree\n";
   for(set<Variable>::const_iterator var = full_vars.begin(); var != full_vars.end(); ++var){
     file << "  if (!readOnly_ && !c_"+var->name_+"_ && !c_out_"+var->name_+"_) " << var->name_ << "();\n";
   }
   file << "  outtree_->Fill();\n";
+  file << "  }\n";
 
   file << "  //Resetting variables\n";
   for(set<Variable>::const_iterator var = full_vars.begin(); var != full_vars.end(); ++var){
@@ -376,6 +479,11 @@ void WritePlusSource(const set<Variable> &full_vars,
   file << "}\n\n";
 
   file << "void baby_plus::Write(){\n";
+  file << "  if (mode_ == kFastClone) {\n";
+  for(set<Variable>::const_iterator var = all_vars.begin(); var != all_vars.end(); ++var){
+    file << "    if (ob_" << var->name_ << "_ && ob_" << var->name_ << "_->GetEntries() != outtree_->GetEntries()) ERROR(\"Branch " << var->name_ << " is not aligned with the cloned entries; Fill must be called for every entry\");\n";
+  }
+  file << "  }\n";
   file << "  outfile_->cd();\n";
   file << "  outtree_->Write();\n";
   file << "}\n\n";
@@ -388,18 +496,29 @@ void WritePlusSource(const set<Variable> &full_vars,
   file << "  return intree_->GetEntries();\n";
   file << "}\n\n";
 
+  file << "bool baby_plus::HasBranch(const std::string &name) const{\n";
+  file << "  return intree_->GetBranch(name.c_str()) || (deltatree_ && deltatree_->GetBranch(name.c_str()));\n";
+  file << "}\n\n";
+
   file << "void baby_plus::GetEntry(const long entry){\n";
 
   for(set<Variable>::const_iterator var = full_vars.begin(); var!= full_vars.end(); ++var){
     file << "  c_" << var->name_ << "_ = false;\n";
   }
   file << "  entry_ = intree_->LoadTree(entry);\n";
+  file << "  if (deltatree_) dentry_ = deltatree_->LoadTree(entry);\n";
   file << "}\n\n";
 
   for(set<Variable>::const_iterator var = full_vars.begin(); var != full_vars.end(); ++var){
-    file << var->type_ << " baby_plus::" << var->name_ << "(){\n";
+    // Vectors are returned by reference to avoid a copy on every access
+    if(Contains(var->type_, "vector")){
+      file << "const " << var->type_ << " & baby_plus::" << var->name_ << "(){\n";
+    }else{
+      file << var->type_ << " baby_plus::" << var->name_ << "(){\n";
+    }
     file << "  if(!c_" << var->name_ << "_ && b_" << var->name_ <<"_){\n";
-    file << "    b_" << var->name_ << "_->GetEntry(entry_);\n";
+    file << "    if (db_" << var->name_ << "_) db_" << var->name_ << "_->GetEntry(dentry_);\n";
+    file << "    else b_" << var->name_ << "_->GetEntry(entry_);\n";
     if(Contains(var->type_, "vector")){
       if (!Contains(var->type_, "tring") && !Contains(var->type_, "bool")){
         file << "    for (unsigned i(0); i<" << var->name_ << "_.size(); i++) {\n";
@@ -437,6 +556,271 @@ void WritePlusSource(const set<Variable> &full_vars,
     file << "}\n\n";
   }
 
+  for(set<Variable>::const_iterator var = all_vars.begin(); var != all_vars.end(); ++var){
+    file << var->type_ << " & baby_plus::set_out_" << var->name_ << "(){\n";
+    file << "  c_out_" << var->name_ << "_ = true;\n";
+    file << "  return out_" << var->name_ << "_;\n";
+    file << "}\n\n";
+  }
+
+  file.close();
+}
+
+void WritePlusBlockHeader(const set<Variable> &full_vars){
+  ofstream file("inc/baby_plus_block.hpp");
+
+  file << "// baby_plus_block: block-wise columnar reader for reduced tree ntuples\n";
+  file << "// File generated with generate_baby.exe\n\n";
+
+  file << "#ifndef H_BABY_PLUS_BLOCK\n";
+  file << "#define H_BABY_PLUS_BLOCK\n\n";
+
+  file << "#include <cstddef>\n\n";
+  file << "#include <vector>\n";
+  file << "#include <string>\n\n";
+  file << "#include \"TChain.h\"\n\n";
+  file << "#include \"TString.h\"\n\n";
+
+  file << "// Loads consecutive entries of the selected branches into contiguous columns.\n";
+  file << "// Scalar branches give one value per entry; vector branches give the flat\n";
+  file << "// values of all entries in the block plus Size()+1 offsets into them.\n";
+  file << "class baby_plus_block{\n";
+  file << "public:\n";
+  file << "  baby_plus_block(TString inputs,\n";
+  file << "                  const std::vector<std::string> &branches = std::vector<std::string>(),\n";
+  file << "                  long block_size = 4096); // Empty branch list selects every branch\n\n";
+
+  file << "  long GetEntries() const;\n";
+  file << "  long LoadBlock(const long first); // Returns number of entries loaded\n";
+  file << "  long FirstEntry() const;\n";
+  file << "  long Size() const;\n";
+  file << "  long BlockSize() const;\n\n";
+
+  file << "  double bad_val_;\n\n";
+
+  file << "  ~baby_plus_block();\n\n";
+
+  file << "  static const long kCacheSize = 30000000; // Bytes of read-ahead cache for the selected branches\n\n";
+
+  for(set<Variable>::const_iterator var = full_vars.begin(); var != full_vars.end(); ++var){
+    file << "  const std::vector<" << ElementType(var->type_) << "> & " << var->name_ << "() const;\n";
+    if(Contains(var->type_, "vector")){
+      file << "  const std::vector<std::size_t> & " << var->name_ << "_offsets() const;\n";
+    }
+  }
+  file << '\n';
+
+  file << "  TChain* intree_;\n";
+  file << '\n';
+
+  file << "private:\n";
+  file << "  class VectorLoader{\n";
+  file << "  public:\n";
+  file << "    VectorLoader();\n";
+  file << "  private:\n";
+  file << "    static bool loaded_;\n";
+  file << "  };\n\n";
+
+  file << "  static VectorLoader vl_;\n";
+  for(set<Variable>::const_iterator var = full_vars.begin(); var != full_vars.end(); ++var){
+    file << "  " << var->type_ << " e_" << var->name_ << "_;\n";
+    if(Contains(var->type_, "vector")){
+      file << "  " << var->type_ << " *p_e_" << var->name_ << "_;\n";
+    }
+    file << "  std::vector<" << ElementType(var->type_) << "> " << var->name_ << "_;\n";
+    if(Contains(var->type_, "vector")){
+      file << "  std::vector<std::size_t> " << var->name_ << "_offsets_;\n";
+    }
+    file << "  TBranch *b_" << var->name_ << "_;\n";
+    file << "  bool s_" << var->name_ << "_;\n";
+  }
+
+  file << "  long block_size_;\n";
+  file << "  long first_;\n";
+  file << "  long size_;\n";
+
+  file << "};\n\n";
+
+  file << "#endif" << endl;
+
+  file.close();
+}
+
+void WritePlusBlockSource(const set<Variable> &full_vars){
+  ofstream file("src/baby_plus_block.cpp");
+
+  file << "// baby_plus_block: block-wise columnar reader for reduced tree ntuples\n";
+  file << "//File generated with generate_baby.exe\n\n";
+
+  file << "#include \"baby_plus_block.hpp\"\n\n";
+
+  file << "#include <cmath>\n\n";
+  file << "#include <algorithm>\n";
+  file << "#include <stdexcept>\n";
+  file << "#include <string>\n";
+  file << "#include <set>\n";
+  file << "#include <iostream>\n";
+  file << "#include <vector>\n\n";
+
+  file << "#include \"TROOT.h\"\n";
+  file << "#include \"TTree.h\"\n";
+  file << "#include \"TBranch.h\"\n";
+  file << "#include \"TChain.h\"\n";
+  file << "#include \"TFile.h\"\n";
+  file << "#include \"TString.h\"\n";
+
+  file << "using namespace std;\n\n";
+
+  file << "#define ERROR(x) do{throw std::runtime_error(string(\"Error in file \")+__FILE__+\" at line \"+to_string(__LINE__)+\" (in \"+__func__+\"): \"+x);}while(false)\n";
+  file << "#define DBG(x) do{std::cerr << \"In \" << __FILE__ << \" at line \" << __LINE__ << \" (in function \" << __func__ << \"): \" << x << std::endl;}while(false)\n\n";
+
+  file << "bool baby_plus_block::VectorLoader::loaded_ = false;\n\n";
+
+  file << "baby_plus_block::VectorLoader baby_plus_block::vl_ = baby_plus_block::VectorLoader();\n\n";
+
+  file << "baby_plus_block::VectorLoader::VectorLoader(){\n";
+  file << "  if(!loaded_){\n";
+  file << "    gROOT->ProcessLine(\"#include <vector>\");\n";
+  file << "    loaded_ = true;\n";
+  file << "  }\n";
+  file << "}\n\n";
+
+  file << "baby_plus_block::baby_plus_block(TString inputs, const vector<string> &branches, long block_size):\n";
+  file << "  bad_val_(-999.),\n";
+  file << "  intree_(new TChain(\"tree\")),\n";
+  for(set<Variable>::const_iterator var = full_vars.begin(); var != full_vars.end(); ++var){
+    if(Contains(var->type_, "vector")){
+      file << "  e_" << var->name_ << "_(0),\n";
+      file << "  p_e_" << var->name_ << "_(&e_" << var->name_ << "_),\n";
+    }else{
+      file << "  e_" << var->name_ << "_(static_cast<" << var->type_ << ">(bad_val_)),\n";
+    }
+    file << "  " << var->name_ << "_(),\n";
+    if(Contains(var->type_, "vector")){
+      file << "  " << var->name_ << "_offsets_(1, 0),\n";
+    }
+    file << "  b_" << var->name_ << "_(NULL),\n";
+    file << "  s_" << var->name_ << "_(false),\n";
+  }
+  file << "  block_size_(block_size),\n";
+  file << "  first_(0),\n";
+  file << "  size_(0){\n";
+  file << "  if(block_size_ <= 0) ERROR(\"Block size must be positive\");\n";
+  file << "  intree_->Add(inputs);\n\n";
+
+  file << "  bool all = branches.empty();\n";
+  file << "  set<string> wanted(branches.cbegin(), branches.cend());\n";
+  for(set<Variable>::const_iterator var = full_vars.begin(); var != full_vars.end(); ++var){
+    file << "  s_" << var->name_ << "_ = wanted.erase(\"" << var->name_ << "\") || all;\n";
+  }
+  file << "  if(!wanted.empty()) ERROR(\"Branch \"+*wanted.cbegin()+\" is not in variables/full\");\n\n";
+
+  file << "  //Read-ahead cache holding the baskets of the selected branches only\n";
+  file << "  intree_->SetCacheSize(kCacheSize);\n";
+  for(set<Variable>::const_iterator var = full_vars.begin(); var != full_vars.end(); ++var){
+    file << "  if(s_" << var->name_ << "_){\n";
+    if(Contains(var->type_, "vector")){
+      file << "    intree_->SetBranchAddress(\"" << var->name_ << "\", &p_e_" << var->name_ << "_, &b_" << var->name_ << "_);\n";
+    }else{
+      file << "    intree_->SetBranchAddress(\"" << var->name_ << "\", &e_" << var->name_ << "_, &b_" << var->name_ << "_);\n";
+    }
+    file << "    intree_->AddBranchToCache(\"" << var->name_ << "\", true);\n";
+    file << "  }\n";
+  }
+  file << "}\n\n";
+
+  file << "baby_plus_block::~baby_plus_block(){\n";
+  file << "  delete intree_;\n";
+  file << "}\n\n";
+
+  file << "long baby_plus_block::GetEntries() const{\n";
+  file << "  return intree_->GetEntries();\n";
+  file << "}\n\n";
+
+  file << "long baby_plus_block::FirstEntry() const{\n";
+  file << "  return first_;\n";
+  file << "}\n\n";
+
+  file << "long baby_plus_block::Size() const{\n";
+  file << "  return size_;\n";
+  file << "}\n\n";
+
+  file << "long baby_plus_block::BlockSize() const{\n";
+  file << "  return block_size_;\n";
+  file << "}\n\n";
+
+  file << "long baby_plus_block::LoadBlock(const long first){\n";
+  file << "  //Resetting columns\n";
+  for(set<Variable>::const_iterator var = full_vars.begin(); var != full_vars.end(); ++var){
+    file << "  " << var->name_ << "_.clear();\n";
+    if(Contains(var->type_, "vector")){
+      file << "  " << var->name_ << "_offsets_.assign(1, 0);\n";
+    }
+  }
+  file << "  first_ = first;\n";
+  file << "  size_ = 0;\n";
+  file << "  const long last = min(first+block_size_, GetEntries());\n";
+  file << "  long entry = first;\n";
+  file << "  while(entry < last){\n";
+  file << "    //Read branch by branch within each file so every basket is decompressed once per block\n";
+  file << "    const long local = intree_->LoadTree(entry);\n";
+  file << "    if(local < 0) break;\n";
+  file << "    const long tree_end = intree_->GetTreeOffset()[intree_->GetTreeNumber()+1];\n";
+  file << "    const long n = min(last, tree_end) - entry;\n";
+  file << "    //A selected branch missing from this file would leave stale values in the block\n";
+  for(set<Variable>::const_iterator var = full_vars.begin(); var != full_vars.end(); ++var){
+    file << "    if(s_" << var->name_ << "_ && !b_" << var->name_ << "_){\n";
+    file << "      ERROR(\"Branch " << var->name_ << " is not in \"+string(intree_->GetTree()->GetCurrentFile()->GetName()));\n";
+    file << "    }\n";
+  }
+  for(set<Variable>::const_iterator var = full_vars.begin(); var != full_vars.end(); ++var){
+    const string &name = var->name_;
+    bool check_nan = !Contains(var->type_, "tring") && !Contains(var->type_, "bool");
+    file << "    if(s_" << name << "_){\n";
+    file << "      for(long i = 0; i < n; ++i){\n";
+    file << "        b_" << name << "_->GetEntry(local+i);\n";
+    if(Contains(var->type_, "vector")){
+      if(check_nan){
+        file << "        for (unsigned j(0); j<e_" << name << "_.size(); j++) {\n";
+        file << "          if (isnan(e_" << name << "_[j]) || isinf(e_" << name << "_[j])) {\n";
+        file << "            cout<<\"Variable " << name << " at idx \"<<j<<\" is Nan or Inf.\"<<endl;\n";
+        file << "            e_" << name << "_[j] = 1;\n";
+        file << "          }\n";
+        file << "        }\n";
+      }
+      file << "        " << name << "_.insert(" << name << "_.end(), e_" << name << "_.cbegin(), e_" << name << "_.cend());\n";
+      file << "        " << name << "_offsets_.push_back(" << name << "_.size());\n";
+    }else{
+      if(check_nan){
+        file << "        if (isnan(e_" << name << "_) || isinf(e_" << name << "_)){\n";
+        file << "          cout<<\"Variable " << name << " is Nan or Inf.\"<<endl;\n";
+        file << "          e_" << name << "_ = 1;\n";
+        file << "        }\n";
+      }
+      file << "        " << name << "_.push_back(e_" << name << "_);\n";
+    }
+    file << "      }\n";
+    file << "    }\n";
+  }
+  file << "    entry += n;\n";
+  file << "    size_ += n;\n";
+  file << "  }\n";
+  file << "  return size_;\n";
+  file << "}\n\n";
+
+  for(set<Variable>::const_iterator var = full_vars.begin(); var != full_vars.end(); ++var){
+    file << "const std::vector<" << ElementType(var->type_) << "> & baby_plus_block::" << var->name_ << "() const{\n";
+    file << "  if(!s_" << var->name_ << "_) ERROR(\"Branch " << var->name_ << " was not selected\");\n";
+    file << "  return " << var->name_ << "_;\n";
+    file << "}\n\n";
+    if(Contains(var->type_, "vector")){
+      file << "const std::vector<std::size_t> & baby_plus_block::" << var->name_ << "_offsets() const{\n";
+      file << "  if(!s_" << var->name_ << "_) ERROR(\"Branch " << var->name_ << " was not selected\");\n";
+      file << "  return " << var->name_ << "_offsets_;\n";
+      file << "}\n\n";
+    }
+  }
+
   file.close();
 }
 
@@ -464,11 +848,12 @@ void WriteCorrHeader(const set<Variable> &corr_vars, const set<Variable> &new_va
 
   file << "class baby_corr{\n";
   file << "public:\n";
-  file << "  baby_corr(TString inputs, TString outname = \"\"); // Constructor to read tree\n\n";
+  file << "  baby_corr(TString inputs, TString outname = \"\"); // Constructor to read tree, in memory only if both are empty\n\n";
 
   file << "  long GetEntries() const;\n";
   file << "  void GetEntry(const long entry);\n";
 
+  file << "  void Add(baby_corr &other); // Sums the out_ values of other into this one\n";
   file << "  void Fill();\n";
   file << "  void Write();\n\n";
 
@@ -637,7 +1022,7 @@ void WriteCorrSource(const set<Variable> &corr_vars, const set<Variable> &new_va
       file << "  intree_->SetBranchAddress(\"" << var->name_ << "\", &" << var->name_ << "_, &b_" << var->name_ << "_);\n";
     }
   }
-  file << "  } else {\n";
+  file << "  } else if (!readOnly_) {\n";
   for(set<Variable>::const_iterator var = all_vars.begin(); var != all_vars.end(); ++var){
     if(Contains(var->type_, "vector")){
       file << "    outtree_->Branch(\"" << var->name_ << "\", &p_out_" << var->name_ << "_);\n";
@@ -648,6 +1033,18 @@ void WriteCorrSource(const set<Variable> &corr_vars, const set<Variable> &new_va
   file << "  }\n\n";
   file << "}\n\n";
 
+  file << "void baby_corr::Add(baby_corr &other){\n";
+  for(set<Variable>::const_iterator var = all_vars.begin(); var != all_vars.end(); ++var){
+    if(Contains(var->type_, "tring")) continue;
+    if(Contains(var->type_, "vector")){
+      file << "  if (out_" << var->name_ << "().size() < other.out_" << var->name_ << "().size()) out_" << var->name_ << "().resize(other.out_" << var->name_ << "().size(), 0);\n";
+      file << "  for (size_t i(0); i<other.out_" << var->name_ << "().size(); i++) out_" << var->name_ << "()[i] += other.out_" << var->name_ << "()[i];\n";
+    }else{
+      file << "  out_" << var->name_ << "() += other.out_" << var->name_ << "();\n";
+    }
+  }
+  file << "}\n\n";
+
   file << "void baby_corr::Fill(){\n";
   file << "  //Loading unused branches so their values are copied to the new tree\n";
   file << "  if (!readOnly_) {\n";
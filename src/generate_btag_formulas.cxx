@@ -0,0 +1,155 @@
+// generate_btag_formulas: writes the b-tag SF formulas of the given csv files
+// out as C++ functions, used by BTagCalibrationReader in place of the bytecode
+
+#include <cstdio>
+#include <cstdlib>
+
+#include <fstream>
+#include <iostream>
+#include <set>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "BTagEntry.hpp"
+#include "BTagFormula.hpp"
+
+using namespace std;
+
+set<string> GetFormulas(const string &file_name){
+  ifstream infile(file_name.c_str());
+  if(!infile.good()){
+    cerr << "Could not open " << file_name << endl;
+    exit(1);
+  }
+
+  // Lines are read as in BTagCalibration::readCSV, so the expressions are
+  // the keys the reader looks up
+  set<string> formulas;
+  string line;
+  bool first = true;
+  while(getline(infile, line)){
+    line = BTagEntry::trimStr(line);
+    if(first){
+      first = false;
+      if(line.find("OperatingPoint") != string::npos) continue;
+    }
+    if(line.empty()) continue;
+    formulas.insert(BTagEntry(line).formula);
+  }
+  return formulas;
+}
+
+string Quote(const string &text){
+  string quoted = "\"";
+  for(char c: text){
+    if(c == '"' || c == '\\') quoted += '\\';
+    quoted += c;
+  }
+  return quoted+"\"";
+}
+
+void WriteHeader(){
+  ofstream file("inc/btag_formulas.hpp");
+
+  file << "// btag_formulas: b-tag SF formulas compiled to C++\n";
+  file << "// File generated with generate_btag_formulas.exe\n\n";
+
+  file << "#ifndef H_BTAG_FORMULAS\n";
+  file << "#define H_BTAG_FORMULAS\n\n";
+
+  file << "#include <string>\n\n";
+
+  file << "#include \"BTagFormula.hpp\"\n\n";
+
+  file << "// Function computing the given expression, or nullptr if it was not generated\n";
+  file << "BTagFormula::NativeFunction FindNativeBTagFormula(const std::string &expression);\n\n";
+
+  file << "#endif\n";
+  file.close();
+}
+
+void WriteSource(const vector<string> &csv_files, const vector<pair<string, BTagFormula> > &formulas){
+  ofstream file("src/btag_formulas.cpp");
+
+  file << "// btag_formulas: b-tag SF formulas compiled to C++\n";
+  file << "// File generated with generate_btag_formulas.exe from";
+  if(csv_files.empty()) file << " no csv files";
+  for(const auto &csv_file: csv_files) file << " " << csv_file;
+  file << "\n\n";
+
+  file << "#include \"btag_formulas.hpp\"\n\n";
+
+  file << "#include <cmath>\n";
+  file << "#include <cstring>\n\n";
+  file << "#include <algorithm>\n\n";
+
+  if(formulas.empty()){
+    file << "BTagFormula::NativeFunction FindNativeBTagFormula(const std::string &){\n";
+    file << "  return nullptr;\n";
+    file << "}\n";
+    file.close();
+    return;
+  }
+
+  file << "namespace{\n";
+  for(size_t i = 0; i < formulas.size(); ++i){
+    const BTagFormula &formula = formulas.at(i).second;
+    file << "  double f" << i << "(double" << (formula.usesX() ? " x" : "") << "){\n";
+    file << "    return " << formula.toCpp() << ";\n";
+    file << "  }\n\n";
+  }
+
+  file << "  struct Entry{\n";
+  file << "    const char *expression;\n";
+  file << "    BTagFormula::NativeFunction function;\n";
+  file << "  };\n\n";
+
+  file << "  // Sorted by expression\n";
+  file << "  const Entry entries[] = {\n";
+  for(size_t i = 0; i < formulas.size(); ++i){
+    file << "    {" << Quote(formulas.at(i).first) << ", f" << i << "}"
+         << (i+1 < formulas.size() ? "," : "") << "\n";
+  }
+  file << "  };\n";
+  file << "}\n\n";
+
+  file << "BTagFormula::NativeFunction FindNativeBTagFormula(const std::string &expression){\n";
+  file << "  const Entry *end = entries + sizeof(entries)/sizeof(entries[0]);\n";
+  file << "  const Entry *entry = std::lower_bound(entries, end, expression,\n";
+  file << "                                        [](const Entry &e, const std::string &expr){\n";
+  file << "                                          return strcmp(e.expression, expr.c_str()) < 0;\n";
+  file << "                                        });\n";
+  file << "  if(entry == end || expression != entry->expression) return nullptr;\n";
+  file << "  return entry->function;\n";
+  file << "}\n";
+  file.close();
+}
+
+int main(int argc, char *argv[]){
+  vector<string> csv_files;
+  set<string> expressions;
+  for(int iarg = 1; iarg < argc; ++iarg){
+    csv_files.push_back(argv[iarg]);
+    set<string> file_formulas = GetFormulas(argv[iarg]);
+    expressions.insert(file_formulas.begin(), file_formulas.end());
+  }
+
+  // Expressions BTagFormula cannot compile stay with TF1
+  vector<pair<string, BTagFormula> > formulas;
+  size_t skipped = 0;
+  for(const auto &expression: expressions){
+    BTagFormula formula(expression);
+    if(formula.toCpp() == ""){
+      ++skipped;
+      continue;
+    }
+    formulas.push_back(make_pair(expression, formula));
+  }
+
+  WriteHeader();
+  WriteSource(csv_files, formulas);
+  cout << "Wrote " << formulas.size() << " b-tag formulas to src/btag_formulas.cpp";
+  if(skipped) cout << ", " << skipped << " left to TF1";
+  cout << endl;
+}
@@ -0,0 +1,51 @@
+//----------------------------------------------------------------------------
+// hist_axis - Binning of a histogram axis, detached from the histogram
+//----------------------------------------------------------------------------
+
+#include "hist_axis.hpp"
+
+#include "TAxis.h"
+
+HistAxis::HistAxis(const TAxis &axis):
+  nbins_(axis.GetNbins()),
+  min_(axis.GetXmin()),
+  max_(axis.GetXmax()),
+  width_(max_-min_),
+  edges_(){
+  if(axis.IsVariableBinSize()){
+    for(int bin = 1; bin <= nbins_; ++bin) edges_.push_back(axis.GetBinLowEdge(bin));
+    edges_.push_back(axis.GetBinUpEdge(nbins_));
+  }
+}
+
+HistAxis::HistAxis(const CalibBundle::Axis &axis):
+  nbins_(axis.nbins),
+  min_(axis.min),
+  max_(axis.max),
+  width_(max_-min_),
+  edges_(){
+  if(axis.edges != nullptr) edges_.assign(axis.edges, axis.edges+nbins_+1);
+}
+
+int HistAxis::Size() const{
+  return nbins_+2;
+}
+
+int HistAxis::NumBins() const{
+  return nbins_;
+}
+
+int HistAxis::Bin(double x) const{
+  if(!edges_.empty()){
+    // Number of edges at or below x, as TAxis' binary search; NaN counts all
+    int bin = 0;
+    for(double edge: edges_) bin += !(x < edge);
+    return bin;
+  }
+  // Same expression as TAxis::FindFixBin, with x clamped into the range first
+  // so out of range values never reach the int conversion
+  bool under = x < min_, over = !(x < max_);
+  double xc = (under || over) ? min_ : x;
+  int bin = 1 + static_cast<int>(nbins_*(xc-min_)/width_);
+  return under ? 0 : (over ? nbins_+1 : bin);
+}
@@ -0,0 +1,78 @@
+//----------------------------------------------------------------------------
+// lepton_sf_grid - 2D lepton SF histograms compiled into flat clamped grids
+//----------------------------------------------------------------------------
+
+#include "lepton_sf_grid.hpp"
+
+#include <algorithm>
+#include <vector>
+
+#include "TH2.h"
+
+#include "utilities.hpp"
+
+using namespace std;
+
+namespace{
+  Correction::Axis MakeAxis(const string &input, const TAxis &axis){
+    Correction::Axis out = {input, axis.GetNbins(), axis.GetXmin(), axis.GetXmax(), vector<double>()};
+    if(axis.IsVariableBinSize()){
+      for(int bin = 1; bin <= out.nbins; ++bin) out.edges.push_back(axis.GetBinLowEdge(bin));
+      out.edges.push_back(axis.GetBinUpEdge(out.nbins));
+    }
+    return out;
+  }
+
+  Correction::Axis MakeAxis(const string &input, const CalibBundle::Axis &axis){
+    Correction::Axis out = {input, axis.nbins, axis.min, axis.max, vector<double>()};
+    if(axis.edges != nullptr) out.edges.assign(axis.edges, axis.edges+axis.nbins+1);
+    return out;
+  }
+}
+
+LeptonSFGrid::LeptonSFGrid(const TH2 &hist):
+  correction_(){
+  Fill(MakeAxis("x", *hist.GetXaxis()), MakeAxis("y", *hist.GetYaxis()),
+       [&hist](int ix, int iy){return hist.GetBinContent(ix, iy);},
+       [&hist](int ix, int iy){return hist.GetBinError(ix, iy);});
+}
+
+LeptonSFGrid::LeptonSFGrid(const CalibBundle::Hist &hist):
+  correction_(){
+  if(hist.ndim != 2) ERROR("Bundled lepton SF is not a 2D histogram");
+  const int nx = hist.axes[0].nbins+2;
+  Fill(MakeAxis("x", hist.axes[0]), MakeAxis("y", hist.axes[1]),
+       [&hist, nx](int ix, int iy){return hist.content[ix+nx*iy];},
+       [&hist, nx](int ix, int iy){return hist.errors[ix+nx*iy];});
+}
+
+LeptonSFGrid::LeptonSFGrid(const Correction &correction):
+  correction_(correction){
+  const vector<Correction::Input> &inputs = correction.Inputs();
+  if(inputs.size() != 2 || inputs[0].type != Correction::kReal || inputs[1].type != Correction::kReal
+     || correction.Outputs().size() != 2){
+    ERROR("Lepton SF correction "+correction.Name()+" needs two real inputs and outputs (value, error)");
+  }
+}
+
+template<typename Content, typename Error>
+void LeptonSFGrid::Fill(const Correction::Axis &x, const Correction::Axis &y,
+                        const Content &content, const Error &error){
+  const int nx = x.nbins, ny = y.nbins;
+  vector<double> cells;
+  cells.reserve(2*(nx+2)*(ny+2));
+  for(int ix = 0; ix < nx+2; ++ix){
+    for(int iy = 0; iy < ny+2; ++iy){
+      double value = content(ix, iy), err = error(ix, iy);
+      bool outside = ix == 0 || iy == 0 || ix > nx || iy > ny;
+      if(outside && value == 0. && err == 0.){
+        int cx = min(max(ix, 1), nx), cy = min(max(iy, 1), ny);
+        value = content(cx, cy);
+        err = error(cx, cy);
+      }
+      cells.push_back(value);
+      cells.push_back(err);
+    }
+  }
+  correction_ = Correction::Table("lepton_sf", {x, y}, {"value", "error"}, cells);
+}
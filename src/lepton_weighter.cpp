@@ -1,270 +1,296 @@
 #include "lepton_weighter.hpp"
 
+#include <cmath>
+
+#include <fstream>
+#include <map>
+#include <sstream>
 #include <string>
-#include <numeric>
 
 #include "TFile.h"
 #include "TGraphAsymmErrors.h"
+#include "TH2D.h"
+
+#include "baby_plus_block.hpp"
 
+#include "calib_bundle.hpp"
+#include "correction_set.hpp"
 #include "utilities.hpp"
 
 using namespace std;
 
 namespace{
-  template<typename T>
-    T LoadSF(const string &file_name, const string &item_name){
-    string path = "data/"+file_name;
-    TFile f(path.c_str(), "read");
-    if(!f.IsOpen()) ERROR("Could not open "+file_name);
-    T* item = static_cast<T*>(f.Get(item_name.c_str()));
-    if(!item) ERROR("Could not find "+item_name+" in "+file_name);
-    return *item;
-  }
-  template<typename T>
-    pair<double, double> GetSF(const T &h, double x, double y, bool ignore_error = false){
-    pair<double, double> sf;
-    auto bin = h.FindFixBin(x, y);
-    if((h.IsBinOverflow(bin) || h.IsBinUnderflow(bin))
-       && h.GetBinContent(bin) == 0. && h.GetBinError(bin) == 0.){
-      auto bin_x = h.GetXaxis()->FindFixBin(x);
-      auto bin_y = h.GetYaxis()->FindFixBin(y);
-      if(bin_x <= 0) bin_x = 1;
-      if(bin_x > h.GetNbinsX()) bin_x = h.GetNbinsX();
-      if(bin_y <= 0) bin_y = 1;
-      if(bin_y > h.GetNbinsY()) bin_y = h.GetNbinsY();
-      sf = {h.GetBinContent(bin_x, bin_y), h.GetBinError(bin_x, bin_y)};
-    }else{
-      sf = {h.GetBinContent(bin), h.GetBinError(bin)};
-    }
-    if(ignore_error) sf.second = 0.;
-    return sf;
+  // Merges one component into the running (sf, err), with the same
+  // operations as MergeSF(running, component) used to do
+  inline void Merge(LeptonWeighter::SF &running, double value, double error){
+    running.error = hypot(running.value*error, value*running.error);
+    running.value *= value;
   }
 
-  pair<double, double> MergeSF(pair<double, double> a,
-                               pair<double, double> b){
-    double sf = a.first * b.first;
-    double err = hypot(a.first*b.second, b.first*a.second);
-    return {sf, err};
+  inline void Merge(LeptonWeighter::SF &running, const LeptonWeighter::SF &component){
+    Merge(running, component.value, component.error);
   }
 
-  TH2D GraphToHist(const TGraphAsymmErrors &g){
-    struct Point{
-      double xl, xh, y, e;
-      Point(double xl_in, double xh_in, double y_in, double e_in):
-        xl(xl_in),
-        xh(xh_in),
-        y(y_in),
-        e(e_in){
-      }
-      bool operator<(const Point &p) const{
-        return make_tuple(xl, xh, fabs(log(fabs(y))), fabs(e))
-          <make_tuple(p.xl, p.xh, fabs(log(fabs(p.y))), fabs(p.e));
+  // Signal leptons of each entry in a block, merged with sf(pt, eta)
+  template<typename LeptonSF>
+    void MergeBlock(const vector<bool> &sig, const vector<size_t> &offsets,
+                    const vector<float> &pt, const vector<float> &eta,
+                    LeptonSF sf, vector<LeptonWeighter::SF> &running){
+    if(pt.size() != sig.size() || eta.size() != sig.size()) ERROR("Lepton branches of different sizes in block");
+    for(size_t i = 0; i < running.size(); ++i){
+      for(size_t j = offsets[i]; j < offsets[i+1]; ++j){
+        if(sig[j]) Merge(running[i], sf(pt[j], eta[j]));
       }
-    };
-    vector<Point> bins;
-    Double_t *x = g.GetX();
-    Double_t *xl = g.GetEXlow();
-    Double_t *xh = g.GetEXhigh();
-    Double_t *y = g.GetY();
-    Double_t *yl = g.GetEYlow();
-    Double_t *yh = g.GetEYhigh();
-    for(int i = 0; i < g.GetN(); ++i){
-      bins.emplace_back(x[i]-fabs(xl[i]), x[i]+fabs(xh[i]),
-                        y[i], max(fabs(yl[i]), fabs(yh[i])));
     }
-    bool problems = true;
-    while(problems){
-      stable_sort(bins.begin(), bins.end());
-      problems = false;
-      for(auto low = bins.begin(); !problems && low != bins.end(); ++low){
-        auto high = low;
-        ++high;
-        if(high == bins.end()) break;
-        double new_y = sqrt(low->y * high->y);
-        double top = max(low->y+low->e, high->y+high->e);
-        double bot = min(low->y-low->e, high->y-high->e);
-        double new_e = max(top-new_y, new_y-bot);
-        if(low->xh < high->xl){
-          //Gap
-          bins.insert(high, Point(low->xh, high->xl, new_y, new_e));
-        }else if(low->xh > high->xl){
-          //Overlap
-          problems = true;
-          if(low->xh < high->xh){
-            //Plain overlap
-            Point new_low(low->xl, high->xl, low->y, low->e);
-            Point new_mid(high->xl, low->xh, new_y, new_e);
-            Point new_high(low->xh, high->xh, high->y, high->e);
-            *low = new_low;
-            *high = new_high;
-            bins.insert(high, new_mid);
-          }else if(low->xh == high->xh){
-            //Subset -> 2 bins
-            Point new_low(low->xl, high->xl, low->y, low->e);
-            Point new_high(high->xl, high->xh, new_y, new_e);
-            *low = new_low;
-            *high = new_high;
-          }else{
-            //Subset -> 3 bins
-            Point new_low(low->xl, high->xl, low->y, low->e);
-            Point new_mid(high->xl, high->xh, new_y, new_e);
-            Point new_high(high->xh, low->xh, low->y, low->e);
-            *low = new_low;
-            *high = new_high;
-            bins.insert(high, new_mid);
-          }
-        }
-      }
-    }
-    vector<double> bin_edges(bins.size()+1);
-    for(size_t i = 0; i < bins.size(); ++i){
-      bin_edges.at(i) = bins.at(i).xl;
-    }
-    bin_edges.back() = bins.back().xh;
-    TH2D h(g.GetName(), (string(g.GetTitle())+";"+g.GetXaxis()->GetTitle()+";"+g.GetYaxis()->GetTitle()).c_str(),
-           1, 0., 1.e4, bin_edges.size()-1, &bin_edges.at(0));
-    for(int ix = 0; ix <= 2; ++ix){
-      h.SetBinContent(ix, 0, 1.);
-      h.SetBinError(ix, 0, 1.);
-      h.SetBinContent(ix, h.GetNbinsY()+1, 1.);
-      h.SetBinError(ix, h.GetNbinsY()+1, 1.);
-      for(int iy = 1; iy <= h.GetNbinsY(); ++iy){
-        h.SetBinContent(ix, iy, bins.at(iy-1).y);
-        h.SetBinError(ix ,iy, bins.at(iy-1).e);
-      }
+  }
+
+  void WriteBlock(const vector<LeptonWeighter::SF> &running, float *w, float *sys_up, float *sys_down){
+    for(size_t i = 0; i < running.size(); ++i){
+      w[i] = running[i].value;
+      sys_up[i] = running[i].value+running[i].error;
+      sys_down[i] = running[i].value-running[i].error;
     }
-    return h;
   }
 }
 
-//https://twiki.cern.ch/twiki/bin/view/CMS/SUSLeptonSF#Muons_AN1
-const TH2F LeptonWeighter::sf_full_muon_medium_ = LoadSF<TH2F>("TnP_NUM_MediumID_DENOM_generalTracks_VAR_map_pt_eta.root",
-                                                               "SF");
-const TH2F LeptonWeighter::sf_full_muon_iso_ = LoadSF<TH2F>("TnP_NUM_MiniIsoTight_DENOM_MediumID_VAR_map_pt_eta.root",
-                                                            "SF");
+const LeptonWeighter::SFSet & LeptonWeighter::DefaultSFSet(){
+  static const SFSet sf_set = {
+    //https://twiki.cern.ch/twiki/bin/view/CMS/SUSLeptonSF#Muons_AN1
+    {"TnP_NUM_MediumID_DENOM_generalTracks_VAR_map_pt_eta.root", "SF"},
+    {"TnP_NUM_MiniIsoTight_DENOM_MediumID_VAR_map_pt_eta.root", "SF"},
+    {"TnP_NUM_MediumIP2D_DENOM_LooseID_VAR_map_pt_eta.root", "SF"},
+    //https://twiki.cern.ch/twiki/bin/view/CMS/SUSLeptonSF#Electrons_AN1
+    {"sf_full_electron_ID_and_iso_25_01_2017.root", "GsfElectronToCutBasedSpring15M"},
+    {"sf_full_electron_ID_and_iso_25_01_2017.root", "MVAVLooseElectronToMini"},
+    {"egammaEffi_EGM2D.root", "EGamma_SF2D"},
 
-const TH2F LeptonWeighter::sf_full_muon_vtx_ = LoadSF<TH2F>("TnP_NUM_MediumIP2D_DENOM_LooseID_VAR_map_pt_eta.root",
-                                                            "SF");
+    {"sf_fast_muon_medium.root", "histo2D"},
+    {"sf_fast_muon_iso.root", "histo2D"},
+    {"sf_fast_electron_mediumiso.root", "histo2D"}
+  };
+  return sf_set;
+}
+
+const map<string, LeptonWeighter::Source LeptonWeighter::SFSet::*> & LeptonWeighter::SFSetTables(){
+  static const map<string, Source SFSet::*> tables = {
+    {"full_muon_medium", &SFSet::full_muon_medium},
+    {"full_muon_iso", &SFSet::full_muon_iso},
+    {"full_muon_vtx", &SFSet::full_muon_vtx},
+    {"full_electron_medium", &SFSet::full_electron_medium},
+    {"full_electron_iso", &SFSet::full_electron_iso},
+    {"full_electron_tracking", &SFSet::full_electron_tracking},
+    {"fast_muon_medium", &SFSet::fast_muon_medium},
+    {"fast_muon_iso", &SFSet::fast_muon_iso},
+    {"fast_electron_mediumiso", &SFSet::fast_electron_mediumiso}
+  };
+  return tables;
+}
+
+LeptonWeighter::SFSet LeptonWeighter::ReadSFSet(const string &file){
+  const map<string, Source SFSet::*> &tables = SFSetTables();
+  ifstream in(file.c_str());
+  if(!in.good()) ERROR("Could not open lepton SF set "+file);
+  SFSet sf_set = DefaultSFSet();
+  string line;
+  while(getline(in, line)){
+    line = line.substr(0, line.find('#'));
+    istringstream fields(line);
+    string table;
+    Source source;
+    if(!(fields >> table)) continue;
+    if(!(fields >> source.file_name >> source.item_name)) ERROR("Expected \"table file_name item_name\" in "+file+": "+line);
+    auto member = tables.find(table);
+    if(member == tables.end()) ERROR("Unknown lepton SF table "+table+" in "+file);
+    sf_set.*(member->second) = source;
+  }
+  return sf_set;
+}
+
+LeptonSFGrid LeptonWeighter::LoadGrid(const Source &source){
+  const string &file_name = source.file_name, &item_name = source.item_name;
+  // Correction set files, e.g. from export_lepton_sf.exe
+  const string json = ".json";
+  if(file_name.size() > json.size() && file_name.compare(file_name.size()-json.size(), json.size(), json) == 0){
+    return LeptonSFGrid(CorrectionSet("data/"+file_name).Get(item_name));
+  }
 
+  const CalibBundle *bundle = CalibBundle::Default();
+  CalibBundle::Hist hist;
+  if(bundle != nullptr && bundle->FindHist("data/"+file_name, item_name, hist)) return LeptonSFGrid(hist);
+
+  string path = "data/"+file_name;
+  TFile f(path.c_str(), "read");
+  if(!f.IsOpen()) ERROR("Could not open "+file_name);
+  TObject *item = f.Get(item_name.c_str());
+  if(!item) ERROR("Could not find "+item_name+" in "+file_name);
+  // Graphs are bundled already converted by GraphToHist
+  if(item->InheritsFrom("TGraphAsymmErrors")) return LeptonSFGrid(GraphToHist(*static_cast<TGraphAsymmErrors*>(item)));
+  if(!item->InheritsFrom("TH2")) ERROR(item_name+" in "+file_name+" is not a 2D histogram or graph");
+  return LeptonSFGrid(*static_cast<TH2*>(item));
+}
 
-//Need to add muon tracking SF if it becomes available
-const TH2D LeptonWeighter::sf_full_muon_tracking_ = GraphToHist(LoadSF<TGraphAsymmErrors>("sf_full_muon_tracking.root",
-                                                                                          "ratio_eta"));
+LeptonWeighter::LeptonWeighter(const SFSet &sf_set):
+  sf_set_(sf_set),
+  full_(),
+  fast_(){
+}
 
-//https://twiki.cern.ch/twiki/bin/view/CMS/SUSLeptonSF#Electrons_AN1
-const TH2F LeptonWeighter::sf_full_electron_medium_ = LoadSF<TH2F>("sf_full_electron_ID_and_iso_25_01_2017.root",
-                                                                   "GsfElectronToCutBasedSpring15M");
-const TH2F LeptonWeighter::sf_full_electron_iso_ = LoadSF<TH2F>("sf_full_electron_ID_and_iso_25_01_2017.root",
-                                                                "MVAVLooseElectronToMini");
-const TH2F LeptonWeighter::sf_full_electron_tracking_ = LoadSF<TH2F>("egammaEffi_EGM2D.root",
-                                                                     "EGamma_SF2D");
+void LeptonWeighter::Preload(bool fast_sim) const{
+  FullTables();
+  if(fast_sim) FastTables();
+}
 
+const LeptonWeighter::FullSimTables & LeptonWeighter::FullTables() const{
+  call_once(full_.loaded, [this](){
+      full_.muon_medium = LoadGrid(sf_set_.full_muon_medium);
+      full_.muon_iso = LoadGrid(sf_set_.full_muon_iso);
+      full_.muon_vtx = LoadGrid(sf_set_.full_muon_vtx);
+      full_.electron_medium = LoadGrid(sf_set_.full_electron_medium);
+      full_.electron_iso = LoadGrid(sf_set_.full_electron_iso);
+      full_.electron_tracking = LoadGrid(sf_set_.full_electron_tracking);
+    });
+  return full_;
+}
 
-const TH2D LeptonWeighter::sf_fast_muon_medium_ = LoadSF<TH2D>("sf_fast_muon_medium.root",
-                                                               "histo2D");
-const TH2D LeptonWeighter::sf_fast_muon_iso_ = LoadSF<TH2D>("sf_fast_muon_iso.root",
-                                                            "histo2D");
-const TH2D LeptonWeighter::sf_fast_electron_mediumiso_ = LoadSF<TH2D>("sf_fast_electron_mediumiso.root",
-                                                                      "histo2D");
+const LeptonWeighter::FastSimTables & LeptonWeighter::FastTables() const{
+  call_once(fast_.loaded, [this](){
+      fast_.muon_medium = LoadGrid(sf_set_.fast_muon_medium);
+      fast_.muon_iso = LoadGrid(sf_set_.fast_muon_iso);
+      fast_.electron_mediumiso = LoadGrid(sf_set_.fast_electron_mediumiso);
+    });
+  return fast_;
+}
 
-void LeptonWeighter::FullSim(baby_plus &b, float &w_lep, vector<float> &sys_lep){
-  pair<double, double> sf(1., 0.);
+void LeptonWeighter::FullSim(baby_plus &b, float &w_lep, vector<float> &sys_lep) const{
+  const FullSimTables &t = FullTables();
+  SF sf = {1., 0.};
   for(size_t i = 0; i < b.mus_sig().size(); ++i){
     if(b.mus_sig().at(i)){
-      sf = MergeSF(sf, GetMuonScaleFactor(b, i));
+      Merge(sf, MuonSF(t, b.mus_pt().at(i), b.mus_eta().at(i)));
     }
   }
   for(size_t i = 0; i < b.els_sig().size(); ++i){
     if(b.els_sig().at(i)){
-      sf = MergeSF(sf, GetElectronScaleFactor(b, i));
+      Merge(sf, ElectronSF(t, b.els_scpt().at(i), b.els_sceta().at(i)));
     }
   }
-  w_lep = sf.first;
-  sys_lep = vector<float>{static_cast<float>(sf.first+sf.second),
-                          static_cast<float>(sf.first-sf.second)};
+  w_lep = sf.value;
+  sys_lep = vector<float>{static_cast<float>(sf.value+sf.error),
+                          static_cast<float>(sf.value-sf.error)};
 }
 
-void LeptonWeighter::FastSim(baby_plus &b, float &w_fs_lep, vector<float> &sys_fs_lep){
-  pair<double, double> sf(1., 0.);
+void LeptonWeighter::FastSim(baby_plus &b, float &w_fs_lep, vector<float> &sys_fs_lep) const{
+  const FastSimTables &t = FastTables();
+  SF sf = {1., 0.};
   for(size_t i = 0; i < b.mus_sig().size(); ++i){
     if(b.mus_sig().at(i)){
-      sf = MergeSF(sf, GetMuonScaleFactorFS(b, i));
+      Merge(sf, MuonSFFS(t, b.mus_pt().at(i), b.mus_eta().at(i)));
     }
   }
   for(size_t i = 0; i < b.els_sig().size(); ++i){
     if(b.els_sig().at(i)){
-      sf = MergeSF(sf, GetElectronScaleFactorFS(b, i));
+      Merge(sf, ElectronSFFS(t, b.els_scpt().at(i), b.els_sceta().at(i)));
     }
   }
-  w_fs_lep = sf.first;
-  sys_fs_lep = vector<float>{static_cast<float>(sf.first+sf.second),
-                             static_cast<float>(sf.first-sf.second)};
+  w_fs_lep = sf.value;
+  sys_fs_lep = vector<float>{static_cast<float>(sf.value+sf.error),
+                             static_cast<float>(sf.value-sf.error)};
+}
+
+const vector<string> & LeptonWeighter::BlockBranches(){
+  static const vector<string> branches = {"mus_sig", "mus_pt", "mus_eta", "els_sig", "els_scpt", "els_sceta"};
+  return branches;
 }
 
-std::pair<double, double> LeptonWeighter::GetMuonScaleFactor(baby_plus &b, size_t imu){
+void LeptonWeighter::FullSim(const baby_plus_block &block, float *w_lep, float *sys_lep_up, float *sys_lep_down) const{
+  const FullSimTables &t = FullTables();
+  vector<SF> sfs(block.Size(), SF{1., 0.});
+  MergeBlock(block.mus_sig(), block.mus_sig_offsets(), block.mus_pt(), block.mus_eta(),
+             [&t](double pt, double eta){return MuonSF(t, pt, eta);}, sfs);
+  MergeBlock(block.els_sig(), block.els_sig_offsets(), block.els_scpt(), block.els_sceta(),
+             [&t](double pt, double eta){return ElectronSF(t, pt, eta);}, sfs);
+  WriteBlock(sfs, w_lep, sys_lep_up, sys_lep_down);
+}
+
+void LeptonWeighter::FastSim(const baby_plus_block &block, float *w_fs_lep, float *sys_fs_lep_up, float *sys_fs_lep_down) const{
+  const FastSimTables &t = FastTables();
+  vector<SF> sfs(block.Size(), SF{1., 0.});
+  MergeBlock(block.mus_sig(), block.mus_sig_offsets(), block.mus_pt(), block.mus_eta(),
+             [&t](double pt, double eta){return MuonSFFS(t, pt, eta);}, sfs);
+  MergeBlock(block.els_sig(), block.els_sig_offsets(), block.els_scpt(), block.els_sceta(),
+             [&t](double pt, double eta){return ElectronSFFS(t, pt, eta);}, sfs);
+  WriteBlock(sfs, w_fs_lep, sys_fs_lep_up, sys_fs_lep_down);
+}
+
+LeptonWeighter::SF LeptonWeighter::MuonSF(double pt, double eta) const{
+  return MuonSF(FullTables(), pt, eta);
+}
+
+LeptonWeighter::SF LeptonWeighter::ElectronSF(double pt, double eta) const{
+  return ElectronSF(FullTables(), pt, eta);
+}
+
+LeptonWeighter::SF LeptonWeighter::MuonSFFS(double pt, double eta) const{
+  return MuonSFFS(FastTables(), pt, eta);
+}
+
+LeptonWeighter::SF LeptonWeighter::ElectronSFFS(double pt, double eta) const{
+  return ElectronSFFS(FastTables(), pt, eta);
+}
+
+LeptonWeighter::SF LeptonWeighter::MuonSF(const FullSimTables &t, double pt, double eta){
   //https://twiki.cern.ch/twiki/bin/view/CMS/SUSLeptonSF#Data_leading_order_FullSim_MC_co
   //ID, iso, tracking SFs applied
   //No stat error, 3% systematic from ID, iso
-  double pt = b.mus_pt().at(imu);
-  double eta = b.mus_eta().at(imu);
   double abseta = fabs(eta);
-  vector<pair<double, double> > sfs{
-    GetSF(sf_full_muon_medium_, pt, abseta, false),
-      make_pair(1., 0.03),//Systematic uncertainty
-      GetSF(sf_full_muon_iso_, pt, abseta, false),
-      make_pair(1., 0.03),//Systematic uncertainty
-      GetSF(sf_full_muon_vtx_, pt, abseta, false),
-      make_pair(1., 0.03)//Systematic uncertainty
-      //GetSF(sf_full_muon_tracking_, pt, eta)//Asymmetric in eta
-      };
-  return accumulate(sfs.cbegin(), sfs.cend(), make_pair(1., 0.), MergeSF);
+  SF sf = {1., 0.};
+  Merge(sf, t.muon_medium.Find(pt, abseta));
+  Merge(sf, 1., 0.03);//Systematic uncertainty
+  Merge(sf, t.muon_iso.Find(pt, abseta));
+  Merge(sf, 1., 0.03);//Systematic uncertainty
+  Merge(sf, t.muon_vtx.Find(pt, abseta));
+  Merge(sf, 1., 0.03);//Systematic uncertainty
+  //Muon tracking SF (ratio_eta graph in sf_full_muon_tracking.root) not applied: asymmetric in eta
+  return sf;
 }
 
-std::pair<double, double> LeptonWeighter::GetElectronScaleFactor(baby_plus &b, size_t iel){
+LeptonWeighter::SF LeptonWeighter::ElectronSF(const FullSimTables &t, double pt, double eta){
   //https://twiki.cern.ch/twiki/bin/view/CMS/SUSLeptonSF#Data_leading_order_FullSim_M_AN1
   //ID, iso, tracking SFs applied
   //ID iso systematics built-in
   //Tracking SFs from https://twiki.cern.ch/twiki/bin/view/CMS/EgammaIDRecipesRun2#Electron_efficiencies_and_scale
   //3% tracking systematic below 20 GeV
-  double pt = b.els_scpt().at(iel);
-  double eta = b.els_sceta().at(iel);
   double abseta = fabs(eta);
-  vector<pair<double, double> > sfs{
-    GetSF(sf_full_electron_medium_, pt, abseta),
-      GetSF(sf_full_electron_iso_, pt, abseta),
-      GetSF(sf_full_electron_tracking_, eta, pt),//Axes swapped, asymmetric in eta
-      //make_pair(1., pt<20. ? 0.03 : 0.)//Systematic uncertainty
-      make_pair(1., pt<20. || pt >80. ? 0.01 : 0.)//Systematic uncertainty
-      };
-  return accumulate(sfs.cbegin(), sfs.cend(), make_pair(1., 0.), MergeSF);
+  SF sf = {1., 0.};
+  Merge(sf, t.electron_medium.Find(pt, abseta));
+  Merge(sf, t.electron_iso.Find(pt, abseta));
+  Merge(sf, t.electron_tracking.Find(eta, pt));//Axes swapped, asymmetric in eta
+  //Merge(sf, 1., pt<20. ? 0.03 : 0.);//Systematic uncertainty
+  Merge(sf, 1., pt<20. || pt >80. ? 0.01 : 0.);//Systematic uncertainty
+  return sf;
 }
 
-std::pair<double, double> LeptonWeighter::GetMuonScaleFactorFS(baby_plus &b, size_t imu){
+LeptonWeighter::SF LeptonWeighter::MuonSFFS(const FastSimTables &t, double pt, double eta){
   //https://twiki.cern.ch/twiki/bin/view/CMS/SUSLeptonSF#FullSim_FastSim_TTBar_MC_compari
   //ID, iso SFs applied
   //No stat error, 2% systematic from ID, iso
-  double pt = b.mus_pt().at(imu);
-  double abseta = fabs(b.mus_eta().at(imu));
-  vector<pair<double, double> > sfs{
-    GetSF(sf_fast_muon_medium_, pt, abseta, false),
-      make_pair(1., 0.02),
-      GetSF(sf_fast_muon_iso_, pt, abseta, false),
-      make_pair(1., 0.02),
-      };
-  return accumulate(sfs.cbegin(), sfs.cend(), make_pair(1., 0.), MergeSF);
+  double abseta = fabs(eta);
+  SF sf = {1., 0.};
+  Merge(sf, t.muon_medium.Find(pt, abseta));
+  Merge(sf, 1., 0.02);
+  Merge(sf, t.muon_iso.Find(pt, abseta));
+  Merge(sf, 1., 0.02);
+  return sf;
 }
 
-std::pair<double, double> LeptonWeighter::GetElectronScaleFactorFS(baby_plus &b, size_t iel){
+LeptonWeighter::SF LeptonWeighter::ElectronSFFS(const FastSimTables &t, double pt, double eta){
   //https://twiki.cern.ch/twiki/bin/view/CMS/SUSLeptonSF#FullSim_FastSim_TTBar_MC_com_AN1
   //ID, iso SFs applied
   //No stat error, 2% systematic from ID, iso
-  double pt = b.els_scpt().at(iel);
-  double abseta = fabs(b.els_sceta().at(iel));
-  vector<pair<double, double> > sfs{
-    GetSF(sf_fast_electron_mediumiso_, pt, abseta, false),
-      make_pair(1., 0.02),//Systematic uncertainty
-      make_pair(1., 0.02)//Systematic uncertainty
-      };
-  return accumulate(sfs.cbegin(), sfs.cend(), make_pair(1., 0.), MergeSF);
+  double abseta = fabs(eta);
+  SF sf = {1., 0.};
+  Merge(sf, t.electron_mediumiso.Find(pt, abseta));
+  Merge(sf, 1., 0.02);//Systematic uncertainty
+  Merge(sf, 1., 0.02);//Systematic uncertainty
+  return sf;
 }
-
@@ -0,0 +1,103 @@
+//----------------------------------------------------------------------------
+// pattern_matcher - Finds which of a fixed list of substrings a text contains
+//----------------------------------------------------------------------------
+
+#include "pattern_matcher.hpp"
+
+#include <queue>
+#include <set>
+
+#include "utilities.hpp"
+
+using namespace std;
+
+const int PatternMatcher::kNoPattern;
+
+PatternMatcher::PatternMatcher(const vector<string> &patterns):
+  patterns_(patterns),
+  nclasses_(1),
+  next_(),
+  pattern_(),
+  output_(){
+  set<string> distinct;
+  for(const auto &pattern: patterns_){
+    if(pattern.empty()) ERROR("Empty pattern");
+    if(!distinct.insert(pattern).second) ERROR("Pattern \""+pattern+"\" given twice");
+    for(char c: pattern){
+      int &cls = classes_[static_cast<unsigned char>(c)];
+      if(cls == 0) cls = static_cast<int>(nclasses_++);
+    }
+  }
+
+  // Trie of the patterns, missing transitions at -1
+  next_.assign(nclasses_, -1);
+  pattern_.assign(1, kNoPattern);
+  for(size_t ipattern = 0; ipattern < patterns_.size(); ++ipattern) AddPattern(ipattern);
+
+  // Breadth-first, so the failure state of every state is complete before
+  // its children: missing transitions are taken from the failure state
+  size_t nstates = pattern_.size();
+  vector<int> fail(nstates, 0);
+  output_.assign(nstates, -1);
+  queue<int> states;
+  states.push(0);
+  while(!states.empty()){
+    int state = states.front();
+    states.pop();
+    for(size_t cls = 0; cls < nclasses_; ++cls){
+      int &next = next_[state*nclasses_+cls];
+      int fallback = state == 0 ? 0 : next_[fail[state]*nclasses_+cls];
+      if(next < 0){
+        next = fallback;
+      }else{
+        fail[next] = fallback;
+        output_[next] = pattern_[fallback] != kNoPattern ? fallback : output_[fallback];
+        states.push(next);
+      }
+    }
+  }
+}
+
+size_t PatternMatcher::Size() const{
+  return patterns_.size();
+}
+
+const string & PatternMatcher::Pattern(size_t i) const{
+  return patterns_.at(i);
+}
+
+vector<size_t> PatternMatcher::Find(const string &text) const{
+  vector<bool> found(patterns_.size(), false);
+  if(next_.empty()) return vector<size_t>();
+  int state = 0;
+  for(char c: text){
+    state = next_[state*nclasses_+classes_[static_cast<unsigned char>(c)]];
+    // Patterns ending here, longest first; the shorter ones were already
+    // found if the longer one was
+    for(int match = pattern_[state] != kNoPattern ? state : output_[state];
+        match >= 0 && !found[pattern_[match]];
+        match = output_[match]){
+      found[pattern_[match]] = true;
+    }
+  }
+
+  vector<size_t> indices;
+  for(size_t i = 0; i < found.size(); ++i){
+    if(found[i]) indices.push_back(i);
+  }
+  return indices;
+}
+
+void PatternMatcher::AddPattern(size_t ipattern){
+  int state = 0;
+  for(char c: patterns_[ipattern]){
+    int &next = next_[state*nclasses_+classes_[static_cast<unsigned char>(c)]];
+    if(next < 0){
+      next = static_cast<int>(pattern_.size());
+      pattern_.push_back(kNoPattern);
+      next_.resize(next_.size()+nclasses_, -1);
+    }
+    state = next_[state*nclasses_+classes_[static_cast<unsigned char>(c)]];
+  }
+  pattern_[state] = static_cast<int>(ipattern);
+}
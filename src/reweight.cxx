@@ -0,0 +1,205 @@
+// reweight: calc_corr + merge_corrections + apply_corr for all the files of one sample
+// in a single process, without writing the intermediate reweighted babies
+
+#include <ctime>
+#include <cstdio>
+
+#include <iostream>
+
+#include <getopt.h>
+
+#include "TError.h"
+
+#include "baby_plus.hpp"
+#include "baby_corr.hpp"
+#include "utilities.hpp"
+#include "btag_weighter.hpp"
+#include "lepton_weighter.hpp"
+#include "corrections.hpp"
+
+using namespace std;
+
+namespace {
+  string corr_file = "";
+  string out_dir = "";
+  string spill_dir = "";
+  vector<string> in_files;
+  bool quick = false;
+  bool fix_b_wgt = true;
+  bool fix_lep_wgt = false;
+  bool fast_clone = false;
+  bool delta = false;
+  double sf_grid_tolerance = 0.;
+  string lep_sf_set = "";
+}
+
+void GetOptions(int argc, char *argv[]);
+
+int main(int argc, char *argv[]){
+  // gErrorIgnoreLevel=6000; // Turns off ROOT errors due to missing branches
+  GetOptions(argc, argv);
+  if(in_files.empty() || corr_file == "" || out_dir == ""){
+    cout << "Usage: " << argv[0] << " -c corr_file -o out_dir [options] input_file [more_input_files...]" << endl;
+    return 1;
+  }
+  if(spill_dir == "") spill_dir = out_dir;
+
+  time_t begtime, endtime;
+  time(&begtime);
+
+  if(fast_clone && delta) ERROR("Options --fast_clone and --delta are exclusive");
+  baby_plus::OutputMode mode = baby_plus::kFullCopy;
+  if(fast_clone) mode = baby_plus::kFastClone;
+  else if(delta) mode = baby_plus::kDelta;
+
+  vector<string> out_files, spill_files;
+  for(const auto &in_file: in_files){
+    string base_dir = "", file_name = "";
+    SplitFilePath(in_file, base_dir, file_name);
+    out_files.push_back(out_dir+"/"+CopyReplaceAll(file_name, ".root", quick ? "_requick.root" : "_renorm.root"));
+    spill_files.push_back(spill_dir+"/"+CopyReplaceAll(file_name, ".root", "_spill.root"));
+  }
+
+  // calc_corr and apply_corr disagree on whether type 100000 is signal; keep both
+  int type = 0;
+  {
+    baby_plus probe(in_files.front());
+    if(probe.GetEntries() > 0){
+      probe.GetEntry(0);
+      type = probe.type();
+    }
+  }
+  bool calc_signal = type>=100e3;
+  bool apply_signal = type>100e3;
+
+  string proc = "tt";
+  if(Contains(in_files.front(), "WJets")) proc = "wjets";
+  else if(Contains(in_files.front(), "QCD")) proc = "qcd";
+  //Need to improve to handle FullSim signal points
+  BTagWeighter btw(proc, calc_signal, false, sf_grid_tolerance);
+  LeptonWeighter lw(lep_sf_set == "" ? LeptonWeighter::DefaultSFSet() : LeptonWeighter::ReadSFSet(lep_sf_set));
+
+  // First pass: new per-event weights are spilled to slim delta trees and the
+  // sums of weights of all files are reduced in memory
+  {
+    baby_corr sums("", corr_file);
+    corrections::InitSums(sums);
+    for(size_t ifile = 0; ifile < in_files.size(); ++ifile){
+      cout << "Pass 1, input file: " << in_files.at(ifile) << endl;
+      baby_plus b(in_files.at(ifile), spill_files.at(ifile), baby_plus::kDelta, corrections::calc_branches);
+      long nent = b.GetEntries();
+      sums.out_nent() += nent;
+      const bool has_shape_b_wgt = corrections::HasShapeBTag(b);
+      cout << "Running over " << nent << " events." << endl;
+      for(long entry(0); entry<nent; ++entry){
+        b.GetEntry(entry);
+        if (entry%100000==0 || entry == nent-1) {
+          cout << "Processing event: " << entry << endl;
+        }
+        corrections::CalcEntry(b, btw, lw, sums, calc_signal, quick, fix_b_wgt, fix_lep_wgt, has_shape_b_wgt);
+        b.Fill();
+      }
+      b.Write();
+    }
+
+    corrections::FixLumi(sums, corr_file);
+    corrections::FixISR(sums, corr_file);
+    corrections::Fix0L(sums);
+    corrections::Normalize(sums);
+
+    sums.Fill();
+    sums.Write();
+    cout << "Wrote corrections to " << corr_file << endl;
+  }
+
+  // Second pass: apply the corrections on top of the spilled weights
+  baby_corr c(corr_file);
+  if(c.GetEntries() != 1) ERROR("Corrections file "+corr_file+" should have exactly one entry");
+  c.GetEntry(0);
+  for(size_t ifile = 0; ifile < in_files.size(); ++ifile){
+    cout << "Pass 2, input file: " << in_files.at(ifile) << endl;
+    cout << "Writing output to: " << out_files.at(ifile) << endl;
+    {
+      baby_plus b(in_files.at(ifile), out_files.at(ifile), mode, corrections::apply_branches);
+      b.AddDelta(spill_files.at(ifile));
+      const bool has_shape_b_wgt = corrections::HasShapeBTag(b);
+      long nent = b.GetEntries();
+      for(long entry(0); entry<nent; ++entry){
+        b.GetEntry(entry);
+        if (entry%100000==0) {
+          cout << "Processing event: " << entry << endl;
+        }
+        corrections::ApplyEntry(b, c, apply_signal, quick, has_shape_b_wgt);
+        b.Fill();
+      }
+      b.Write();
+    }
+    if(remove(spill_files.at(ifile).c_str()) != 0) DBG("Could not remove "+spill_files.at(ifile));
+  }
+
+  cout << endl;
+  time(&endtime);
+  cout << "Time passed: " << hoursMinSec(difftime(endtime, begtime)) << endl << endl;
+}
+
+void GetOptions(int argc, char *argv[]){
+  while(true){
+    static struct option long_options[] = {
+      {"corr_file", required_argument, 0, 'c'}, // Corrections file to write, named after the sample
+      {"out_dir", required_argument, 0, 'o'},   // Directory in which to place the final babies
+      {"spill_dir", required_argument, 0, 's'}, // Directory for the per-event weights kept between passes
+      {"keep_b_wgt", no_argument, 0, 0},        // Use existing b-tag weights/systematics instead of applying new SFs
+      {"keep_lep_wgt", no_argument, 0, 0},      // Use existing lepton weights/systematics instead of applying new SFs
+      {"quick", no_argument, 0, 0},             // Leave less important variables uncorrected
+      {"fast_clone", no_argument, 0, 0},        // Copy untouched branches without decompressing them
+      {"delta", no_argument, 0, 0},             // Write only modified branches, to be read as a friend of the input
+      {"sf_grid", required_argument, 0, 0},     // Interpolate b-tag SFs tabulated every GeV where within this tolerance
+      {"lep_sf_set", required_argument, 0, 0},  // Apply new lepton SFs, with the tables listed in this file replacing the default ones
+      {0, 0, 0, 0}
+    };
+
+    char opt = -1;
+    int option_index;
+    opt = getopt_long(argc, argv, "c:o:s:", long_options, &option_index);
+    if(opt == -1) break;
+
+    string optname;
+    switch(opt){
+    case 'c':
+      corr_file = optarg;
+      break;
+    case 'o':
+      out_dir = optarg;
+      break;
+    case 's':
+      spill_dir = optarg;
+      break;
+    case 0:
+      optname = long_options[option_index].name;
+      if(optname == "quick"){
+        quick = true;
+      }else if(optname == "keep_b_wgt"){
+        fix_b_wgt = false;
+      }else if(optname == "keep_lep_wgt"){
+        fix_lep_wgt = false;
+      }else if(optname == "fast_clone"){
+        fast_clone = true;
+      }else if(optname == "delta"){
+        delta = true;
+      }else if(optname == "sf_grid"){
+        sf_grid_tolerance = atof(optarg);
+      }else if(optname == "lep_sf_set"){
+        fix_lep_wgt = true;
+        lep_sf_set = optarg;
+      }else{
+        printf("Bad option! Found option name %s\n", optname.c_str());
+        exit(1);
+      }
+      break;
+    default:
+      printf("Bad option! getopt_long returned character code 0%o\n", opt);
+      break;
+    }
+  }
+  for(int iarg = optind; iarg < argc; ++iarg) in_files.push_back(argv[iarg]);
+}
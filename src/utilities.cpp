@@ -6,19 +6,23 @@
 
 #include <cmath>
 
+#include <algorithm>
 #include <deque>
 #include <iostream>
 #include <fstream>
 #include <string>
 #include <stdexcept>
 #include <iomanip>   // setw
+#include <tuple>
 
 #include <libgen.h>
 
 #include "TCollection.h"
 #include "TFile.h"
 #include "TGraph.h"
+#include "TGraphAsymmErrors.h"
 #include "TH1D.h"
+#include "TH2D.h"
 #include "TList.h"
 #include "TString.h"
 #include "TSystemDirectory.h"
@@ -185,3 +189,135 @@ void SplitFilePath(const string &path, string &dir_name, string &base_name){
   cstr = vector<char>(path.c_str(), path.c_str()+path.size()+1);
   base_name = basename(&cstr.at(0));
 }
+
+vector<pair<long, long> > SplitRange(long nent, unsigned nparts){
+  //Contiguous [first, last) ranges of similar size; never more ranges than entries
+  if(nparts == 0) nparts = 1;
+  if(nent < static_cast<long>(nparts)) nparts = nent > 0 ? nent : 1;
+  vector<pair<long, long> > ranges;
+  long first = 0;
+  for(unsigned ipart = 0; ipart < nparts; ++ipart){
+    long last = first + nent/nparts + (static_cast<long>(ipart) < nent%nparts ? 1 : 0);
+    ranges.push_back(make_pair(first, last));
+    first = last;
+  }
+  return ranges;
+}
+
+string PartFileName(const string &file, unsigned part){
+  string name = file;
+  size_t ext = name.rfind(".root");
+  if(ext == string::npos) ext = name.size();
+  return name.insert(ext, "_part"+to_string(part));
+}
+
+void MergeParts(const vector<string> &parts, const string &out_file){
+  //Concatenates the "tree" of each part in the given order, copying baskets, and deletes the parts
+  TChain chain("tree");
+  for(const auto &part: parts) chain.Add(part.c_str());
+  long nent = chain.GetEntries();
+  //Merge returns the number of output files it produced, 0 on failure; a
+  //single file is expected, as the output would only be split beyond the
+  //maximum tree size
+  long nfiles = chain.Merge(out_file.c_str(), "fast");
+  if(nfiles != 1) ERROR("Merging "+to_string(parts.size())+" parts produced "+to_string(nfiles)+" files instead of "+out_file);
+  {
+    TFile merged(out_file.c_str(), "read");
+    const TTree *tree = static_cast<const TTree*>(merged.Get("tree"));
+    if(tree == nullptr || tree->GetEntries() != nent){
+      ERROR("Merged "+out_file+" does not hold the "+to_string(nent)+" entries of the parts");
+    }
+  }
+  for(const auto &part: parts){
+    if(remove(part.c_str()) != 0) DBG("Could not remove "+part);
+  }
+}
+
+TH2D GraphToHist(const TGraphAsymmErrors &g){
+  struct Point{
+    double xl, xh, y, e;
+    Point(double xl_in, double xh_in, double y_in, double e_in):
+      xl(xl_in),
+      xh(xh_in),
+      y(y_in),
+      e(e_in){
+    }
+    bool operator<(const Point &p) const{
+      return make_tuple(xl, xh, fabs(log(fabs(y))), fabs(e))
+        <make_tuple(p.xl, p.xh, fabs(log(fabs(p.y))), fabs(p.e));
+    }
+  };
+  vector<Point> bins;
+  Double_t *x = g.GetX();
+  Double_t *xl = g.GetEXlow();
+  Double_t *xh = g.GetEXhigh();
+  Double_t *y = g.GetY();
+  Double_t *yl = g.GetEYlow();
+  Double_t *yh = g.GetEYhigh();
+  for(int i = 0; i < g.GetN(); ++i){
+    bins.emplace_back(x[i]-fabs(xl[i]), x[i]+fabs(xh[i]),
+                      y[i], max(fabs(yl[i]), fabs(yh[i])));
+  }
+  bool problems = true;
+  while(problems){
+    stable_sort(bins.begin(), bins.end());
+    problems = false;
+    for(auto low = bins.begin(); !problems && low != bins.end(); ++low){
+      auto high = low;
+      ++high;
+      if(high == bins.end()) break;
+      double new_y = sqrt(low->y * high->y);
+      double top = max(low->y+low->e, high->y+high->e);
+      double bot = min(low->y-low->e, high->y-high->e);
+      double new_e = max(top-new_y, new_y-bot);
+      if(low->xh < high->xl){
+        //Gap
+        bins.insert(high, Point(low->xh, high->xl, new_y, new_e));
+      }else if(low->xh > high->xl){
+        //Overlap
+        problems = true;
+        if(low->xh < high->xh){
+          //Plain overlap
+          Point new_low(low->xl, high->xl, low->y, low->e);
+          Point new_mid(high->xl, low->xh, new_y, new_e);
+          Point new_high(low->xh, high->xh, high->y, high->e);
+          *low = new_low;
+          *high = new_high;
+          bins.insert(high, new_mid);
+        }else if(low->xh == high->xh){
+          //Subset -> 2 bins
+          Point new_low(low->xl, high->xl, low->y, low->e);
+          Point new_high(high->xl, high->xh, new_y, new_e);
+          *low = new_low;
+          *high = new_high;
+        }else{
+          //Subset -> 3 bins
+          Point new_low(low->xl, high->xl, low->y, low->e);
+          Point new_mid(high->xl, high->xh, new_y, new_e);
+          Point new_high(high->xh, low->xh, low->y, low->e);
+          *low = new_low;
+          *high = new_high;
+          bins.insert(high, new_mid);
+        }
+      }
+    }
+  }
+  vector<double> bin_edges(bins.size()+1);
+  for(size_t i = 0; i < bins.size(); ++i){
+    bin_edges.at(i) = bins.at(i).xl;
+  }
+  bin_edges.back() = bins.back().xh;
+  TH2D h(g.GetName(), (string(g.GetTitle())+";"+g.GetXaxis()->GetTitle()+";"+g.GetYaxis()->GetTitle()).c_str(),
+         1, 0., 1.e4, bin_edges.size()-1, &bin_edges.at(0));
+  for(int ix = 0; ix <= 2; ++ix){
+    h.SetBinContent(ix, 0, 1.);
+    h.SetBinError(ix, 0, 1.);
+    h.SetBinContent(ix, h.GetNbinsY()+1, 1.);
+    h.SetBinError(ix, h.GetNbinsY()+1, 1.);
+    for(int iy = 1; iy <= h.GetNbinsY(); ++iy){
+      h.SetBinContent(ix, iy, bins.at(iy-1).y);
+      h.SetBinError(ix ,iy, bins.at(iy-1).e);
+    }
+  }
+  return h;
+}
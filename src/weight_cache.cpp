@@ -0,0 +1,149 @@
+//----------------------------------------------------------------------------
+// weight_cache - Columnar per-event weight file, mapped straight into memory
+//----------------------------------------------------------------------------
+
+#include "weight_cache.hpp"
+
+#include <cstring>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "utilities.hpp"
+
+using namespace std;
+
+namespace{
+  const char magic[8] = {'W', 'G', 'T', 'C', 'A', 'C', 'H', 'E'};
+  const uint32_t version = 1;
+  const size_t name_size = 64;
+
+  struct Header{
+    char magic[8];
+    uint32_t version;
+    uint32_t ncols;
+    int64_t nent;
+    uint64_t data_offset;
+  };
+
+  size_t DataOffset(size_t ncols){
+    size_t page = sysconf(_SC_PAGESIZE);
+    size_t header = sizeof(Header) + ncols*name_size;
+    return ((header + page - 1)/page)*page;
+  }
+}
+
+WeightCache::WeightCache(const string &path):
+  path_(path),
+  columns_(),
+  nent_(0),
+  size_(0),
+  map_(nullptr),
+  data_(nullptr){
+  int fd = open(path.c_str(), O_RDONLY);
+  if(fd < 0) ERROR("Could not open weight cache "+path);
+  struct stat st;
+  if(fstat(fd, &st) != 0 || static_cast<size_t>(st.st_size) < sizeof(Header)){
+    close(fd);
+    ERROR("Weight cache "+path+" is truncated");
+  }
+  size_ = st.st_size;
+  void *map = mmap(nullptr, size_, PROT_READ, MAP_SHARED, fd, 0);
+  close(fd);
+  if(map == MAP_FAILED) ERROR("Could not map weight cache "+path);
+  map_ = static_cast<char*>(map);
+
+  Header header;
+  memcpy(&header, map_, sizeof(Header));
+  if(memcmp(header.magic, magic, sizeof(magic)) != 0 || header.version != version){
+    munmap(map_, size_);
+    ERROR(path+" is not a version "+to_string(version)+" weight cache");
+  }
+  if(header.data_offset + header.ncols*header.nent*sizeof(float) != size_){
+    munmap(map_, size_);
+    ERROR("Size of weight cache "+path+" does not match its header");
+  }
+  nent_ = header.nent;
+  for(size_t icol = 0; icol < header.ncols; ++icol){
+    const char *name = map_ + sizeof(Header) + icol*name_size;
+    columns_.push_back(string(name, strnlen(name, name_size)));
+  }
+  data_ = reinterpret_cast<const float*>(map_ + header.data_offset);
+  madvise(map_, size_, MADV_SEQUENTIAL);
+}
+
+WeightCache::~WeightCache(){
+  munmap(map_, size_);
+}
+
+long WeightCache::GetEntries() const{
+  return nent_;
+}
+
+const vector<string> & WeightCache::Columns() const{
+  return columns_;
+}
+
+size_t WeightCache::ColumnIndex(const string &name) const{
+  for(size_t icol = 0; icol < columns_.size(); ++icol){
+    if(columns_.at(icol) == name) return icol;
+  }
+  ERROR("Column "+name+" not found in weight cache "+path_);
+}
+
+const float * WeightCache::Column(size_t icol) const{
+  if(icol >= columns_.size()) ERROR("Column "+to_string(icol)+" out of range in weight cache "+path_);
+  return data_ + icol*nent_;
+}
+
+const float * WeightCache::Column(const string &name) const{
+  return Column(ColumnIndex(name));
+}
+
+WeightCacheWriter::WeightCacheWriter(const string &path, const vector<string> &columns, long nent):
+  path_(path),
+  ncols_(columns.size()),
+  nent_(nent),
+  size_(DataOffset(columns.size()) + columns.size()*nent*sizeof(float)),
+  map_(nullptr),
+  data_(nullptr){
+  // Checked before anything is created, so no file or mapping is left behind
+  for(const auto &column: columns){
+    if(column.size() >= name_size) ERROR("Column name "+column+" is too long");
+  }
+
+  int fd = open(path.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+  if(fd < 0) ERROR("Could not create weight cache "+path);
+  if(ftruncate(fd, size_) != 0){
+    close(fd);
+    ERROR("Could not allocate "+to_string(size_)+" bytes for weight cache "+path);
+  }
+  void *map = mmap(nullptr, size_, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+  close(fd);
+  if(map == MAP_FAILED) ERROR("Could not map weight cache "+path);
+  map_ = static_cast<char*>(map);
+
+  Header header;
+  memcpy(header.magic, magic, sizeof(magic));
+  header.version = version;
+  header.ncols = ncols_;
+  header.nent = nent_;
+  header.data_offset = DataOffset(ncols_);
+  memcpy(map_, &header, sizeof(Header));
+  for(size_t icol = 0; icol < ncols_; ++icol){
+    strncpy(map_ + sizeof(Header) + icol*name_size, columns.at(icol).c_str(), name_size);
+  }
+  data_ = reinterpret_cast<float*>(map_ + header.data_offset);
+}
+
+WeightCacheWriter::~WeightCacheWriter(){
+  msync(map_, size_, MS_SYNC);
+  munmap(map_, size_);
+}
+
+float * WeightCacheWriter::Column(size_t icol){
+  if(icol >= ncols_) ERROR("Column "+to_string(icol)+" out of range in weight cache "+path_);
+  return data_ + icol*nent_;
+}